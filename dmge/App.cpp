@@ -1,5 +1,6 @@
 ﻿#include "stdafx.h"
 #include "App.h"
+#include "Core.h"
 #include "Memory.h"
 #include "Cartridge.h"
 #include "CPU.h"
@@ -11,6 +12,9 @@
 #include "Serial.h"
 #include "SGB/Command.h"
 #include "Interrupt.h"
+#include "SaveState.h"
+#include "RewindBuffer.h"
+#include "CoreThread.h"
 #include "Address.h"
 #include "Timing.h"
 #include "AppConfig.h"
@@ -25,6 +29,10 @@ namespace dmge
 {
 	namespace
 	{
+		// このスレッドで実行する場合の出力サンプリングレートの基準の倍率
+		// エミュレーションの1フレーム（約 1/59.73 秒）を 1/60 秒で表示するので、その分サンプルを少なく生成する
+		constexpr double MainLoopOutputRateScale = static_cast<double>(ClockFrequency) / FrameDots / 60.0;
+
 		void DrawStatusText(StringView text)
 		{
 			const Size size{ 5 * text.length(), 10 };
@@ -43,21 +51,22 @@ namespace dmge
 	DmgeApp::DmgeApp(AppConfig& config)
 		:
 		config_{ config },
-		mem_{ std::make_unique<Memory>() },
-		interrupt_{ std::make_unique<Interrupt>() },
-		lcd_{ std::make_unique<LCD>(*mem_.get()) },
-		ppu_{ std::make_unique<PPU>(mem_.get(), lcd_.get(), interrupt_.get()) },
-		timer_{ std::make_unique<Timer>(mem_.get(), interrupt_.get()) },
-		apu_{ std::make_unique<APU>(*timer_.get()) },
-		cpu_{ std::make_unique<CPU>(mem_.get(), interrupt_.get()) },
-		joypad_{ std::make_unique<Joypad>(mem_.get()) },
-		serial_{ std::make_unique<Serial>(*interrupt_.get()) },
-		debugMonitor_{ std::make_unique<DebugMonitor>(mem_.get(), cpu_.get(), apu_.get(), interrupt_.get()) },
+		core_{ std::make_unique<Core>(false, config_.audioSampleRate) },
+		mem_{ &core_->memory() },
+		interrupt_{ &core_->interrupt() },
+		lcd_{ &core_->lcd() },
+		ppu_{ &core_->ppu() },
+		apu_{ &core_->apu() },
+		cpu_{ &core_->cpu() },
+		joypad_{ &core_->joypad() },
+		debugMonitor_{ std::make_unique<DebugMonitor>(mem_, cpu_, apu_, interrupt_) },
 		keyMap_{ std::make_unique<InputMapping>(InputDeviceType::Keyboard) },
-		gamepadMap_{ std::make_unique<InputMapping>(InputDeviceType::Gamepad) }
+		gamepadMap_{ std::make_unique<InputMapping>(InputDeviceType::Gamepad) },
+		stateWriter_{ std::make_unique<StateWriter>() },
+		rewindBuffer_{ std::make_unique<RewindBuffer>(static_cast<size_t>(config_.rewindBufferSize) * 1024 * 1024) },
+		coreThread_{ std::make_unique<CoreThread>(*core_) },
+		runAheadSnapshot_{ std::make_unique<StateWriter>() }
 	{
-		mem_->init(ppu_.get(), apu_.get(), timer_.get(), joypad_.get(), lcd_.get(), interrupt_.get(), serial_.get());
-
 		// config.ini のキー／ボタンマッピングを適用
 
 		keyMap_->set(config_.keyMapping);
@@ -79,10 +88,20 @@ namespace dmge
 		// ピクセルシェーダ用パラメータ (CGB)
 		ppu_->setGamma(config_.cgbColorGamma);
 
+		// 高速描画モード
+		ppu_->setFastRendering(config_.fastRendering);
+
+		// ラン・アヘッドが有効な場合は、先に進めたフレームだけを画面に出力する
+		ppu_->setAutoFlush(config_.runAheadFrames == 0);
+
 		// オーディオ LPF
 		apu_->setLPFConstant(config_.audioLPFConstant);
 		apu_->setEnableLPF(config_.enableAudioLPF);
 
+		// 1フレームごとに画面を更新（60fps）するので、実機のフレームレートとの差の分だけ出力サンプリングレートを下げる
+		apu_->setOutputRateScale(MainLoopOutputRateScale);
+		apu_->setLogRateControl(config_.logAudioRateControl);
+
 		// メニュー初期化
 		initMenu_();
 	}
@@ -119,7 +138,7 @@ namespace dmge
 		// カートリッジ読み込み
 		// 対応するMBCがカートリッジをロードする
 		// 対応するMBCがない場合は終了する
-		if (not mem_->loadCartridge(*currentCartridgePath_))
+		if (not core_->loadCartridge(*currentCartridgePath_))
 		{
 			DebugPrint::Writeln(U"* Cannot open cartridge");
 			return;
@@ -130,43 +149,19 @@ namespace dmge
 		mem_->loadSRAM();
 #endif
 
-#if SIV3D_PLATFORM(WINDOWS)
-		// BootROM
-		bool enableBootROM = not config_.bootROMPath.isEmpty() && FileSystem::Exists(config_.bootROMPath);
-		if (enableBootROM)
-		{
-			mem_->enableBootROM(config_.bootROMPath);
-		}
-#elif SIV3D_PLATFORM(WEB)
-		bool enableBootROM = false;
-#endif
-
 		// [DEBUG]
 		DebugPrint::Writeln(U"* Cartridge loaded:");
 		DebugPrint::Writeln(U"FileName={}"_fmt(FileSystem::FileName(*currentCartridgePath_)));
 		mem_->dumpCartridgeInfo();
 
-		// CGBモードの適用
-		if (mem_->isSupportedCGBMode() && config_.detectCGB)
-		{
-			mem_->setCGBMode(true);
-			ppu_->setCGBMode(true);
-			apu_->setCGBMode(true);
-			cpu_->setCGBMode(true);
-		}
-
-		cpu_->reset(enableBootROM);
-
-		// SGBモードの適用
-		if (not mem_->isCGBMode() && mem_->isSupportedSGBMode() && config_.detectSGB)
-		{
-			mem_->setSGBMode(true);
-			ppu_->setSGBMode(true);
-			cpu_->setSGBMode(true);
-		}
-
-		// メモリの内容をリセット（SGB/CGBモード確定後にリセットする必要がある）
-		mem_->reset();
+		// CGB・SGB モードの適用、BootROM、リセット
+		core_->boot(CoreBootOptions{
+			.detectCGB = config_.detectCGB,
+			.detectSGB = config_.detectSGB,
+#if SIV3D_PLATFORM(WINDOWS)
+			.bootROMPath = config_.bootROMPath,
+#endif
+		});
 
 		mainLoop_();
 
@@ -209,9 +204,18 @@ namespace dmge
 
 		while (not quitApp_)
 		{
+			// エミュレーションを別スレッドで実行する場合は専用のループへ
+			// トレースモードへの移行などで別スレッドを使えなくなったら、ループから戻ってこのスレッドで実行する
+			if (canUseCoreThread_())
+			{
+				threadedLoop_();
+				continue;
+			}
+
 			// メニュー表示中は専用のループへ
 			if (menuOverlay_.isVisible())
 			{
+				setFastForward_(false);
 				apu_->pause();
 				menuLoop_();
 			}
@@ -222,6 +226,7 @@ namespace dmge
 			{
 				mode_ = DmgeAppMode::Trace;
 
+				setFastForward_(false);
 				apu_->pause();
 
 				DebugPrint::Writeln(U"Break: pc={:04X}"_fmt(cpu_->currentPC()));
@@ -273,20 +278,12 @@ namespace dmge
 				}
 			}
 
-			// CPUコマンドを1回実行する
-			cpu_->run();
-
-			tickUnits_(cpu_->consumedCycles());
-
-			// 割り込み
-			if (cpu_->interrupt())
-			{
-				tickUnits_(5 * 4);
-			}
+			// CPUコマンドを1回実行し、各ユニットを進める
+			const int cycles = core_->step();
 
 			// キー入力と描画
 
-			if (checkShouldDraw_())
+			if (fastForward_ ? checkShouldDrawFastForward_(cycles) : checkShouldDraw_(cycles))
 			{
 				if (not System::Update())
 				{
@@ -298,6 +295,9 @@ namespace dmge
 				// ※デバッグモニタでテキスト入力中はキーボード入力を受け付けない
 				if (not processingDebugMonitorTextInput_())
 				{
+					// ボタンの状態はフレームごとに1回だけ取得し、JOYP への書き込み時はこれを参照する
+					joypad_->setInputState(joypad_->pollInput());
+
 					commonInput_();
 
 					// トレースモードに移行 (Ctrl+P)
@@ -307,14 +307,26 @@ namespace dmge
 					}
 				}
 
+				// 早送り (Tab を押している間)
+				setFastForward_(KeyTab.pressed() && mode_ == DmgeAppMode::Default && not processingDebugMonitorTextInput_());
+
+				// 巻き戻し用に現在の状態を記録
+				rewindBuffer_->push(*core_);
+
+				// ラン・アヘッド
+				if (config_.runAheadFrames > 0 && mode_ == DmgeAppMode::Default && not fastForward_)
+				{
+					runAhead_();
+				}
+
 				// PPUのレンダリング結果を画面表示
 				ppu_->draw(Vec2{ 0, 0 }, config_.scale);
 
 				// APU
-				if (enableAPU_ && mode_ != DmgeAppMode::Trace)
+				// 再生を始めた後はバッファが不足しても止めず、出力サンプリングレートの調整で回復させる
+				if (enableAPU_ && mode_ != DmgeAppMode::Trace && not fastForward_)
 				{
-					apu_->playIfBufferEnough(2000);
-					apu_->pauseIfBufferNotEnough(512);
+					apu_->playIfBufferEnough();
 				}
 
 				// デバッグ用モニタ表示
@@ -328,14 +340,224 @@ namespace dmge
 
 				if (config_.showFPS)
 				{
-					DrawStatusText(U"FPS:{:3d}"_fmt(Profiler::FPS()));
+					DrawStatusText(U"FPS:{:3d} Px:{:5d}{}"_fmt(Profiler::FPS(), ppu_->changedPixelCount(), fastForward_ ? U" >>" : U""));
+				}
+				else if (fastForward_)
+				{
+					DrawStatusText(U">>");
+				}
+
+				// 速度の上限がない早送り中は、画面の更新間隔を checkShouldDrawFastForward_ で調整するので待たない
+				if (not (fastForward_ && config_.fastForwardSpeed == 0))
+				{
+					fpsKeeper.sleep();
+				}
+
+				if (fastForward_)
+				{
+					cyclesFromPreviousDraw_ = 0;
+				}
+
+				// ラン・アヘッドなどで PPU のフレーム数が進んでいるので、次の VBlank を待つ
+				drawFrameCount_ = ppu_->frameCount();
+			}
+		}
+	}
+
+	void DmgeApp::threadedLoop_()
+	{
+		// 画面表示用のレンダリング結果はコアのスレッドが出力し、このスレッドで RenderTexture に記録する
+		ppu_->setAutoFlush(false);
+
+		// コアのスレッドは実機のフレームレートで実行するので、出力サンプリングレートの基準は変えない
+		apu_->setOutputRateScale(1.0);
+
+		coreThread_->start([&] { onCoreFrame_(); });
+
+		while (not quitApp_ && canUseCoreThread_())
+		{
+			if (not System::Update())
+			{
+				quitApp_ = true;
+				break;
+			}
+
+			// メニュー表示中はコアのスレッドを止めて専用のループへ
+			if (menuOverlay_.isVisible())
+			{
+				withCorePaused_([&] {
+					apu_->pause();
+					menuLoop_();
+
+					// メニューで変更される場合があるので戻す
+					ppu_->setAutoFlush(false);
+				});
+				continue;
+			}
+
+			// キーボード入力処理
+			// ※デバッグモニタでテキスト入力中はキーボード入力を受け付けない
+			// ボタンの状態はこのスレッドで取得してコアのスレッドに渡す
+			if (not processingDebugMonitorTextInput_())
+			{
+				joypad_->setInputState(joypad_->pollInput());
+
+				commonInput_();
+
+				// トレースモードに移行 (Ctrl+P)
+				if (KeyP.down() && KeyControl.pressed())
+				{
+					pause_();
 				}
 
-				fpsKeeper.sleep();
+				// 早送り (Tab を押している間)
+				// コアのスレッドの速度の倍率を変え、音声は出力しない
+				// 画面に出力するフレームの選択と描画の省略は、コアのスレッドが onCoreFrame_ で行う
+				const bool fastForward = KeyTab.pressed();
+
+				if (fastForward != fastForward_)
+				{
+					fastForward_ = fastForward;
+
+					coreThread_->setSpeed(fastForward ? config_.fastForwardSpeed : 1);
+					coreThread_->post([this, fastForward] {
+						apu_->setEnableOutput(not fastForward);
+
+						coreFastForward_ = fastForward;
 
-				cyclesFromPreviousDraw_ = 0;
+						if (fastForward)
+						{
+							resetFastForwardRendering_();
+						}
+						else
+						{
+							ppu_->setSkipRendering(false);
+						}
+					});
+
+					if (fastForward)
+					{
+						apu_->pause();
+					}
+				}
+			}
+			else
+			{
+				// テキスト入力中はボタンを離した状態を渡す
+				// （入力を止める直前に押していたボタンが、コアのスレッドで押されたままにならないようにする）
+				// setEnable() の値はコアのスレッドと同期しないので、このループでは使わない
+				joypad_->setInputState(0);
+			}
+
+			// コアのスレッドが出力した最新のフレームを画面表示
+			if (coreThread_->updateFrame())
+			{
+				ppu_->flushRenderingResult(coreThread_->frame().image);
+			}
+
+			if (coreThread_->frame().lcdEnabled)
+			{
+				ppu_->drawRenderingResult(Vec2{ 0, 0 }, config_.scale);
+			}
+
+			// APU
+			if (enableAPU_ && not fastForward_)
+			{
+				apu_->playIfBufferEnough();
+			}
+
+			// デバッグ用モニタ表示
+			// 表示する状態はコアのスレッドがフレームの間で取得する（表示のためにコアのスレッドを止めない）
+			if (config_.showDebugMonitor)
+			{
+				coreThread_->post([this] { debugMonitor_->capture(); });
+				drawDebugMonitor_();
+			}
+
+			if (config_.showFPS)
+			{
+				DrawStatusText(U"FPS:{:3d} Px:{:5d}{}"_fmt(Profiler::FPS(), ppu_->changedPixelCount(), fastForward_ ? U" >>" : U""));
+			}
+			else if (fastForward_)
+			{
+				DrawStatusText(U">>");
 			}
 		}
+
+		coreThread_->stop();
+		coreThread_->setSpeed(1);
+
+		if (fastForward_)
+		{
+			fastForward_ = false;
+			coreFastForward_ = false;
+			apu_->setEnableOutput(true);
+			ppu_->setSkipRendering(false);
+		}
+
+		ppu_->setAutoFlush(config_.runAheadFrames == 0);
+		ppu_->flushRenderingResult();
+
+		apu_->setOutputRateScale(MainLoopOutputRateScale);
+		cyclesFromPreviousDraw_ = 0;
+	}
+
+	void DmgeApp::onCoreFrame_()
+	{
+		// 巻き戻し用に現在の状態を記録
+		rewindBuffer_->push(*core_);
+
+		// 早送り中は、画面に出力するフレームだけを描画して出力する
+		if (coreFastForward_)
+		{
+			if (advanceFastForwardFrame_())
+			{
+				presentRenderingResult_();
+			}
+		}
+		// ラン・アヘッド（早送り中は行わない）
+		else if (config_.runAheadFrames > 0)
+		{
+			runAhead_();
+		}
+		else
+		{
+			presentRenderingResult_();
+		}
+	}
+
+	bool DmgeApp::canUseCoreThread_() const
+	{
+#if SIV3D_PLATFORM(WINDOWS)
+		// ブレークポイントとトレースダンプは命令ごとに確認するので、このスレッドで実行する
+		return config_.enableCoreThread &&
+			mode_ == DmgeAppMode::Default &&
+			not config_.enableBreakpoint &&
+			not config_.traceDumpStartAddress &&
+			not enableTraceDump_ &&
+			not config_.testMode;
+#else
+		return false;
+#endif
+	}
+
+	void DmgeApp::withCorePaused_(const std::function<void()>& func)
+	{
+		coreThread_->pause();
+		func();
+		coreThread_->resume();
+	}
+
+	void DmgeApp::presentRenderingResult_()
+	{
+		if (CoreThread::IsCurrentThread())
+		{
+			coreThread_->publishFrame();
+		}
+		else
+		{
+			ppu_->flushRenderingResult();
+		}
 	}
 
 	void DmgeApp::traceLoop_()
@@ -355,6 +577,9 @@ namespace dmge
 			// ※デバッグモニタでテキスト入力中はキーボード入力を受け付けない
 			if (not processingDebugMonitorTextInput_())
 			{
+				// ステップ実行で参照するボタンの状態
+				joypad_->setInputState(joypad_->pollInput());
+
 				commonInput_();
 
 				// メニューを表示したタイミングでループから抜けてメニューループへ移る
@@ -389,6 +614,71 @@ namespace dmge
 		}
 	}
 
+	void DmgeApp::rewindLoop_()
+	{
+		apu_->pause();
+
+		while (KeyR.pressed())
+		{
+			if (not System::Update())
+			{
+				quitApp_ = true;
+				break;
+			}
+
+			// 記録が残っている間は1フレームずつさかのぼる
+			if (rewindBuffer_->pop(*core_))
+			{
+				ppu_->flushRenderingResult();
+			}
+
+			ppu_->draw(Point{ 0, 0 }, config_.scale);
+
+			// デバッグ用モニタ表示
+			if (config_.showDebugMonitor)
+			{
+				updateDebugMonitor_();
+			}
+
+			DrawStatusText(U"REWIND");
+		}
+
+		cyclesFromPreviousDraw_ = 0;
+	}
+
+	void DmgeApp::runAhead_()
+	{
+		runningAhead_ = true;
+
+		// 現在の状態を退避
+		runAheadSnapshot_->clear();
+		core_->saveSnapshot(*runAheadSnapshot_);
+
+		// 最後のフレームだけを描画し、それ以前のフレームの描画と音声の出力は省略する
+		// 最後のフレームは VBlank の直後から描画するので、1フレーム分の画面がそろう
+		// （1フレームだけ進める場合は、現在のフレームのここまでに描画された部分とあわせて1フレーム分になる）
+
+		apu_->setEnableOutput(false);
+
+		for (int i = 0; i < config_.runAheadFrames; ++i)
+		{
+			ppu_->setSkipRendering(i < config_.runAheadFrames - 1);
+			core_->runToNextVBlank();
+		}
+
+		ppu_->setSkipRendering(false);
+		presentRenderingResult_();
+
+		apu_->setEnableOutput(true);
+
+		// 退避した状態に戻す
+		const auto& snapshot = runAheadSnapshot_->data();
+		StateReader reader{ snapshot.data(), snapshot.size() };
+		core_->loadSnapshot(reader);
+
+		runningAhead_ = false;
+	}
+
 	void DmgeApp::menuLoop_()
 	{
 		while (menuOverlay_.isVisible())
@@ -432,7 +722,7 @@ namespace dmge
 		// パレット切り替え (Ctrl+L)
 		if (KeyL.down() && KeyControl.pressed())
 		{
-			changePalettePreset_(1);
+			withCorePaused_([&] { changePalettePreset_(1); });
 		}
 
 		// リセット (Ctrl+R)
@@ -447,38 +737,61 @@ namespace dmge
 			openCartridge_();
 		}
 
+		// ステートセーブ (F2)
+		if (KeyF2.down())
+		{
+			withCorePaused_([&] { saveState_(); });
+		}
+
+		// ステートロード (F4)
+		if (KeyF4.down())
+		{
+			withCorePaused_([&] { loadState_(); });
+		}
+
+		// 巻き戻し (R)
+		if (KeyR.down() && not KeyControl.pressed() && mode_ == DmgeAppMode::Default)
+		{
+			withCorePaused_([&] {
+				if (not rewindBuffer_->empty())
+				{
+					rewindLoop_();
+				}
+			});
+		}
+
 		// APUの各チャンネルをミュート (Key 1-4)
 
 		if (Key1.down())
 		{
-			toggleAudioChannelMute_(0);
+			withCorePaused_([&] { toggleAudioChannelMute_(0); });
 		}
 
 		if (Key2.down())
 		{
-			toggleAudioChannelMute_(1);
+			withCorePaused_([&] { toggleAudioChannelMute_(1); });
 		}
 
 		if (Key3.down())
 		{
-			toggleAudioChannelMute_(2);
+			withCorePaused_([&] { toggleAudioChannelMute_(2); });
 		}
 
 		if (Key4.down())
 		{
-			toggleAudioChannelMute_(3);
+			withCorePaused_([&] { toggleAudioChannelMute_(3); });
 		}
 
 		// APUの使用を切替 (Key 5)
 		if (Key5.down())
 		{
-			toggleAudio_();
+			withCorePaused_([&] { toggleAudio_(); });
 		}
 
 		// Toggle LPF (Key 6)
 		if (Key6.down())
 		{
-			toggleAudioLPF_();
+			withCorePaused_([&] { toggleAudioLPF_(); });
 		}
 
 		// メニューを開く (ESC or 右クリック or 左クリック長押し)
@@ -491,7 +804,7 @@ namespace dmge
 	// メモリ書き込み時フック
 	void DmgeApp::onMemoryWrite_(uint16 addr, uint8 value)
 	{
-		if (not config_.enableBreakpoint || mode_ == DmgeAppMode::Trace)
+		if (not config_.enableBreakpoint || mode_ == DmgeAppMode::Trace || runningAhead_)
 		{
 			return;
 		}
@@ -560,76 +873,141 @@ namespace dmge
 		return false;
 	}
 
-	void DmgeApp::tickUnits_(int cycles)
+	bool DmgeApp::checkShouldDraw_(int cycles)
 	{
-		int doubleSpeedFactor = mem_->isDoubleSpeed() ? 2 : 1;
+		// VBlank に移行するごとに描画する（ラン・アヘッドもフレームの境界から行う）
+		// 画面の更新と音声の再生の速度のずれは、APU が出力サンプリングレートを調整して吸収する
 
-		// RTC, DMA
-		mem_->update(cycles);
+		const int doubleSpeedFactor = mem_->isDoubleSpeed() ? 2 : 1;
+		const int frameCycles = FrameDots * doubleSpeedFactor;
 
-		// タイマーを更新
+		cyclesFromPreviousDraw_ += cycles;
 
-		for (int i : step(cycles))
+		if (ppu_->frameCount() != drawFrameCount_)
 		{
-			timer_->update();
+			cyclesFromPreviousDraw_ = 0;
+			return true;
 		}
 
-		// Serial
-
-		for (int i : step(cycles))
+		// LCD がオフの間は VBlank に移行しないので、1フレーム分のサイクル数ごとに描画する
+		// 超過したサイクル数は次のフレームに繰り越す
+		if (not lcd_->isEnabled() && cyclesFromPreviousDraw_ >= frameCycles)
 		{
-			serial_->update();
+			cyclesFromPreviousDraw_ = Min(cyclesFromPreviousDraw_ - frameCycles, frameCycles - 1);
+			return true;
 		}
 
-		// PPU
+		return false;
+	}
 
-		for (int i : step(cycles / doubleSpeedFactor))
-		{
-			ppu_->run();
-		}
+	bool DmgeApp::checkShouldDrawFastForward_(int cycles)
+	{
+		const int doubleSpeedFactor = mem_->isDoubleSpeed() ? 2 : 1;
+		const bool unlimited = config_.fastForwardSpeed == 0;
 
-		// APU
+		cyclesFromPreviousDraw_ += cycles;
 
-		if (enableAPU_)
+		// VBlank に移行していなければ、フレームの途中なので画面を更新しない
+		// ただし LCD がオフの間は VBlank に移行しないので、一定のサイクル数（上限がない場合は時間）ごとに画面を更新する
+		if (ppu_->frameCount() == fastForwardFrameCount_)
 		{
-			for (int i : step(cycles / doubleSpeedFactor))
+			if (lcd_->isEnabled())
+			{
+				return false;
+			}
+
+			const bool shouldDraw = unlimited
+				? drawStopwatch_.sF() >= 1.0 / 60
+				: cyclesFromPreviousDraw_ >= ClockFrequency / 59.50 * doubleSpeedFactor * config_.fastForwardSpeed;
+
+			if (shouldDraw)
 			{
-				bufferedSamples_ += apu_->run();
+				drawStopwatch_.restart();
 			}
+
+			return shouldDraw;
 		}
+
+		fastForwardFrameCount_ = ppu_->frameCount();
+
+		return advanceFastForwardFrame_();
 	}
 
-	bool DmgeApp::checkShouldDraw_()
+	bool DmgeApp::advanceFastForwardFrame_()
 	{
-		bool shouldDraw = false;
+		const bool unlimited = config_.fastForwardSpeed == 0;
 
-		// (1) オーディオバッファに1フレーム分のサンプルを書き込んだら描画する
+		// 描画していたフレームが終わったら画面を更新する
+		const bool shouldDraw = fastForwardRendering_;
 
-		int doubleSpeedFactor = mem_->isDoubleSpeed() ? 2 : 1;
-
-		if (enableAPU_)
+		if (shouldDraw)
 		{
-			if (bufferedSamples_ > 1.0 * sampleRate_ / 60.0 * doubleSpeedFactor)
-			{
-				bufferedSamples_ -= sampleRate_ / 60.0 * doubleSpeedFactor;
-
-				shouldDraw = true;
-			}
+			framesFromPreviousDraw_ = 0;
+			drawStopwatch_.restart();
+		}
+		else
+		{
+			++framesFromPreviousDraw_;
 		}
 
-		// (2) 描画されないまま一定のサイクル数が経過した場合に強制的に描画する
+		// 次のフレームを描画するか
+		// 速度の上限がある場合は fastForwardSpeed フレームに1回、上限がない場合は前回の画面更新から 1/60 秒経つごとに描画する
+		fastForwardRendering_ = unlimited
+			? drawStopwatch_.sF() >= 1.0 / 60
+			: framesFromPreviousDraw_ + 1 >= config_.fastForwardSpeed;
 
-		cyclesFromPreviousDraw_ += cpu_->consumedCycles();
+		ppu_->setSkipRendering(not fastForwardRendering_);
 
-		if (cyclesFromPreviousDraw_ >= ClockFrequency / 59.50 * doubleSpeedFactor)
+		return shouldDraw;
+	}
+
+	void DmgeApp::setFastForward_(bool enable)
+	{
+		if (fastForward_ == enable) return;
+
+		fastForward_ = enable;
+
+		if (enable)
 		{
-			shouldDraw = true;
+			// 音声は出力せずに捨てる
+			apu_->pause();
+			apu_->setEnableOutput(false);
+
+			// ラン・アヘッドは行わないので、VBlank への移行時にレンダリング結果を記録する
+			ppu_->setAutoFlush(true);
+
+			resetFastForwardRendering_();
+			fastForwardFrameCount_ = ppu_->frameCount();
 		}
+		else
+		{
+			apu_->setEnableOutput(true);
 
-		return shouldDraw;
+			ppu_->setAutoFlush(config_.runAheadFrames == 0);
+			ppu_->setSkipRendering(false);
+		}
+
+		cyclesFromPreviousDraw_ = 0;
+	}
+
+	void DmgeApp::resetFastForwardRendering_()
+	{
+		// 次の VBlank までは描画を省略する
+		ppu_->setSkipRendering(true);
+
+		fastForwardRendering_ = false;
+		framesFromPreviousDraw_ = 0;
+		drawStopwatch_.restart();
 	}
 
 	void DmgeApp::updateDebugMonitor_()
+	{
+		debugMonitor_->capture();
+
+		drawDebugMonitor_();
+	}
+
+	void DmgeApp::drawDebugMonitor_()
 	{
 		debugMonitor_->update();
 
@@ -836,6 +1214,43 @@ namespace dmge
 			.allowLR = true
 		});
 
+		rootMenu_.items.push_back({
+			.textFunc = [&]() {
+				return GUI::MenuItemText{
+					.label = U"Fast rendering",
+					.state = config_.fastRendering ? U"On" : U"Off",
+				};
+			},
+			.handler = [&]() {
+				toggleFastRendering_();
+			},
+			.allowLR = true
+		});
+
+		rootMenu_.items.push_back({
+			.textFunc = [&]() {
+				return GUI::MenuItemText{
+					.label = U"Run-ahead",
+					.state = config_.runAheadFrames == 0 ? U"Off" : U"{} frame(s)"_fmt(config_.runAheadFrames),
+				};
+			},
+			.handlerLR = [&](bool leftPressed) {
+				changeRunAheadFrames_(leftPressed ? -1 : 1);
+			}
+		});
+
+		rootMenu_.items.push_back({
+			.textFunc = [&]() {
+				return GUI::MenuItemText{
+					.label = U"Fast-forward speed",
+					.state = config_.fastForwardSpeed == 0 ? U"Unlimited" : U"x{}"_fmt(config_.fastForwardSpeed),
+				};
+			},
+			.handlerLR = [&](bool leftPressed) {
+				changeFastForwardSpeed_(leftPressed ? -1 : 1);
+			}
+		});
+
 
 		const auto menuItemBorder = GUI::MenuItem{
 			.text = GUI::MenuItemText{.label = U"--------" },
@@ -848,9 +1263,6 @@ namespace dmge
 		rootMenu_.items.push_back(menuItemBorder);
 		rootMenu_.items.push_back(menuItemBorder);
 		rootMenu_.items.push_back(menuItemBorder);
-		rootMenu_.items.push_back(menuItemBorder);
-		rootMenu_.items.push_back(menuItemBorder);
-		rootMenu_.items.push_back(menuItemBorder);
 
 		rootMenu_.items.push_back({
 			.text = GUI::MenuItemText{.label = U"Back" },
@@ -1132,6 +1544,44 @@ namespace dmge
 		}
 	}
 
+	void DmgeApp::saveState_()
+	{
+		if (not currentCartridgePath_) return;
+
+		stateWriter_->clear();
+		core_->saveState(*stateWriter_);
+
+		const auto& data = stateWriter_->data();
+		const auto path = GetSaveStateFilePath(*currentCartridgePath_);
+
+		BinaryWriter writer{ path };
+		writer.write(data.data(), data.size());
+
+		DebugPrint::Writeln(U"SaveState: {} ({} bytes)"_fmt(path, data.size()));
+	}
+
+	void DmgeApp::loadState_()
+	{
+		if (not currentCartridgePath_) return;
+
+		const auto path = GetSaveStateFilePath(*currentCartridgePath_);
+		if (not FileSystem::Exists(path)) return;
+
+		BinaryReader reader{ path };
+		Array<uint8> data(reader.size());
+		reader.read(data.data(), data.size());
+
+		StateReader stateReader{ data.data(), data.size() };
+
+		if (not core_->loadState(stateReader))
+		{
+			DebugPrint::Writeln(U"LoadState: Failed to load {}"_fmt(path));
+			return;
+		}
+
+		DebugPrint::Writeln(U"LoadState: {}"_fmt(path));
+	}
+
 	void DmgeApp::toggleAudioChannelMute_(int channel)
 	{
 		apu_->setMute(channel, not apu_->getMute(channel));
@@ -1144,6 +1594,8 @@ namespace dmge
 		{
 			apu_->pause();
 		}
+
+		apu_->setEnableEmulation(enableAPU_);
 	}
 
 	void DmgeApp::toggleAudioLPF_()
@@ -1166,6 +1618,27 @@ namespace dmge
 		config_.showFPS = not config_.showFPS;
 	}
 
+	void DmgeApp::toggleFastRendering_()
+	{
+		config_.fastRendering = not config_.fastRendering;
+		ppu_->setFastRendering(config_.fastRendering);
+	}
+
+	void DmgeApp::changeRunAheadFrames_(int changeFrames)
+	{
+		config_.runAheadFrames = (config_.runAheadFrames + AppConfig::RunAheadFramesMax + 1 + changeFrames) % (AppConfig::RunAheadFramesMax + 1);
+		ppu_->setAutoFlush(config_.runAheadFrames == 0);
+	}
+
+	void DmgeApp::changeFastForwardSpeed_(int changeSpeed)
+	{
+		// 0（上限なし）, 2, 3, ..., FastForwardSpeedMax を切り替える（1倍は早送りにならないので除く）
+		do
+		{
+			config_.fastForwardSpeed = (config_.fastForwardSpeed + AppConfig::FastForwardSpeedMax + 1 + changeSpeed) % (AppConfig::FastForwardSpeedMax + 1);
+		} while (config_.fastForwardSpeed == 1);
+	}
+
 	void DmgeApp::changePalettePreset_(int changeIndex)
 	{
 		config_.palettePreset = (config_.palettePreset + Colors::PalettePresetsCount + changeIndex) % Colors::PalettePresetsCount;
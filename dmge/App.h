@@ -20,17 +20,19 @@ namespace dmge
 	};
 
 	struct AppConfig;
+	class Core;
 	class Memory;
 	class Interrupt;
 	class LCD;
 	class PPU;
 	class APU;
-	class Timer;
 	class CPU;
 	class Joypad;
-	class Serial;
 	class DebugMonitor;
 	class InputMapping;
+	class StateWriter;
+	class RewindBuffer;
+	class CoreThread;
 
 	// アプリケーション
 	class DmgeApp
@@ -54,10 +56,32 @@ namespace dmge
 
 		void mainLoop_();
 
+		// エミュレーションを CoreThread で実行し、このスレッドでは画面の表示と入力の処理を行う
+		void threadedLoop_();
+
+		// (コアのスレッド) 1フレーム実行するごとに呼ばれる
+		void onCoreFrame_();
+
+		// エミュレーションを別スレッドで実行できるか
+		bool canUseCoreThread_() const;
+
+		// コアのスレッドを一時停止して func を実行する
+		// コアのスレッドを実行していない場合はそのまま実行する
+		void withCorePaused_(const std::function<void()>& func);
+
+		// 現在のレンダリング結果を画面表示用に出力する
+		void presentRenderingResult_();
+
 		void traceLoop_();
 
 		void menuLoop_();
 
+		// 巻き戻しキーを押している間、記録した状態を1フレームずつさかのぼる
+		void rewindLoop_();
+
+		// 現在の状態を退避し、現在の入力のまま config_.runAheadFrames フレーム先まで進めた画面を表示用に出力して、退避した状態に戻す
+		void runAhead_();
+
 		void commonInput_();
 
 		// メモリ書き込み時フック
@@ -71,12 +95,27 @@ namespace dmge
 
 		bool reachedTraceDumpAddress_() const;
 
-		void tickUnits_(int cycles);
+		bool checkShouldDraw_(int cycles);
+
+		// 早送り中に画面を更新するか
+		// 画面に出力するフレームだけを描画するよう、PPU の描画の省略もここで切り替える
+		bool checkShouldDrawFastForward_(int cycles);
 
-		bool checkShouldDraw_();
+		// (早送り) VBlank に移行したときに、終わったフレームで画面を更新するかを返し、次のフレームを描画するかを決める
+		bool advanceFastForwardFrame_();
 
+		// (早送り) 次の VBlank まで描画を省略し、画面更新の間隔を数え直す
+		void resetFastForwardRendering_();
+
+		// 早送りの開始／終了
+		void setFastForward_(bool enable);
+
+		// Core の状態を取得してデバッグモニタを表示する（Core にアクセスできるスレッドから呼ぶ）
 		void updateDebugMonitor_();
 
+		// 取得済みの状態でデバッグモニタを表示する
+		void drawDebugMonitor_();
+
 		void initMenu_();
 
 		void reset_();
@@ -87,6 +126,11 @@ namespace dmge
 
 		void openCartridge_();
 
+		// セーブステートをファイルに書き込む／ファイルから読み込む
+		void saveState_();
+
+		void loadState_();
+
 		void toggleAudioChannelMute_(int channel);
 
 		void toggleAudio_();
@@ -97,6 +141,12 @@ namespace dmge
 
 		void toggleShowFPS_();
 
+		void toggleFastRendering_();
+
+		void changeRunAheadFrames_(int changeFrames);
+
+		void changeFastForwardSpeed_(int changeSpeed);
+
 		void changePalettePreset_(int changeIndex);
 
 		// キー／ボタンのマッピングが変更されたので Joypad と config に変更を適用する
@@ -107,19 +157,36 @@ namespace dmge
 
 		AppConfig& config_;
 
-		std::unique_ptr<Memory> mem_;
-		std::unique_ptr<Interrupt> interrupt_;
-		std::unique_ptr<LCD> lcd_;
-		std::unique_ptr<PPU> ppu_;
-		std::unique_ptr<Timer> timer_;
-		std::unique_ptr<APU> apu_;
-		std::unique_ptr<CPU> cpu_;
-		std::unique_ptr<Joypad> joypad_;
-		std::unique_ptr<Serial> serial_;
+		std::unique_ptr<Core> core_;
+
+		// core_ の各ユニット
+		Memory* mem_;
+		Interrupt* interrupt_;
+		LCD* lcd_;
+		PPU* ppu_;
+		APU* apu_;
+		CPU* cpu_;
+		Joypad* joypad_;
+
 		std::unique_ptr<DebugMonitor> debugMonitor_;
 		std::unique_ptr<InputMapping> keyMap_;
 		std::unique_ptr<InputMapping> gamepadMap_;
 
+		// セーブステートの書き込み用（バッファを使い回す）
+		std::unique_ptr<StateWriter> stateWriter_;
+
+		// 巻き戻し用に記録した状態
+		std::unique_ptr<RewindBuffer> rewindBuffer_;
+
+		// エミュレーションを実行するスレッド
+		std::unique_ptr<CoreThread> coreThread_;
+
+		// ラン・アヘッドの前に退避した状態
+		std::unique_ptr<StateWriter> runAheadSnapshot_;
+
+		// ラン・アヘッドで先のフレームを進めている
+		bool runningAhead_ = false;
+
 		GUI::Menu rootMenu_;
 		GUI::Menu inputMenu_;
 		GUI::MenuOverlay menuOverlay_{ config_ };
@@ -133,9 +200,6 @@ namespace dmge
 		// APUを使用する
 		bool enableAPU_ = true;
 
-		// (APU)サンプリングレート
-		int sampleRate_ = 44100;
-
 		// 現在の画面表示用パレット番号
 		//int currentPalette_ = 0;
 
@@ -148,14 +212,32 @@ namespace dmge
 		// ロードしているカートリッジのパス
 		Optional<String> currentCartridgePath_{};
 
-		// オーディオストリームに書き込んだサンプル数の合計
-		// 1フレーム分書き込んだら描画に移る
-		int bufferedSamples_ = 0;
-
 		// 前回の描画からの経過サイクル数
-		// 一定のサイクル数を超過したら描画に移る
+		// LCD がオフの間は、1フレーム分のサイクル数を超過したら描画に移る
 		int cyclesFromPreviousDraw_ = 0;
 
+		// 前回の描画の時点の PPU のフレーム数
+		// VBlank に移行してフレーム数が変わったら描画に移る
+		uint64 drawFrameCount_ = 0;
+
+		// 早送り中
+		bool fastForward_ = false;
+
+		// (早送り) 現在のフレームを描画している（VBlank に移行したら画面を更新する）
+		bool fastForwardRendering_ = false;
+
+		// (早送り) コアのスレッドで早送りを行っている（スレッドの実行中はコアのスレッドからのみアクセスする）
+		bool coreFastForward_ = false;
+
+		// (早送り) 前回確認した時点の PPU のフレーム数
+		uint64 fastForwardFrameCount_ = 0;
+
+		// (早送り) 前回の画面更新から進めたフレーム数
+		int framesFromPreviousDraw_ = 0;
+
+		// (早送り) 前回の画面更新からの経過時間
+		Stopwatch drawStopwatch_;
+
 		// テスト ROM (Mooneye) の実行結果
 		MooneyeTestResult mooneyeTestResult_ = MooneyeTestResult::Running;
 	};
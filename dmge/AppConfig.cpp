@@ -31,6 +31,7 @@ namespace dmge
 
 		config.scale = ini.getOr<int>(U"Scale", 3);
 		config.showFPS = ini.getOr<int>(U"ShowFPS", false);
+		config.fastRendering = ini.getOr<int>(U"FastRendering", false);
 		config.palettePreset = ini.getOr<int>(U"PalettePreset", 0);
 		config.paletteColors[0] = ColorF{ U"#" + ini.getOr<String>(U"PaletteColor0", U"e8e8e8") };
 		config.paletteColors[1] = ColorF{ U"#" + ini.getOr<String>(U"PaletteColor1", U"a0a0a0") };
@@ -62,6 +63,14 @@ namespace dmge
 
 		config.enableAudioLPF = ini.getOr<int>(U"EnableAudioLPF", false);
 		config.audioLPFConstant = ini.getOr<double>(U"AudioLPFConstant", 0.8);
+		config.audioSampleRate = Clamp(ini.getOr<int>(U"AudioSampleRate", 48000), 8000, 192000);
+
+		// Emulation
+
+		config.rewindBufferSize = Max(0, ini.getOr<int>(U"RewindBufferSize", 32));
+		config.runAheadFrames = Clamp(ini.getOr<int>(U"RunAheadFrames", 0), 0, RunAheadFramesMax);
+		config.fastForwardSpeed = Clamp(ini.getOr<int>(U"FastForwardSpeed", 4), 0, FastForwardSpeedMax);
+		config.enableCoreThread = ini.getOr<int>(U"EnableCoreThread", false);
 
 		// Debug
 
@@ -73,6 +82,7 @@ namespace dmge
 		config.dumpAddress = MakeArrayFromCommaSeparatedString(ini.getOr<String>(U"DumpAddress", U""));
 		config.traceDumpStartAddress = MakeArrayFromCommaSeparatedString(ini.getOr<String>(U"TraceDumpStartAddress", U""));
 		config.logFilePath = ini.getOr<String>(U"LogFilePath", U"");
+		config.logAudioRateControl = ini.getOr<int>(U"LogAudioRateControl", false);
 		config.testMode = ini.getOr<int>(U"TestMode", false);
 
 		return config;
@@ -110,6 +120,7 @@ namespace dmge
 		writer.writeln(CategoryComment(U"Display"));
 		writer.writeln(KeyValueString(U"Scale", this->scale));
 		writer.writeln(KeyValueString(U"ShowFPS", (int)this->showFPS));
+		writer.writeln(KeyValueString(U"FastRendering", (int)this->fastRendering));
 		writer.writeln(KeyValueString(U"PalettePreset", this->palettePreset));
 		writer.writeln(KeyValueString(U"PaletteColor0", this->paletteColors[0].toColor().toHex()));
 		writer.writeln(KeyValueString(U"PaletteColor1", this->paletteColors[1].toColor().toHex()));
@@ -137,6 +148,13 @@ namespace dmge
 		writer.writeln(CategoryComment(U"Audio"));
 		writer.writeln(KeyValueString(U"EnableAudioLPF", (int)this->enableAudioLPF));
 		writer.writeln(KeyValueString(U"AudioLPFConstant", U"{:.2f}"_fmt(this->audioLPFConstant)));
+		writer.writeln(KeyValueString(U"AudioSampleRate", this->audioSampleRate));
+
+		writer.writeln(CategoryComment(U"Emulation"));
+		writer.writeln(KeyValueString(U"RewindBufferSize", this->rewindBufferSize));
+		writer.writeln(KeyValueString(U"RunAheadFrames", this->runAheadFrames));
+		writer.writeln(KeyValueString(U"FastForwardSpeed", this->fastForwardSpeed));
+		writer.writeln(KeyValueString(U"EnableCoreThread", (int)this->enableCoreThread));
 
 		writer.writeln(CategoryComment(U"Debug"));
 		writer.writeln(KeyValueString(U"ShowConsole", (int)this->showConsole));
@@ -147,6 +165,7 @@ namespace dmge
 		writer.writeln(KeyValueString(U"DumpAddress", CommaSeparatedHexString(this->dumpAddress)));
 		writer.writeln(KeyValueString(U"TraceDumpStartAddress", CommaSeparatedHexString(this->traceDumpStartAddress)));
 		writer.writeln(KeyValueString(U"LogFilePath", this->logFilePath));
+		writer.writeln(KeyValueString(U"LogAudioRateControl", (int)this->logAudioRateControl));
 		writer.writeln(KeyValueString(U"TestMode", (int)this->testMode));
 
 		writer.close();
@@ -164,6 +183,7 @@ namespace dmge
 
 		DebugPrint::Writeln(U"Scale={}"_fmt(scale));
 		DebugPrint::Writeln(U"ShowFPS={}"_fmt(showFPS));
+		DebugPrint::Writeln(U"FastRendering={}"_fmt(fastRendering));
 		DebugPrint::Writeln(U"PalettePreset={}"_fmt(palettePreset));
 		DebugPrint::Writeln(U"CGBColorGamma={}"_fmt(cgbColorGamma));
 
@@ -182,6 +202,12 @@ namespace dmge
 
 		DebugPrint::Writeln(U"EnableAudioLPF={}"_fmt(enableAudioLPF));
 		DebugPrint::Writeln(U"AudioLPFConstant={}"_fmt(audioLPFConstant));
+		DebugPrint::Writeln(U"AudioSampleRate={}"_fmt(audioSampleRate));
+
+		DebugPrint::Writeln(U"RewindBufferSize={}"_fmt(rewindBufferSize));
+		DebugPrint::Writeln(U"RunAheadFrames={}"_fmt(runAheadFrames));
+		DebugPrint::Writeln(U"FastForwardSpeed={}"_fmt(fastForwardSpeed));
+		DebugPrint::Writeln(U"EnableCoreThread={}"_fmt(enableCoreThread));
 
 		DebugPrint::Writeln(U"ShowConsole={}"_fmt(showConsole));
 		DebugPrint::Writeln(U"Breakpoint={}"_fmt(CommaSeparatedHexString(breakpoints)));
@@ -191,6 +217,7 @@ namespace dmge
 		DebugPrint::Writeln(U"DumpAddress={}"_fmt(CommaSeparatedHexString(dumpAddress)));
 		DebugPrint::Writeln(U"TraceDumpStartAddress={}"_fmt(CommaSeparatedHexString(traceDumpStartAddress)));
 		DebugPrint::Writeln(U"LogFilePath={}"_fmt(logFilePath));
+		DebugPrint::Writeln(U"LogAudioRateControl={}"_fmt(logAudioRateControl));
 		DebugPrint::Writeln(U"ShowDebugMonitor={}"_fmt(showDebugMonitor));
 	}
 }
@@ -8,6 +8,8 @@ namespace dmge
 	{
 		static inline constexpr StringView ConfigFilePath = U"config.ini"_sv;
 		static inline constexpr int ScalingMax = 8;
+		static inline constexpr int RunAheadFramesMax = 4;
+		static inline constexpr int FastForwardSpeedMax = 8;
 
 		// config.ini のパース結果を返す
 		static AppConfig LoadConfig();
@@ -47,6 +49,9 @@ namespace dmge
 		// FPSを表示する
 		bool showFPS = false;
 
+		// 高速描画モード（行単位で描画する）
+		bool fastRendering = false;
+
 		// (DMG/SGB) パレット番号
 		int palettePreset = 0;
 
@@ -88,6 +93,27 @@ namespace dmge
 		// ローパスフィルタの定数
 		double audioLPFConstant = 0.8;
 
+		// 出力サンプリングレート [Hz]
+		int audioSampleRate = 48000;
+
+
+		// --------------------------------
+		// Emulation
+		// --------------------------------
+
+		// 巻き戻し用に記録する状態の上限 [MB]（0 の場合は巻き戻しを無効にする）
+		int rewindBufferSize = 32;
+
+		// ラン・アヘッドで先に進めるフレーム数（0 の場合は無効）
+		int runAheadFrames = 0;
+
+		// 早送りの速度の上限（倍率、0 の場合は上限なし）
+		int fastForwardSpeed = 4;
+
+		// エミュレーションを画面の更新とは別のスレッドで実行する
+		// ブレークポイント・トレースダンプ・テストROM実行モードを使う場合は、このスレッドを使わずに実行する
+		bool enableCoreThread = false;
+
 
 		// --------------------------------
 		// Debug
@@ -120,6 +146,9 @@ namespace dmge
 		// ログ出力先
 		String logFilePath{};
 
+		// 音声の出力サンプリングレートの調整の状態（バッファリングしているサンプル数と調整比率）をログに出力する
+		bool logAudioRateControl = false;
+
 		// テストROM実行モード
 		bool testMode = false;
 	};
@@ -4,22 +4,47 @@
 #include "../Address.h"
 #include "../Timing.h"
 #include "../Timer.h"
+#include "../Scheduler.h"
+#include "../SaveState.h"
+#include "../DebugPrint.h"
 
 namespace dmge
 {
-	APU::APU(Timer& timer, int sampleRate)
+	namespace
+	{
+		// スケジューラのイベントにより同期する間隔 [T-cycles]
+		// オーディオストリームへの書き込みが大きく遅れない程度の間隔とする
+		constexpr uint64 SyncIntervalCycles = 1024;
+
+		// オーディオストリームにバッファリングするサンプル数の目標 [秒]
+		constexpr double TargetBufferSeconds = 0.040;
+
+		// 出力サンプリングレートの調整比率の最大の変化量
+		// 音程の変化が聞き取れない程度 (±0.5%) に抑える
+		constexpr double MaxRateDelta = 0.005;
+	}
+
+	APU::APU(Timer& timer, Scheduler& scheduler, int sampleRate, bool headless)
 		:
 		timer_{ timer },
+		scheduler_{ scheduler },
 		sampleRate_{ sampleRate },
-		apuStream_{ std::make_shared<APUStream>() },
-		audio_{ apuStream_ },
+		apuStream_{ std::make_shared<APUStream>(sampleRate) },
+		audio_{ headless ? Audio{} : Audio{ apuStream_, Arg::sampleRate = static_cast<uint32>(sampleRate) } },
 		ch1_{},
 		ch2_{},
 		ch3_{},
 		ch4_{},
 		frameSeq_{},
+		blip_{ ClockFrequency, sampleRate },
 		mute_{ false, false, false, false }
 	{
+		pendingSamples_.reserve(256);
+	}
+
+	int APU::sampleRate() const
+	{
+		return sampleRate_;
 	}
 
 	void APU::setCGBMode(bool value)
@@ -32,26 +57,109 @@ namespace dmge
 		divShiftBits_ = value ? 1 : 0;
 	}
 
-	int APU::run()
+	void APU::sync()
 	{
-		// マスタースイッチがOffならAPUを停止する
+		const uint64 now = scheduler_.now();
+		const uint64 factor = 1ull << divShiftBits_;
 
-		if (not masterSwitch_)
+		if (not enableEmulation_)
 		{
-			audio_.pause();
-			return 0;
+			lastSync_ += (now - lastSync_) / factor * factor;
+			return;
 		}
 
+		// 1クロックずつ処理せず、次のイベント（Frame Sequencer のクロック・チャンネルの出力の変化）までの区間ごとに、
+		// 各チャンネルの Frequency Timer をまとめて進める
+		// 出力が無効の間は、チャンネルの出力の変化では区切らない
+
+		while (lastSync_ + factor <= now)
+		{
+			const uint64 remainClocks = (now - lastSync_) / factor;
+
+			// マスタースイッチがOffならAPUを停止する
+			if (not masterSwitch_)
+			{
+				audio_.pause();
+				lastSync_ += remainClocks * factor;
+				break;
+			}
+
+			uint64 clocks = Min(remainClocks, clocksToFrameSequencerEdge_());
+
+			if (enableOutput_)
+			{
+				clocks = Min(clocks, clocksToNextEdge_());
+			}
+
+			run_(static_cast<int>(clocks));
+		}
+
+		if (enableOutput_)
+		{
+			readSamples_();
+		}
+
+		flushSamples_();
+
+		scheduler_.schedule(SchedulerEvent::APU, lastSync_ + SyncIntervalCycles);
+	}
+
+	void APU::setEnableEmulation(bool enable)
+	{
+		sync();
+
+		enableEmulation_ = enable;
+
+		if (enable)
+		{
+			sync();
+		}
+		else
+		{
+			scheduler_.cancel(SchedulerEvent::APU);
+		}
+	}
+
+	void APU::setEnableOutput(bool enable)
+	{
+		enableOutput_ = enable;
+	}
+
+	void APU::setOutputRateScale(double scale)
+	{
+		// BlipBuffer のサンプリングレートはフレームの途中で変えられないので、次の readSamples_() で endFrame() の後に反映する
+		outputRateScale_ = scale;
+	}
+
+	void APU::setLogRateControl(bool enable)
+	{
+		logRateControl_ = enable;
+		samplesFromPreviousLog_ = 0;
+	}
+
+	void APU::run_(int clocks)
+	{
+		const uint64 factor = 1ull << divShiftBits_;
+		const uint64 timestamp = lastSync_ + clocks * factor;
+
 		// 各チャンネルの Frequency Timer を進める
 
-		ch1_.step();
-		ch2_.step();
-		ch3_.step();
-		ch4_.step();
+		ch1_.step(clocks);
+		ch2_.step(clocks);
+		ch3_.step(clocks);
+		ch4_.step(clocks);
 
 		// Frame Sequencer
+		// 区間の途中で DIV は立ち下がらないので、最後の1クロック前の値を経由して立下りを判定すればよい
+
+		if (clocks > 1)
+		{
+			frameSeq_.step(divAt_(timestamp - factor));
+		}
+
+		frameSeq_.step(divAt_(timestamp));
 
-		frameSeq_.step(timer_.div() >> divShiftBits_);
+		lastSync_ = timestamp;
 
 		const bool onExtraLengthClock = frameSeq_.onExtraLengthClock();
 		ch1_.setExtraLengthClockCondition(onExtraLengthClock);
@@ -86,81 +194,174 @@ namespace dmge
 		}
 
 		// Output audio
-		// (CPUFreq / SampleRate) ==> 4194304 / 44100 ==> Every 95.1 T-cycles
+		// 出力の変化を、帯域制限したステップとして記録する
 
-		cycles_ += 1.0;
+		if (enableOutput_)
+		{
+			blipClock_ += clocks;
+		}
 
-		if (cycles_ >= 1.0 * ClockFrequency / sampleRate_)
+		recordOutput_();
+	}
+
+	void APU::recordOutput_()
+	{
+		if (not enableOutput_) return;
+
+		if (const auto output = mixOutput_(); output != output_)
 		{
-			cycles_ -= 1.0 * ClockFrequency / sampleRate_;
+			blip_.addDelta(blipClock_, output[0] - output_[0], output[1] - output_[1]);
+			output_ = output;
+		}
+	}
 
-			const std::array<int, 4> chAmp = {
-				(1 - mute_[0]) * ch1_.amplitude() * ch1_.getEnable(),
-				(1 - mute_[1]) * ch2_.amplitude() * ch2_.getEnable(),
-				(1 - mute_[2]) * ch3_.amplitude() * ch3_.getEnable(),
-				(1 - mute_[3]) * ch4_.amplitude() * ch4_.getEnable(),
-			};
+	std::array<double, 2> APU::mixOutput_() const
+	{
+		const std::array<int, 4> chAmp = {
+			(1 - mute_[0]) * ch1_.amplitude() * ch1_.getEnable(),
+			(1 - mute_[1]) * ch2_.amplitude() * ch2_.getEnable(),
+			(1 - mute_[2]) * ch3_.amplitude() * ch3_.getEnable(),
+			(1 - mute_[3]) * ch4_.amplitude() * ch4_.getEnable(),
+		};
 
-			// Input / Panning
+		// Input / Panning
 
-			std::array<int, 4> leftInput = { 0, 0, 0, 0 };
-			std::array<int, 4> rightInput = { 0, 0, 0, 0 };
+		std::array<int, 4> leftInput = { 0, 0, 0, 0 };
+		std::array<int, 4> rightInput = { 0, 0, 0, 0 };
 
-			for (int i : step(4))
-			{
-				if ((nr51_ >> i) & 1) rightInput[i] = chAmp[i];
-				if ((nr51_ >> (i + 4)) & 1) leftInput[i] = chAmp[i];
-			}
+		for (int i : step(4))
+		{
+			if ((nr51_ >> i) & 1) rightInput[i] = chAmp[i];
+			if ((nr51_ >> (i + 4)) & 1) leftInput[i] = chAmp[i];
+		}
+
+		// DAC Output
+
+		double left = 0;
+		double right = 0;
+
+		for (int i : step(4))
+		{
+			left += (leftInput[i] / 7.5) - 1.0;
+			right += (rightInput[i] / 7.5) - 1.0;
+		}
 
-			// DAC Output
+		// Master Volume
 
-			double left = 0;
-			double right = 0;
+		const double leftVolume = (((nr50_ >> 4) & 0b111) + 1) / 8.0;
+		const double rightVolume = (((nr50_ >> 0) & 0b111) + 1) / 8.0;
 
-			for (int i : step(4))
+		return { left * leftVolume / 4.0, right * rightVolume / 4.0 };
+	}
+
+	void APU::readSamples_()
+	{
+		blip_.endFrame(blipClock_);
+		blipClock_ = 0;
+
+		std::array<std::array<double, 2>, 256> samples;
+		int written = 0;
+
+		while (blip_.samplesAvailable() > 0)
+		{
+			const int count = blip_.readSamples(samples.data(), static_cast<int>(samples.size()));
+
+			for (int i : step(count))
 			{
-				left += (leftInput[i] / 7.5) - 1.0;
-				right += (rightInput[i] / 7.5) - 1.0;
+				// 再生を止めている間などにバッファが溜まりすぎないよう、目標の2倍を超えた分は書き込まない
+				// 通常は出力サンプリングレートの調整により、ここで捨てることはない
+				if (apuStream_->bufferRemain() + static_cast<int>(pendingSamples_.size()) > targetBufferSamples_() * 2)
+				{
+					continue;
+				}
+
+				const double k = enableLPF_ ? lpfConstant_ : 1.0;
+				lpfLeft_ = (1.0 - k) * lpfLeft_ + k * samples[i][0];
+				lpfRight_ = (1.0 - k) * lpfRight_ + k * samples[i][1];
+
+				pendingSamples_.push_back(WaveSample{ static_cast<float>(lpfLeft_), static_cast<float>(lpfRight_) });
+				++written;
 			}
+		}
+
+		// 出力サンプリングレートの調整 (Dynamic Rate Control)
+		// エミュレーションの速度とオーディオデバイスの再生速度のずれで、バッファが不足したり溜まり続けたりしないよう、
+		// バッファが目標より少なければサンプルを多めに、多ければ少なめに生成する
 
-			// Master Volume
+		const int target = targetBufferSamples_();
+		const int buffered = apuStream_->bufferRemain() + static_cast<int>(pendingSamples_.size());
 
-			const double leftVolume = (((nr50_ >> 4) & 0b111) + 1) / 8.0;
-			const double rightVolume = (((nr50_ >> 0) & 0b111) + 1) / 8.0;
+		rateRatio_ = 1.0 + MaxRateDelta * Clamp(static_cast<double>(target - buffered) / target, -1.0, 1.0);
+		blip_.setSampleRate(sampleRate_ * outputRateScale_ * rateRatio_);
 
-			// バッファが十分なら書き込まない
+		if (logRateControl_)
+		{
+			// 約1秒ごとに出力する
+			samplesFromPreviousLog_ += written;
 
-			if (apuStream_->bufferRemain() > sampleRate_ / 8)
+			if (samplesFromPreviousLog_ >= sampleRate_)
 			{
-				return 0;
+				samplesFromPreviousLog_ = 0;
+				DebugPrint::Writeln(U"APU: buffer={:5d} ({:5.1f}ms) ratio={:.5f}"_fmt(buffered, 1000.0 * buffered / sampleRate_, rateRatio_));
 			}
+		}
+	}
 
-			const double k = enableLPF_ ? lpfConstant_ : 1.0;
-			lpfLeft_ = (1.0 - k) * lpfLeft_ + k * (left * leftVolume / 4.0);
-			lpfRight_ = (1.0 - k) * lpfRight_ + k * (right * rightVolume / 4.0);
+	int APU::targetBufferSamples_() const
+	{
+		return static_cast<int>(sampleRate_ * TargetBufferSeconds);
+	}
+
+	uint8 APU::divAt_(uint64 timestamp) const
+	{
+		return static_cast<uint8>((timer_.divCounterAt(timestamp) >> 8) >> divShiftBits_);
+	}
 
-			apuStream_->pushSample(lpfLeft_, lpfRight_);
+	uint64 APU::clocksToFrameSequencerEdge_() const
+	{
+		const uint64 factor = 1ull << divShiftBits_;
+		const uint64 next = lastSync_ + factor;
 
+		// 前回のクロックの後に DIV がリセットされた場合は、次のクロックで立ち下がりうる
+		if (frameSeq_.isFallingEdge(divAt_(next)))
+		{
 			return 1;
 		}
 
-		return 0;
+		// DIV のカウンタの bit 12（倍速モードでは bit 13）が次に立ち下がるまで
+		const uint64 span = 1ull << (13 + divShiftBits_);
+		const uint64 cyclesToEdge = span - timer_.divCounterAt(next) % span;
+
+		return 1 + (cyclesToEdge + factor - 1) / factor;
 	}
 
-	void APU::playIfBufferEnough(int thresholdSamples)
+	uint64 APU::clocksToNextEdge_() const
 	{
-		if (audio_.isPlaying()) return;
-		if (apuStream_->bufferRemain() < thresholdSamples) return;
+		// 無効またはミュートしているチャンネルは、出力が変化しないので除く
+		uint64 clocks = std::numeric_limits<uint64>::max();
 
-		audio_.play();
+		if (ch1_.getEnable() && not mute_[0]) clocks = Min<uint64>(clocks, ch1_.clocksToNextEdge());
+		if (ch2_.getEnable() && not mute_[1]) clocks = Min<uint64>(clocks, ch2_.clocksToNextEdge());
+		if (ch3_.getEnable() && not mute_[2]) clocks = Min<uint64>(clocks, ch3_.clocksToNextEdge());
+		if (ch4_.getEnable() && not mute_[3]) clocks = Min<uint64>(clocks, ch4_.clocksToNextEdge());
+
+		return clocks;
 	}
 
-	void APU::pauseIfBufferNotEnough(int thresholdSamples)
+	void APU::flushSamples_()
 	{
-		if (not audio_.isPlaying()) return;
-		if (apuStream_->bufferRemain() > thresholdSamples) return;
+		if (pendingSamples_.empty()) return;
 
-		audio_.pause();
+		apuStream_->pushSamples(pendingSamples_.data(), pendingSamples_.size());
+		pendingSamples_.clear();
+	}
+
+	void APU::playIfBufferEnough()
+	{
+		if (audio_.isPlaying()) return;
+		if (apuStream_->bufferRemain() < targetBufferSamples_()) return;
+
+		audio_.play();
 	}
 
 	void APU::pause()
@@ -339,6 +540,10 @@ namespace dmge
 		{
 			ch3_.writeWaveData(addr, value);
 		}
+
+		// 書き込みによる出力の変化（音量・パンニング・トリガー・DAC など）は、次のイベントを待たずに書き込んだ時刻で記録する
+		// 書き込みの前に sync() で現在時刻まで進めているので、blipClock_ は書き込んだ時刻を指している
+		recordOutput_();
 	}
 
 	uint8 APU::readRegister(uint16 addr) const
@@ -454,7 +659,13 @@ namespace dmge
 
 	APUStreamBufferState APU::getBufferState() const
 	{
-		return APUStreamBufferState{ apuStream_->bufferRemain(), apuStream_->bufferMaxSize() };
+		return APUStreamBufferState{
+			.remain = apuStream_->bufferRemain(),
+			.max = apuStream_->bufferMaxSize(),
+			.underrun = apuStream_->underrunSamples(),
+			.overrun = apuStream_->overrunSamples(),
+			.rateRatio = rateRatio_,
+		};
 	}
 
 	std::array<int, 4> APU::getAmplitude() const
@@ -499,4 +710,41 @@ namespace dmge
 	{
 		return lpfConstant_;
 	}
+
+	void APU::saveState(StateWriter& writer) const
+	{
+		ch1_.saveState(writer);
+		ch2_.saveState(writer);
+		ch3_.saveState(writer);
+		ch4_.saveState(writer);
+		frameSeq_.saveState(writer);
+		writer.write(nr50_);
+		writer.write(nr51_);
+		writer.write(masterSwitch_);
+		writer.write(lastSync_);
+		writer.write(cgbMode_);
+		writer.write(divShiftBits_);
+		writer.write(lpfLeft_);
+		writer.write(lpfRight_);
+	}
+
+	void APU::loadState(StateReader& reader)
+	{
+		ch1_.loadState(reader);
+		ch2_.loadState(reader);
+		ch3_.loadState(reader);
+		ch4_.loadState(reader);
+		frameSeq_.loadState(reader);
+		reader.read(nr50_);
+		reader.read(nr51_);
+		reader.read(masterSwitch_);
+		reader.read(lastSync_);
+		reader.read(cgbMode_);
+		reader.read(divShiftBits_);
+		reader.read(lpfLeft_);
+		reader.read(lpfRight_);
+
+		// 読み込み前の時刻のサンプルは書き込まない
+		pendingSamples_.clear();
+	}
 }
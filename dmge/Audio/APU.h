@@ -4,13 +4,24 @@
 #include "WaveChannel.h"
 #include "NoiseChannel.h"
 #include "FrameSequencer.h"
+#include "BlipBuffer.h"
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	struct APUStreamBufferState
 	{
 		int remain;
 		int max;
+
+		// アンダーラン・オーバーランしたサンプル数の合計
+		uint64 underrun;
+		uint64 overrun;
+
+		// 出力サンプリングレートの調整比率（1.0 で調整なし）
+		double rateRatio;
 	};
 
 
@@ -18,27 +29,46 @@ namespace dmge
 
 	class Timer;
 
+	class Scheduler;
+
 	class APUStream;
 
 	class APU
 	{
 	public:
-		APU(Timer& timer, int sampleRate = 44100);
+		// sampleRate : オーディオストリームに出力するサンプリングレート [Hz]
+		// headless == true の場合、オーディオ出力 (Audio) を作成しない
+		APU(Timer& timer, Scheduler& scheduler, int sampleRate = 48000, bool headless = false);
+
+		// オーディオストリームに出力するサンプリングレート [Hz]
+		int sampleRate() const;
 
 		void setCGBMode(bool value);
 
 		void setDoubleSpeed(bool value);
 
-		// サウンド処理を1クロック分実行し、
-		// サンプリングレートの周期にある場合はオーディオストリームにサンプルを書き込む
-		// バッファに書き込んだサンプル数を返却する
-		int run();
+		// 前回の同期時刻から現在時刻までのサウンド処理を実行する
+		// APUレジスタへのアクセス前と、スケジューラのイベントで定期的に呼ばれる
+		void sync();
+
+		// エミュレーションの有効・無効を設定する
+		// 無効の間は sync() で経過時間を読み捨てる
+		void setEnableEmulation(bool enable);
+
+		// オーディオストリームへの出力の有効・無効を設定する
+		// 無効の間もサウンド処理は行うが、サンプルを生成しない
+		void setEnableOutput(bool enable);
+
+		// 出力サンプリングレートの基準の倍率を設定する（1.0 で実機と同じ速度）
+		// エミュレーションの1フレームを 1/60 秒で表示する場合は、実機のフレームレートとの比率を設定する
+		// 次に出力サンプルを生成するときに反映する（どのスレッドから呼んでもよい）
+		void setOutputRateScale(double scale);
 
-		// オーディオストリームのバッファリングがしきい値を超えている場合に再生を開始する
-		void playIfBufferEnough(int thresholdSamples);
+		// 出力サンプリングレートの調整の状態をログに出力する（チューニング用）
+		void setLogRateControl(bool enable);
 
-		// オーディオストリームのバッファリングがしきい値未満の場合に再生を一時停止する
-		void pauseIfBufferNotEnough(int thresholdSamples);
+		// オーディオストリームのバッファリングが目標量に達している場合に再生を開始する
+		void playIfBufferEnough();
 
 		// オーディオストリームの再生を一時停止する
 		void pause();
@@ -79,9 +109,16 @@ namespace dmge
 		// LPF
 		double getLPFConstant() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Timer& timer_;
 
+		Scheduler& scheduler_;
+
 		int sampleRate_;
 
 		std::shared_ptr<APUStream> apuStream_;
@@ -103,8 +140,40 @@ namespace dmge
 		// Master switch (NR52.7)
 		bool masterSwitch_ = false;
 
-		// Count T-cycles
-		double cycles_ = 0;
+		// 出力の変化を記録し、サンプリングレートのサンプルに変換する
+		BlipBuffer blip_;
+
+		// blip_ の現在のフレームの先頭からのクロック数
+		uint64 blipClock_ = 0;
+
+		// 最後に blip_ に記録した出力 (左, 右)
+		std::array<double, 2> output_{};
+
+		// 前回 sync() した時刻
+		uint64 lastSync_ = 0;
+
+		// エミュレーションが有効
+		bool enableEmulation_ = true;
+
+		// オーディオストリームへの出力が有効
+		bool enableOutput_ = true;
+
+		// 出力サンプリングレートの基準の倍率
+		std::atomic<double> outputRateScale_ = 1.0;
+
+		// 出力サンプリングレートの調整比率
+		// バッファリングしているサンプル数が目標量に近づくよう、readSamples_() ごとに最大 ±0.5% の範囲で調整する
+		double rateRatio_ = 1.0;
+
+		// 調整の状態をログに出力する
+		bool logRateControl_ = false;
+
+		// 前回ログに出力してから書き込んだサンプル数
+		int samplesFromPreviousLog_ = 0;
+
+		// オーディオストリームに書き込む前のサンプル
+		// sync() の終わりにまとめて書き込む
+		Array<WaveSample> pendingSamples_;
 
 		// CGB Mode
 		bool cgbMode_ = false;
@@ -122,5 +191,32 @@ namespace dmge
 		double lpfLeft_ = 0;
 		double lpfRight_ = 0;
 
+		// サウンド処理を clocks クロック分まとめて実行し、出力が変化した場合は blip_ に記録する
+		// clocks は次のイベント（Frame Sequencer のクロック・チャンネルの出力の変化）までのクロック数以下とする
+		void run_(int clocks);
+
+		// 各チャンネルの出力をミックスした、現在の出力 (左, 右)
+		std::array<double, 2> mixOutput_() const;
+
+		// 現在の出力が output_ から変化していれば、現在時刻 (blipClock_) のステップとして blip_ に記録する
+		void recordOutput_();
+
+		// blip_ から読み出せるサンプルを pendingSamples_ に書き込み、次のフレームの出力サンプリングレートを調整する
+		void readSamples_();
+
+		// バッファリングするサンプル数の目標
+		int targetBufferSamples_() const;
+
+		// 時刻 timestamp における、Frame Sequencer が参照する DIV の値
+		uint8 divAt_(uint64 timestamp) const;
+
+		// 次に Frame Sequencer がクロックする（DIV が立ち下がる）までのクロック数
+		uint64 clocksToFrameSequencerEdge_() const;
+
+		// 次にいずれかのチャンネルの出力が変化しうるまでのクロック数
+		uint64 clocksToNextEdge_() const;
+
+		// pendingSamples_ をオーディオストリームに書き込む
+		void flushSamples_();
 	};
 }
@@ -3,10 +3,9 @@
 
 namespace dmge
 {
-	APUStream::APUStream()
+	APUStream::APUStream(int bufferSize)
 	{
-		// 最大1s分のバッファ
-		wave_.resize(44100);
+		wave_.resize(bufferSize);
 	}
 
 	APUStream::~APUStream()
@@ -15,21 +14,38 @@ namespace dmge
 
 	void APUStream::getAudio(float* left, float* right, size_t samplesToWrite)
 	{
-		const int buffer = bufferRemain();
-		const int writable = (buffer >= samplesToWrite) ? samplesToWrite : buffer;
+		const uint64 head = head_.load(std::memory_order_relaxed);
+		const uint64 tail = tail_.load(std::memory_order_acquire);
 
-		for (const auto i : step(writable))
+		const size_t readable = Min<size_t>(tail - head, samplesToWrite);
+
+		// リングバッファの終端で折り返すので、最大2回に分けて読み出す
+		size_t pos = head % wave_.size();
+
+		for (size_t remain = readable; remain > 0;)
 		{
-			*(left++) = wave_[posHead_].left;
-			*(right++) = wave_[posHead_].right;
+			const size_t count = Min(remain, wave_.size() - pos);
+			const WaveSample* src = wave_.data() + pos;
 
-			posHead_ = (posHead_ + 1) % wave_.size();
+			for (size_t i = 0; i < count; ++i)
+			{
+				*(left++) = src[i].left;
+				*(right++) = src[i].right;
+			}
+
+			remain -= count;
+			pos = 0;
 		}
 
-		for (const auto i : step(samplesToWrite - writable))
+		head_.store(head + readable, std::memory_order_release);
+
+		// 足りない分は無音で埋める
+		if (const size_t missing = samplesToWrite - readable; missing > 0)
 		{
-			*(left++) = 0;
-			*(right++) = 0;
+			std::fill_n(left, missing, 0.0f);
+			std::fill_n(right, missing, 0.0f);
+
+			underrunSamples_.fetch_add(missing, std::memory_order_relaxed);
 		}
 	}
 
@@ -42,26 +58,60 @@ namespace dmge
 	{
 	}
 
-	void APUStream::pushSample(float left, float right)
+	void APUStream::pushSamples(const WaveSample* samples, size_t count)
 	{
-		wave_[posTail_].left = left;
-		wave_[posTail_].right = right;
+		const uint64 tail = tail_.load(std::memory_order_relaxed);
+		const uint64 head = head_.load(std::memory_order_acquire);
+
+		const size_t writable = Min<size_t>(wave_.size() - (tail - head), count);
+
+		size_t pos = tail % wave_.size();
+
+		for (size_t remain = writable; remain > 0;)
+		{
+			const size_t n = Min(remain, wave_.size() - pos);
+
+			std::copy_n(samples, n, wave_.data() + pos);
+
+			samples += n;
+			remain -= n;
+			pos = 0;
+		}
+
+		tail_.store(tail + writable, std::memory_order_release);
 
-		posTail_ = (posTail_ + 1) % wave_.size();
+		if (writable < count)
+		{
+			overrunSamples_.fetch_add(count - writable, std::memory_order_relaxed);
+		}
+	}
+
+	void APUStream::pushSample(float left, float right)
+	{
+		const WaveSample sample{ left, right };
+		pushSamples(&sample, 1);
 	}
 
 	int APUStream::bufferRemain() const
 	{
-		if (posTail_ >= posHead_)
-		{
-			return posTail_ - posHead_;
-		}
+		const uint64 head = head_.load(std::memory_order_acquire);
+		const uint64 tail = tail_.load(std::memory_order_acquire);
 
-		return posTail_ - posHead_ + wave_.size();
+		return static_cast<int>(tail - head);
 	}
 
 	int APUStream::bufferMaxSize() const
 	{
 		return wave_.size();
 	}
+
+	uint64 APUStream::underrunSamples() const
+	{
+		return underrunSamples_.load(std::memory_order_relaxed);
+	}
+
+	uint64 APUStream::overrunSamples() const
+	{
+		return overrunSamples_.load(std::memory_order_relaxed);
+	}
 }
@@ -2,19 +2,34 @@
 
 namespace dmge
 {
+	// APU からオーディオスレッドへサンプルを受け渡すストリーム
+	// - 書き込み (pushSamples) はエミュレーションスレッド、読み出し (getAudio) はオーディオスレッドのみが行う
+	//   (single-producer / single-consumer のリングバッファ)
+	// - 読み出し位置・書き込み位置はそれぞれ一方のスレッドのみが更新し、acquire / release で受け渡す
 	class APUStream : public IAudioStream
 	{
 	public:
-		APUStream();
+		// bufferSize : バッファに保持できるサンプル数
+		explicit APUStream(int bufferSize);
 
 		virtual ~APUStream();
 
+		// サンプルをまとめて書き込む
+		// バッファに空きがない場合、書き込めなかったサンプルは捨ててオーバーランとして数える
+		void pushSamples(const WaveSample* samples, size_t count);
+
 		void pushSample(float left, float right);
 
 		int bufferRemain() const;
 
 		int bufferMaxSize() const;
 
+		// 再生時にバッファが不足して無音で埋めたサンプル数の合計
+		uint64 underrunSamples() const;
+
+		// バッファに空きがなく捨てたサンプル数の合計
+		uint64 overrunSamples() const;
+
 	private:
 		virtual void getAudio(float* left, float* right, size_t samplesToWrite) override;
 
@@ -25,8 +40,12 @@ namespace dmge
 	private:
 		Wave wave_;
 
-		int posHead_ = 0;
-		int posTail_ = 0;
+		// 読み出し・書き込みしたサンプル数の合計
+		// バッファ内の位置は wave_.size() で割った余り
+		alignas(64) std::atomic<uint64> head_ = 0;
+		alignas(64) std::atomic<uint64> tail_ = 0;
 
+		std::atomic<uint64> underrunSamples_ = 0;
+		std::atomic<uint64> overrunSamples_ = 0;
 	};
 }
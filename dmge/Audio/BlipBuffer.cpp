@@ -0,0 +1,122 @@
+﻿#include "../stdafx.h"
+#include "BlipBuffer.h"
+
+namespace dmge
+{
+	namespace
+	{
+		// 帯域制限したステップ1つあたりのサンプル数
+		constexpr int Width = 16;
+
+		// サンプルの間の時刻の分解能
+		constexpr int Phases = 64;
+
+		// カットオフ周波数（サンプリングレートに対する比）
+		constexpr double Cutoff = 0.45;
+
+		using BlipKernel = std::array<std::array<double, Width>, Phases + 1>;
+
+		// 帯域制限したインパルス（窓関数をかけた sinc 関数）を、サンプルの間の時刻 (Phases 段階) ごとに求めたもの
+		// 各時刻の係数の合計は1（積分したときにステップの高さが変わらない）
+		BlipKernel MakeBlipKernel()
+		{
+			BlipKernel kernel{};
+
+			for (int phase = 0; phase <= Phases; ++phase)
+			{
+				double sum = 0;
+
+				for (int i = 0; i < Width; ++i)
+				{
+					// インパルスの中心からの距離 [サンプル]
+					const double t = (i - (Width / 2 - 1)) - static_cast<double>(phase) / Phases;
+					const double x = 2.0 * Cutoff * t;
+					const double sinc = (t == 0) ? 1.0 : std::sin(Math::Pi * x) / (Math::Pi * x);
+
+					// Blackman 窓
+					const double w = 0.42 + 0.5 * std::cos(Math::TwoPi * t / Width) + 0.08 * std::cos(2.0 * Math::TwoPi * t / Width);
+
+					kernel[phase][i] = sinc * w;
+					sum += kernel[phase][i];
+				}
+
+				for (auto& k : kernel[phase])
+				{
+					k /= sum;
+				}
+			}
+
+			return kernel;
+		}
+	}
+
+	BlipBuffer::BlipBuffer(double clockRate, int sampleRate)
+		:
+		clockRate_{ clockRate },
+		clocksPerSample_{ clockRate / sampleRate },
+		deltas_(1024 + Width)
+	{
+	}
+
+	void BlipBuffer::addDelta(uint64 clock, double deltaLeft, double deltaRight)
+	{
+		static const BlipKernel Kernel = MakeBlipKernel();
+
+		const double pos = frameStart_ + clock / clocksPerSample_;
+		const int index = static_cast<int>(pos);
+		const int phase = static_cast<int>((pos - index) * Phases + 0.5);
+
+		if (index + Width > static_cast<int>(deltas_.size()))
+		{
+			deltas_.resize(index + Width);
+		}
+
+		for (int i = 0; i < Width; ++i)
+		{
+			deltas_[index + i][0] += deltaLeft * Kernel[phase][i];
+			deltas_[index + i][1] += deltaRight * Kernel[phase][i];
+		}
+	}
+
+	void BlipBuffer::endFrame(uint64 clocks)
+	{
+		frameStart_ += clocks / clocksPerSample_;
+		available_ = static_cast<int>(frameStart_);
+
+		if (available_ + Width > static_cast<int>(deltas_.size()))
+		{
+			deltas_.resize(available_ + Width);
+		}
+	}
+
+	void BlipBuffer::setSampleRate(double sampleRate)
+	{
+		clocksPerSample_ = clockRate_ / sampleRate;
+	}
+
+	int BlipBuffer::samplesAvailable() const
+	{
+		return available_;
+	}
+
+	int BlipBuffer::readSamples(std::array<double, 2>* out, int count)
+	{
+		const int n = Min(count, available_);
+
+		for (int i = 0; i < n; ++i)
+		{
+			integrator_[0] += deltas_[i][0];
+			integrator_[1] += deltas_[i][1];
+			out[i] = integrator_;
+		}
+
+		// 読み出した分を詰め、空いた末尾を0で埋める
+		std::move(deltas_.begin() + n, deltas_.end(), deltas_.begin());
+		std::fill(deltas_.end() - n, deltas_.end(), std::array<double, 2>{});
+
+		frameStart_ -= n;
+		available_ -= n;
+
+		return n;
+	}
+}
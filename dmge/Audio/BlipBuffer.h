@@ -0,0 +1,54 @@
+﻿#pragma once
+
+namespace dmge
+{
+	// 帯域制限したステップ波形の合成 (BLEP)
+	// 出力の変化量（デルタ）を、入力クロック単位の時刻とともに記録し、
+	// 出力サンプリングレートのサンプル列として読み出す
+	// - デルタはサンプルの間の時刻も考慮し、ナイキスト周波数以下に帯域制限したステップとして加算する
+	// - 読み出すときにデルタを積分して出力レベルに戻す
+	// - 出力は帯域制限したステップの幅の半分（8サンプル）だけ遅延する
+	class BlipBuffer
+	{
+	public:
+		// clockRate : 入力のクロック周波数 [Hz]
+		// sampleRate : 出力のサンプリングレート [Hz]
+		BlipBuffer(double clockRate, int sampleRate);
+
+		// 現在のフレームの先頭から clock クロックの時刻に、出力を (deltaLeft, deltaRight) だけ変化させる
+		void addDelta(uint64 clock, double deltaLeft, double deltaRight);
+
+		// 現在のフレームを clocks クロックで終え、その時刻までのサンプルを読み出せるようにする
+		// 次のフレームの先頭は、このフレームの終わりの時刻になる
+		void endFrame(uint64 clocks);
+
+		// 読み出せるサンプル数
+		int samplesAvailable() const;
+
+		// 最大 count サンプルを out に読み出し、読み出したサンプル数を返す
+		int readSamples(std::array<double, 2>* out, int count);
+
+		// 出力のサンプリングレートを変更する
+		// 現在のフレームのデルタの位置が変わらないよう、endFrame() の後（次の addDelta() の前）に呼ぶ
+		void setSampleRate(double sampleRate);
+
+	private:
+		// 入力のクロック周波数 [Hz]
+		double clockRate_;
+
+		// 1サンプルあたりのクロック数
+		double clocksPerSample_;
+
+		// 現在のフレームの先頭の、バッファ内の位置 [サンプル]
+		double frameStart_ = 0;
+
+		// 読み出せるサンプル数
+		int available_ = 0;
+
+		// 各サンプルの出力の変化量
+		Array<std::array<double, 2>> deltas_;
+
+		// 読み出したサンプルまでの変化量の合計（出力レベル）
+		std::array<double, 2> integrator_{};
+	};
+}
@@ -1,6 +1,7 @@
 ﻿#include "../stdafx.h"
 #include "Channel.h"
 #include "../Memory.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -23,4 +24,16 @@ namespace dmge
 	{
 		dacEnabled_ = enable;
 	}
+
+	void Channel::saveState(StateWriter& writer) const
+	{
+		writer.write(enabled_);
+		writer.write(dacEnabled_);
+	}
+
+	void Channel::loadState(StateReader& reader)
+	{
+		reader.read(enabled_);
+		reader.read(dacEnabled_);
+	}
 }
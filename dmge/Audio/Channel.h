@@ -2,6 +2,9 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	class Channel
 	{
 	public:
@@ -13,6 +16,11 @@ namespace dmge
 
 		void setDACEnable(bool enable);
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		// Enabled (NR52)
 		bool enabled_ = false;
@@ -1,5 +1,6 @@
 ﻿#include "../stdafx.h"
 #include "FrameSequencer.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -10,7 +11,7 @@ namespace dmge
 		onLengthClock_ = false;
 		onExtraLengthClock_ = false;
 
-		if ((prevDiv_ & 0b10000) && (div & 0b10000) == 0)
+		if (isFallingEdge(div))
 		{
 			clock_++;
 
@@ -23,6 +24,11 @@ namespace dmge
 		prevDiv_ = div;
 	}
 
+	bool FrameSequencer::isFallingEdge(uint8 div) const
+	{
+		return (prevDiv_ & 0b10000) && (div & 0b10000) == 0;
+	}
+
 	bool FrameSequencer::onVolumeClock() const
 	{
 		return onVolumeClock_;
@@ -47,4 +53,24 @@ namespace dmge
 	{
 		clock_ = -1;
 	}
+
+	void FrameSequencer::saveState(StateWriter& writer) const
+	{
+		writer.write(clock_);
+		writer.write(prevDiv_);
+		writer.write(onVolumeClock_);
+		writer.write(onSweepClock_);
+		writer.write(onLengthClock_);
+		writer.write(onExtraLengthClock_);
+	}
+
+	void FrameSequencer::loadState(StateReader& reader)
+	{
+		reader.read(clock_);
+		reader.read(prevDiv_);
+		reader.read(onVolumeClock_);
+		reader.read(onSweepClock_);
+		reader.read(onLengthClock_);
+		reader.read(onExtraLengthClock_);
+	}
 }
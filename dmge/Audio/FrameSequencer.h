@@ -2,11 +2,17 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	class FrameSequencer
 	{
 	public:
 		void step(uint8 div);
 
+		// step(div) を呼んだ場合に DIV の立下りが発生するか
+		bool isFallingEdge(uint8 div) const;
+
 		bool onVolumeClock() const;
 
 		bool onSweepClock() const;
@@ -17,6 +23,11 @@ namespace dmge
 
 		void reset();
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		uint64 clock_ = 0;
 
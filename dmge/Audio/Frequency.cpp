@@ -12,4 +12,22 @@ namespace dmge
 	{
 		return ((higher & 0x7) << 8) | (originalFreq & 0xff);
 	}
+
+	int AdvanceFrequencyTimer(int& freqTimer, int cycles, int period)
+	{
+		// 0以下の場合は、次のクロックで周期を終える
+		const int remain = Max(freqTimer, 1);
+
+		if (cycles < remain)
+		{
+			freqTimer = remain - cycles;
+			return 0;
+		}
+
+		// 最初に周期を終えてから経過したクロック数
+		const int elapsed = cycles - remain;
+
+		freqTimer = period - elapsed % period;
+		return 1 + elapsed / period;
+	}
 }
@@ -5,4 +5,8 @@ namespace dmge
 	int FrequencyReplacedLower(int originalFreq, uint8 lower);
 
 	int FrequencyReplacedHigher(int originalFreq, uint8 higher);
+
+	// Frequency Timer を cycles クロック分まとめて進め、周期を終えた回数を返す
+	// 1クロックごとに減らし、0以下になったら period にリセットする場合と同じ結果になる
+	int AdvanceFrequencyTimer(int& freqTimer, int cycles, int period);
 }
@@ -1,6 +1,7 @@
 ﻿#include "../stdafx.h"
 #include "FrequencySweep.h"
 #include "Channel.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -66,4 +67,24 @@ namespace dmge
 		if (newFreq > 2047) channel_->setEnable(false);
 		return newFreq;
 	}
+
+	void FrequencySweep::saveState(StateWriter& writer) const
+	{
+		writer.write(period_);
+		writer.write(direction_);
+		writer.write(shift_);
+		writer.write(sweepTimer_);
+		writer.write(enabled_);
+		writer.write(shadowFreq_);
+	}
+
+	void FrequencySweep::loadState(StateReader& reader)
+	{
+		reader.read(period_);
+		reader.read(direction_);
+		reader.read(shift_);
+		reader.read(sweepTimer_);
+		reader.read(enabled_);
+		reader.read(shadowFreq_);
+	}
 }
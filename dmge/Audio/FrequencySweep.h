@@ -3,6 +3,8 @@
 namespace dmge
 {
 	class Channel;
+	class StateWriter;
+	class StateReader;
 
 	class FrequencySweep
 	{
@@ -17,6 +19,11 @@ namespace dmge
 
 		uint8 get() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Channel* channel_;
 
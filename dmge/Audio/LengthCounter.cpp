@@ -1,6 +1,7 @@
 ﻿#include "../stdafx.h"
 #include "LengthCounter.h"
 #include "Channel.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -65,4 +66,18 @@ namespace dmge
 	{
 		extraLengthClockCond_ = cond;
 	}
+
+	void LengthCounter::saveState(StateWriter& writer) const
+	{
+		writer.write(enabled_);
+		writer.write(lengthTimer_);
+		writer.write(extraLengthClockCond_);
+	}
+
+	void LengthCounter::loadState(StateReader& reader)
+	{
+		reader.read(enabled_);
+		reader.read(lengthTimer_);
+		reader.read(extraLengthClockCond_);
+	}
 }
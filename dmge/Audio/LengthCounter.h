@@ -3,6 +3,8 @@
 namespace dmge
 {
 	class Channel;
+	class StateWriter;
+	class StateReader;
 
 	class LengthCounter
 	{
@@ -21,6 +23,11 @@ namespace dmge
 
 		void setExtraLengthClockCond(bool cond);
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Channel* channel_;
 
@@ -1,9 +1,128 @@
 ﻿#include "../stdafx.h"
 #include "NoiseChannel.h"
+#include "Frequency.h"
 #include "../Address.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
+	namespace
+	{
+		// LFSR を1回進める
+		uint16 StepLFSR(uint16 lfsr, bool shortWidth)
+		{
+			const uint16 xorResult = (lfsr & 0b01) ^ ((lfsr & 0b10) >> 1);
+			lfsr = (lfsr >> 1) | (xorResult << 14);
+
+			if (shortWidth)
+			{
+				lfsr &= ~(1 << 6);
+				lfsr |= xorResult << 6;
+			}
+
+			return lfsr;
+		}
+
+		// Width ビットの LFSR の出力 (bit 0) の系列を1周期分求めたもの
+		// 各ビットは右にシフトしていくだけなので、系列の位置 pos からの連続した Width ビットが、その位置での LFSR の状態になる
+		template <int Width>
+		struct LFSRTable
+		{
+			// 周期
+			static constexpr int Period = (1 << Width) - 1;
+
+			// 出力の系列を 64 ビットずつ詰めたもの
+			// 周期の終わりをまたいで読み出せるよう、系列の先頭の 64 ビットを末尾に続けて格納する
+			std::array<uint64, (Period + 64 + 63) / 64> bits{};
+
+			// LFSR の状態から系列の位置への変換表（状態 0 は系列に含まれない）
+			std::array<uint16, 1 << Width> positions{};
+
+			LFSRTable()
+			{
+				uint16 state = Period;
+
+				for (int i = 0; i < Period + 64; ++i)
+				{
+					if (i < Period)
+					{
+						positions[state] = static_cast<uint16>(i);
+					}
+
+					bits[i / 64] |= static_cast<uint64>(state & 1) << (i % 64);
+
+					const uint16 xorResult = (state & 0b01) ^ ((state & 0b10) >> 1);
+					state = (state >> 1) | (xorResult << (Width - 1));
+				}
+			}
+
+			// 系列の位置 pos (0 <= pos < Period) から count ビット (count <= 32) を読み出す
+			uint16 read(int pos, int count) const
+			{
+				const int word = pos / 64;
+				const int bit = pos % 64;
+
+				uint64 value = bits[word] >> bit;
+
+				if (bit > 0)
+				{
+					value |= bits[word + 1] << (64 - bit);
+				}
+
+				return static_cast<uint16>(value & ((1ull << count) - 1));
+			}
+		};
+
+		// 15 ビットモードの LFSR を count 回進める
+		uint16 AdvanceLFSR15(uint16 lfsr, int count)
+		{
+			static const LFSRTable<15> Table{};
+
+			const uint16 state = lfsr & 0x7fff;
+
+			// 状態 0 からは変化しない
+			if (state == 0)
+			{
+				return 0;
+			}
+
+			return Table.read((Table.positions[state] + count) % Table.Period, 15);
+		}
+
+		// 7 ビットモードの LFSR を count 回進める
+		// 下位 7 ビット (bit 0～6) は 7 ビットの LFSR として進む
+		// 上位ビット (bit 7～14) は下位 7 ビットに影響せず、8 回以上進めると下位 7 ビットの過去の出力で埋まる
+		uint16 AdvanceLFSR7(uint16 lfsr, int count)
+		{
+			static const LFSRTable<7> Table{};
+
+			// 上位ビットに元の状態が残る間は1回ずつ進める
+			if (count < 8)
+			{
+				for (int i = 0; i < count; ++i)
+				{
+					lfsr = StepLFSR(lfsr, true);
+				}
+
+				return lfsr;
+			}
+
+			const uint16 state = lfsr & 0x7f;
+
+			// 状態 0 からは変化しない（上位ビットも 0 で埋まる）
+			if (state == 0)
+			{
+				return 0;
+			}
+
+			// bit 0～6 は位置 pos から、bit 7～14 はその1つ前の位置からの系列になる
+			const int pos = (Table.positions[state] + count) % Table.Period;
+			const int previousPos = (pos + Table.Period - 1) % Table.Period;
+
+			return Table.read(pos, 7) | (Table.read(previousPos, 8) << 7);
+		}
+	}
+
 	uint8 NoiseChannel::readRegister(uint16 addr) const
 	{
 		if (addr == Address::NR42)
@@ -22,20 +141,22 @@ namespace dmge
 		return 0;
 	}
 
-	void NoiseChannel::step()
+	void NoiseChannel::step(int cycles)
 	{
-		if (--freqTimer_ <= 0)
-		{
-			freqTimer_ = (divisor_ > 0 ? (divisor_ * 16) : 8) << divisorShift_;
+		const int count = AdvanceFrequencyTimer(freqTimer_, cycles, (divisor_ > 0 ? (divisor_ * 16) : 8) << divisorShift_);
 
-			uint16 xorResult = (lfsr_ & 0b01) ^ ((lfsr_ & 0b10) >> 1);
-			lfsr_ = (lfsr_ >> 1) | (xorResult << 14);
-			if (counterWidth_ == 1)
-			{
-				lfsr_ &= ~(1 << 6);
-				lfsr_ |= xorResult << 6;
-			}
+		if (count == 0)
+		{
+			return;
 		}
+
+		// 前計算した系列の位置を進めて、count 回分の LFSR の状態を求める
+		lfsr_ = (counterWidth_ == 1) ? AdvanceLFSR7(lfsr_, count) : AdvanceLFSR15(lfsr_, count);
+	}
+
+	int NoiseChannel::clocksToNextEdge() const
+	{
+		return Max(freqTimer_, 1);
 	}
 
 	void NoiseChannel::trigger()
@@ -47,7 +168,8 @@ namespace dmge
 
 		length_.trigger(64);
 
-		lfsr_ = 0xffff;
+		// 15 ビットすべてを 1 にする
+		lfsr_ = 0x7fff;
 	}
 
 	int NoiseChannel::amplitude() const
@@ -93,4 +215,28 @@ namespace dmge
 		counterWidth_ = (NRx3 >> 3) & 1;
 		divisor_ = NRx3 & 0b111;
 	}
+
+	void NoiseChannel::saveState(StateWriter& writer) const
+	{
+		Channel::saveState(writer);
+		envelope_.saveState(writer);
+		length_.saveState(writer);
+		writer.write(freqTimer_);
+		writer.write(divisorShift_);
+		writer.write(counterWidth_);
+		writer.write(divisor_);
+		writer.write(lfsr_);
+	}
+
+	void NoiseChannel::loadState(StateReader& reader)
+	{
+		Channel::loadState(reader);
+		envelope_.loadState(reader);
+		length_.loadState(reader);
+		reader.read(freqTimer_);
+		reader.read(divisorShift_);
+		reader.read(counterWidth_);
+		reader.read(divisor_);
+		reader.read(lfsr_);
+	}
 }
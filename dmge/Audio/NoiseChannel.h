@@ -6,13 +6,19 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	class NoiseChannel : public Channel
 	{
 	public:
 		uint8 readRegister(uint16 addr) const;
 
-		// Frequency Timer を進める
-		void step();
+		// Frequency Timer を cycles クロック分進める
+		void step(int cycles);
+
+		// 次に出力が変化しうるまでのクロック数
+		int clocksToNextEdge() const;
 
 		void trigger();
 
@@ -38,6 +44,11 @@ namespace dmge
 
 		void setRandomness(uint8 NRx3);
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		VolumeEnvelope envelope_{};
 
@@ -3,22 +3,10 @@
 #include "SquareWave.h"
 #include "Frequency.h"
 #include "../Address.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
-	namespace
-	{
-		int LimitFrequency(int freq, int samplingFreq = 44100)
-		{
-			if (131072.0 / (2048 - freq) > samplingFreq / 2)
-			{
-				return 2048 - 131072.0 / (samplingFreq / 2);
-			}
-
-			return freq;
-		}
-	}
-
 	uint8 SquareChannel::readRegister(uint16 addr) const
 	{
 		if (addr == Address::NR10)
@@ -41,15 +29,34 @@ namespace dmge
 		return 0;
 	}
 
-	void SquareChannel::step()
+	void SquareChannel::step(int cycles)
+	{
+		const int count = AdvanceFrequencyTimer(freqTimer_, cycles, (2048 - freq_) * 4);
+
+		dutyPos_ = (dutyPos_ + count) % 8;
+	}
+
+	int SquareChannel::clocksToNextEdge() const
 	{
-		if (--freqTimer_ <= 0)
+		// 周波数が高い場合でも出力は帯域制限して合成するので、そのまま出力する
+		// Frequency Timer のクロックのうち、デューティ比の波形で出力が変化する位置まで進める
+
+		const int period = (2048 - freq_) * 4;
+		const int current = SquareWaveAmplitude(duty_, dutyPos_);
+
+		int clocks = Max(freqTimer_, 1);
+
+		for (int i = 1; i < 8; ++i)
 		{
-			// Frequency Timerをリセット
-			freqTimer_ = (2048 - freq_) * 4;
+			if (SquareWaveAmplitude(duty_, (dutyPos_ + i) % 8) != current)
+			{
+				break;
+			}
 
-			dutyPos_ = (dutyPos_ + 1) % 8;
+			clocks += period;
 		}
+
+		return clocks;
 	}
 
 	void SquareChannel::trigger()
@@ -69,8 +76,6 @@ namespace dmge
 
 	int SquareChannel::amplitude() const
 	{
-		if (LimitFrequency(freq_) != freq_) return 0;
-
 		return SquareWaveAmplitude(duty_, dutyPos_) * envelope_.volume();
 	}
 
@@ -138,4 +143,28 @@ namespace dmge
 	{
 		return freq_;
 	}
+
+	void SquareChannel::saveState(StateWriter& writer) const
+	{
+		Channel::saveState(writer);
+		envelope_.saveState(writer);
+		sweep_.saveState(writer);
+		length_.saveState(writer);
+		writer.write(freqTimer_);
+		writer.write(duty_);
+		writer.write(dutyPos_);
+		writer.write(freq_);
+	}
+
+	void SquareChannel::loadState(StateReader& reader)
+	{
+		Channel::loadState(reader);
+		envelope_.loadState(reader);
+		sweep_.loadState(reader);
+		length_.loadState(reader);
+		reader.read(freqTimer_);
+		reader.read(duty_);
+		reader.read(dutyPos_);
+		reader.read(freq_);
+	}
 }
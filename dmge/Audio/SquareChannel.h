@@ -7,13 +7,19 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	class SquareChannel : public Channel
 	{
 	public:
 		uint8 readRegister(uint16 addr) const;
 
-		// Frequency Timer を進める
-		void step();
+		// Frequency Timer を cycles クロック分進める
+		void step(int cycles);
+
+		// 次に出力が変化しうるまでのクロック数
+		int clocksToNextEdge() const;
 
 		void trigger();
 
@@ -55,6 +61,11 @@ namespace dmge
 
 		int getFrequency() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		VolumeEnvelope envelope_{};
 
@@ -1,5 +1,6 @@
 ﻿#include "../stdafx.h"
 #include "VolumeEnvelope.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -65,4 +66,24 @@ namespace dmge
 	{
 		return initialVolume_;
 	}
+
+	void VolumeEnvelope::saveState(StateWriter& writer) const
+	{
+		writer.write(initialVolume_);
+		writer.write(direction_);
+		writer.write(period_);
+		writer.write(currentVolume_);
+		writer.write(periodTimer_);
+		writer.write(finished_);
+	}
+
+	void VolumeEnvelope::loadState(StateReader& reader)
+	{
+		reader.read(initialVolume_);
+		reader.read(direction_);
+		reader.read(period_);
+		reader.read(currentVolume_);
+		reader.read(periodTimer_);
+		reader.read(finished_);
+	}
 }
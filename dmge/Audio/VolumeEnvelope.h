@@ -2,6 +2,9 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	class VolumeEnvelope
 	{
 	public:
@@ -17,6 +20,11 @@ namespace dmge
 
 		int initialVolume() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		int initialVolume_ = 0;
 		int direction_ = 0;
@@ -2,6 +2,7 @@
 #include "WaveChannel.h"
 #include "Frequency.h"
 #include "../Memory.h"
+#include "../SaveState.h"
 
 namespace dmge
 {
@@ -37,13 +38,16 @@ namespace dmge
 		return waveData_[addr - Address::WaveRAM];
 	}
 
-	void WaveChannel::step()
+	void WaveChannel::step(int cycles)
 	{
-		if (--freqTimer_ <= 0)
-		{
-			freqTimer_ = (2048 - freq_) * 2;
-			waveRAMOffset_ = (waveRAMOffset_ + 1) % 32;
-		}
+		const int count = AdvanceFrequencyTimer(freqTimer_, cycles, (2048 - freq_) * 2);
+
+		waveRAMOffset_ = (waveRAMOffset_ + count) % 32;
+	}
+
+	int WaveChannel::clocksToNextEdge() const
+	{
+		return Max(freqTimer_, 1);
 	}
 
 	void WaveChannel::trigger()
@@ -108,4 +112,26 @@ namespace dmge
 	{
 		waveRAMOffset_ = 1;
 	}
+
+	void WaveChannel::saveState(StateWriter& writer) const
+	{
+		Channel::saveState(writer);
+		length_.saveState(writer);
+		writer.write(freqTimer_);
+		writer.write(freq_);
+		writer.write(waveRAMOffset_);
+		writer.write(waveOutputLevel_);
+		writer.write(waveData_);
+	}
+
+	void WaveChannel::loadState(StateReader& reader)
+	{
+		Channel::loadState(reader);
+		length_.loadState(reader);
+		reader.read(freqTimer_);
+		reader.read(freq_);
+		reader.read(waveRAMOffset_);
+		reader.read(waveOutputLevel_);
+		reader.read(waveData_);
+	}
 }
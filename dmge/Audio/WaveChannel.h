@@ -6,6 +6,8 @@
 namespace dmge
 {
 	class Memory;
+	class StateWriter;
+	class StateReader;
 
 	class WaveChannel : public Channel
 	{
@@ -16,8 +18,11 @@ namespace dmge
 
 		uint8 readWaveData(uint16 addr) const;
 
-		// Frequency Timer を進める
-		void step();
+		// Frequency Timer を cycles クロック分進める
+		void step(int cycles);
+
+		// 次に出力が変化しうるまでのクロック数
+		int clocksToNextEdge() const;
 
 		void trigger();
 
@@ -47,6 +52,11 @@ namespace dmge
 
 		void resetWaveRAMOffset();
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		LengthCounter length_{ this };
 
@@ -2,6 +2,7 @@
 #include "CPU.h"
 #include "Memory.h"
 #include "Interrupt.h"
+#include "SaveState.h"
 #include "DebugPrint.h"
 
 namespace dmge
@@ -17,6 +18,19 @@ namespace dmge
 		void (CPU_detail::* inst)(const Instruction&);
 	};
 
+	// デコード済みの命令
+	struct DecodedInstruction
+	{
+		// nullptr の場合は未デコード
+		const Instruction* instruction = nullptr;
+
+		// 即値（d8, d16, a8, a16, r8）
+		uint16 operand = 0;
+	};
+
+	// 1ページ（256バイト）分のデコード済み命令
+	using DecodedPage = std::array<DecodedInstruction, 256>;
+
 
 	class CPU_detail
 	{
@@ -46,6 +60,9 @@ namespace dmge
 			hl(0x014d);
 			sp = 0xfffe;
 			pc = enableBootROM ? 0 : 0x100;
+
+			clearInstructionCache_();
+			resetIdleLoop_();
 		}
 
 		void run()
@@ -65,17 +82,26 @@ namespace dmge
 			// ※実行した結果、消費サイクルが書き変わる場合は consumedCycles_ が変更されている（ジャンプ命令でジャンプしなかった場合など）
 			// ※実行した結果、次のPCが書き変わる場合は pcNext_ が変更されているので PC に反映する（JPやCALLなど）
 
-			const auto& instruction = getInstruction_(pc);
+			const DecodedInstruction decoded = decode_(pc);
+			const auto& instruction = *decoded.instruction;
 
+			operand_ = decoded.operand;
 			pcNext_ = pc + instruction.bytes;
 			consumedCycles_ = instruction.cycles;
 
+			// アイドルループの本体に含めてよい命令か（実行前のレジスタで判定する）
+			const bool idleLoopSafe = isIdleLoopSafe_(instruction);
+
 			if (instruction.inst != nullptr)
 			{
 				(this->*(instruction.inst))(instruction);
 			}
 
+			const uint16 pcPrev = pc;
+
 			pc = pcNext_;
+
+			updateIdleLoop_(pcPrev, instruction, idleLoopSafe);
 		}
 
 		// 割り込み要求をチェックし、必要ならハンドラに制御を移す／HALTを解除する
@@ -117,6 +143,8 @@ namespace dmge
 					mem_->write(--sp, pc & 0xff);
 					pc = intAddr[i];
 
+					resetIdleLoop_();
+
 					// 低電力モードから抜ける
 					powerSavingMode_ = false;
 
@@ -150,6 +178,47 @@ namespace dmge
 			));
 		}
 
+		void saveState(StateWriter& writer) const
+		{
+			writer.write(af());
+			writer.write(bc());
+			writer.write(de());
+			writer.write(hl());
+			writer.write(sp);
+			writer.write(pc);
+			writer.write(pcNext_);
+			writer.write(consumedCycles_);
+			writer.write(consumedCyclesForInterrupt_);
+			writer.write(powerSavingMode_);
+			writer.write(cgbMode_);
+			writer.write(sgbMode_);
+			writer.write(mooneyeTestResult_);
+		}
+
+		void loadState(StateReader& reader)
+		{
+			std::array<uint16, 4> r16{};
+			reader.read(r16);
+			af(r16[0]);
+			bc(r16[1]);
+			de(r16[2]);
+			hl(r16[3]);
+
+			reader.read(sp);
+			reader.read(pc);
+			reader.read(pcNext_);
+			reader.read(consumedCycles_);
+			reader.read(consumedCyclesForInterrupt_);
+			reader.read(powerSavingMode_);
+			reader.read(cgbMode_);
+			reader.read(sgbMode_);
+			reader.read(mooneyeTestResult_);
+
+			// ROM の内容（バンク）が変わっている可能性があるので、デコード済み命令とアイドルループの検出状態は破棄する
+			clearInstructionCache_();
+			resetIdleLoop_();
+		}
+
 	private:
 		Memory* mem_;
 
@@ -268,6 +337,86 @@ namespace dmge
 			f = (f & (~(1 << 4))) | ((int)value << 4);
 		}
 
+		// オペコード中のレジスタ番号
+		// 8ビット: 0=B, 1=C, 2=D, 3=E, 4=H, 5=L, 6=(HL), 7=A
+		// 16ビット: 0=BC, 1=DE, 2=HL, 3=SP
+
+		// 8ビットレジスタ（(HL) を除く）
+		template <uint8 Index>
+		uint8& r8_()
+		{
+			static_assert(Index < 8 && Index != 6);
+
+			if constexpr (Index == 0) return b;
+			else if constexpr (Index == 1) return c;
+			else if constexpr (Index == 2) return d;
+			else if constexpr (Index == 3) return e;
+			else if constexpr (Index == 4) return h;
+			else if constexpr (Index == 5) return l;
+			else return a;
+		}
+
+		// 8ビットレジスタまたは (HL) を読む
+		template <uint8 Index>
+		uint8 readR8_()
+		{
+			if constexpr (Index == 6) return mem_->read(hl());
+			else return r8_<Index>();
+		}
+
+		// 8ビットレジスタまたは (HL) に書き込む
+		template <uint8 Index>
+		void writeR8_(uint8 value)
+		{
+			if constexpr (Index == 6) mem_->write(hl(), value);
+			else r8_<Index>() = value;
+		}
+
+		// 16ビットレジスタ
+		template <uint8 Index>
+		uint16 r16_() const
+		{
+			static_assert(Index < 4);
+
+			if constexpr (Index == 0) return bc();
+			else if constexpr (Index == 1) return de();
+			else if constexpr (Index == 2) return hl();
+			else return sp;
+		}
+
+		// 16ビットレジスタを設定
+		template <uint8 Index>
+		void r16_(uint16 value)
+		{
+			static_assert(Index < 4);
+
+			if constexpr (Index == 0) bc(value);
+			else if constexpr (Index == 1) de(value);
+			else if constexpr (Index == 2) hl(value);
+			else sp = value;
+		}
+
+		// 8ビット算術・論理演算命令のオペランド
+		// 0x80-0xbf はレジスタまたは (HL)、0xc6-0xfe は即値
+		template <uint8 Opcode>
+		uint8 aluOperand_()
+		{
+			if constexpr (Opcode >= 0xc0) return imm8_();
+			else return readR8_<Opcode & 7>();
+		}
+
+		// 分岐命令の条件 (NZ, Z, NC, C) を満たすか
+		// 条件なしの命令 (Unconditional) の場合は常に true
+		template <uint8 Opcode, uint8 Unconditional>
+		bool condition_() const
+		{
+			if constexpr (Opcode == Unconditional) return true;
+			else if constexpr (((Opcode >> 3) & 3) == 0) return not f_z();
+			else if constexpr (((Opcode >> 3) & 3) == 1) return f_z();
+			else if constexpr (((Opcode >> 3) & 3) == 2) return not f_c();
+			else return f_c();
+		}
+
 		// レジスタ (SP, PC)
 
 		uint16 sp = 0;  // レジスタSP
@@ -276,6 +425,18 @@ namespace dmge
 		// 次に実行する命令のあるアドレス
 		uint16 pcNext_ = 0;
 
+		// 実行中の命令の即値
+		uint16 operand_ = 0;
+
+		// デコード済み命令キャッシュ
+		// ROM のページの内容（Memory::romPage() のポインタ）ごとにデコード結果を保持する
+		// キーが ROM のデータそのものなので、バンク切り替えで無効化する必要はない
+		std::unordered_map<const uint8*, std::unique_ptr<DecodedPage>> decodedPages_;
+
+		// アドレスの上位8ビットごとの、直前に参照したキャッシュのページ
+		std::array<const uint8*, 256> currentPageKeys_{};
+		std::array<DecodedPage*, 256> currentPages_{};
+
 		// 実際に消費したサイクル数
 		int consumedCycles_ = 0;
 		int consumedCyclesForInterrupt_ = 0;
@@ -291,45 +452,52 @@ namespace dmge
 
 		MooneyeTestResult mooneyeTestResult_ = MooneyeTestResult::Running;
 
+		// アイドルループの検出
+		// 短い後方分岐で繰り返すループのうち、本体が isIdleLoopSafe_() な命令だけからなり、
+		// 1回の繰り返しの前後でレジスタが変化しないものを検出する
+
+		// 後方分岐とみなすループの長さ（バイト数）の上限
+		static constexpr int MaxIdleLoopBytes = 16;
+
+		// 直前の後方分岐の分岐先（ループの先頭）
+		uint16 idleLoopStart_ = 0;
+
+		// 直前の後方分岐からのサイクル数・命令数
+		int idleLoopCycles_ = 0;
+		int idleLoopInstructions_ = 0;
+
+		// 直前の後方分岐から、isIdleLoopSafe_() な命令だけを実行したか
+		bool idleLoopSafe_ = false;
+
+		// 直前の後方分岐の時点のレジスタ (A, F, B, C, D, E, H, L) と IME
+		uint64 idleLoopRegisters_ = 0;
+		bool idleLoopIME_ = false;
+
+		// 直前の命令でアイドルループを検出した場合、ループ1回分のサイクル数・命令数（検出していなければ 0）
+		int detectedIdleLoopCycles_ = 0;
+		int detectedIdleLoopInstructions_ = 0;
+
 
 		// 命令セット
 		
 		// Loads
 		// (LD, LDI, LDD, LDH, PUSH, POP)
 
-		void ld_r_n_(const Instruction& inst)
+		template <uint8 Opcode>
+		void ld_r_n_(const Instruction&)
 		{
-			const uint8 n = mem_->read(pc + 1);
-
-			switch (inst.opcode)
-			{
-			case 0x06: b = n; return;
-			case 0x0e: c = n; return;
-			case 0x16: d = n; return;
-			case 0x1e: e = n; return;
-			case 0x26: h = n; return;
-			case 0x2e: l = n; return;
-			default: return;
-			}
+			// opcode: 0x06, 0x0e, 0x16, 0x1e, 0x26, 0x2e, 0x36
+			writeR8_<(Opcode >> 3) & 7>(imm8_());
 		}
 
-		void ld_r_r_(const Instruction& inst)
+		template <uint8 Opcode>
+		void ld_r_r_(const Instruction&)
 		{
-			switch (inst.opcode)
+			// opcode: 0x40-0x75, 0x36
+
+			// LD B,B は mooneye-test-suite のテスト終了
+			if constexpr (Opcode == 0x40)
 			{
-			// A
-			//case 0x7f: return;
-			//case 0x78: return;
-			//case 0x79: return;
-			//case 0x7a: return;
-			//case 0x7b: return;
-			//case 0x7c: return;
-			//case 0x7d: return;
-			//case 0x7e: return;
-
-			// B
-			case 0x40:
-				b = b;
 				if (b == 3 &&
 					c == 5 &&
 					d == 8 &&
@@ -343,114 +511,35 @@ namespace dmge
 				{
 					mooneyeTestResult_ = MooneyeTestResult::Failed;
 				}
-				return;
-
-			case 0x41: b = c; return;
-			case 0x42: b = d; return;
-			case 0x43: b = e; return;
-			case 0x44: b = h; return;
-			case 0x45: b = l; return;
-			case 0x46: b = mem_->read(hl()); return;
-
-			// C
-			case 0x48: c = b; return;
-			case 0x49: c = c; return;
-			case 0x4a: c = d; return;
-			case 0x4b: c = e; return;
-			case 0x4c: c = h; return;
-			case 0x4d: c = l; return;
-			case 0x4e: c = mem_->read(hl()); return;
-
-			// D
-			case 0x50: d = b; return;
-			case 0x51: d = c; return;
-			case 0x52: d = d; return;
-			case 0x53: d = e; return;
-			case 0x54: d = h; return;
-			case 0x55: d = l; return;
-			case 0x56: d = mem_->read(hl()); return;
-
-			// E
-			case 0x58: e = b; return;
-			case 0x59: e = c; return;
-			case 0x5a: e = d; return;
-			case 0x5b: e = e; return;
-			case 0x5c: e = h; return;
-			case 0x5d: e = l; return;
-			case 0x5e: e = mem_->read(hl()); return;
-
-			//H
-			case 0x60: h = b; return;
-			case 0x61: h = c; return;
-			case 0x62: h = d; return;
-			case 0x63: h = e; return;
-			case 0x64: h = h; return;
-			case 0x65: h = l; return;
-			case 0x66: h = mem_->read(hl()); return;
-
-			// L
-			case 0x68: l = b; return;
-			case 0x69: l = c; return;
-			case 0x6a: l = d; return;
-			case 0x6b: l = e; return;
-			case 0x6c: l = h; return;
-			case 0x6d: l = l; return;
-			case 0x6e: l = mem_->read(hl()); return;
-
-			// (HL)
-			case 0x70: mem_->write(hl(), b); return;
-			case 0x71: mem_->write(hl(), c); return;
-			case 0x72: mem_->write(hl(), d); return;
-			case 0x73: mem_->write(hl(), e); return;
-			case 0x74: mem_->write(hl(), h); return;
-			case 0x75: mem_->write(hl(), l); return;
-			case 0x36: mem_->write(hl(), mem_->read(pc + 1)); return;
-
-			default: return;
 			}
-		}
-
-		void ld_a_n_(const Instruction& inst)
-		{
-			uint8 n = 0;
 
-			switch (inst.opcode)
+			if constexpr (Opcode == 0x36)
+			{
+				writeR8_<6>(imm8_());
+			}
+			else
 			{
-			case 0x7f: return;
-			case 0x78: n = b; break;
-			case 0x79: n = c; break;
-			case 0x7a: n = d; break;
-			case 0x7b: n = e; break;
-			case 0x7c: n = h; break;
-			case 0x7d: n = l; break;
-			case 0x0a: n = mem_->read(bc()); break;
-			case 0x1a: n = mem_->read(de()); break;
-			case 0x7e: n = mem_->read(hl()); break;
-			case 0xfa: n = mem_->read(mem_->read16(pc + 1)); break;
-			case 0x3e: n = mem_->read(pc + 1); break;
-			default: return;
+				writeR8_<(Opcode >> 3) & 7>(readR8_<Opcode & 7>());
 			}
+		}
 
-			a = n;
+		template <uint8 Opcode>
+		void ld_a_n_(const Instruction&)
+		{
+			if constexpr (Opcode == 0x0a) a = mem_->read(bc());
+			else if constexpr (Opcode == 0x1a) a = mem_->read(de());
+			else if constexpr (Opcode == 0xfa) a = mem_->read(imm16_());
+			else if constexpr (Opcode == 0x3e) a = imm8_();
+			else a = readR8_<Opcode & 7>();
 		}
 
-		void ld_n_a_(const Instruction& inst)
+		template <uint8 Opcode>
+		void ld_n_a_(const Instruction&)
 		{
-			switch (inst.opcode)
-			{
-			case 0x7f: a = a; return;
-			case 0x47: b = a; return;
-			case 0x4f: c = a; return;
-			case 0x57: d = a; return;
-			case 0x5f: e = a; return;
-			case 0x67: h = a; return;
-			case 0x6f: l = a; return;
-			case 0x02: mem_->write(bc(), a); return;
-			case 0x12: mem_->write(de(), a); return;
-			case 0x77: mem_->write(hl(), a); return;
-			case 0xea: mem_->write(mem_->read16(pc + 1), a); return;
-			default: return;
-			}
+			if constexpr (Opcode == 0x02) mem_->write(bc(), a);
+			else if constexpr (Opcode == 0x12) mem_->write(de(), a);
+			else if constexpr (Opcode == 0xea) mem_->write(imm16_(), a);
+			else writeR8_<(Opcode >> 3) & 7>(a);
 		}
 
 		void ld_a_c_(const Instruction&)
@@ -465,63 +554,47 @@ namespace dmge
 			mem_->write(0xff00 + c, a);
 		}
 
-		void ldd_a_hl_(const Instruction& inst)
+		void ldd_a_hl_(const Instruction&)
 		{
 			// opcode: 0x3a
 			a = mem_->read(hl());
-			dec16_(inst);
+			hl(hl() - 1);
 		}
 
-		void ldd_hl_a_(const Instruction& inst)
+		void ldd_hl_a_(const Instruction&)
 		{
 			// opcode: 0x32
 			mem_->write(hl(), a);
-			dec16_(inst);
+			hl(hl() - 1);
 		}
 
-		void ldi_a_hl_(const Instruction& inst)
+		void ldi_a_hl_(const Instruction&)
 		{
 			// opcode: 0x2a
 			a = mem_->read(hl());
-			inc16_(inst);
+			hl(hl() + 1);
 		}
 
-		void ldi_hl_a_(const Instruction& inst)
+		void ldi_hl_a_(const Instruction&)
 		{
 			// opcode: 0x22
 			mem_->write(hl(), a);
-			inc16_(inst);
+			hl(hl() + 1);
 		}
 
-		void ldh_(const Instruction& inst)
+		template <uint8 Opcode>
+		void ldh_(const Instruction&)
 		{
-			const uint8 n = mem_->read(pc + 1);
-
-			switch (inst.opcode)
-			{
-			case 0xe0:
-				mem_->write(0xff00 + n, a);
-				return;
-			case 0xf0:
-				a = mem_->read(0xff00 + n);
-				return;
-			default:
-				return;
-			}
+			// opcode: 0xe0, 0xf0
+			if constexpr (Opcode == 0xe0) mem_->write(0xff00 + imm8_(), a);
+			else a = mem_->read(0xff00 + imm8_());
 		}
 
-		void ld16_(const Instruction& inst)
+		template <uint8 Opcode>
+		void ld16_(const Instruction&)
 		{
-			const uint16 n = mem_->read16(pc + 1);
-
-			switch (inst.opcode)
-			{
-			case 0x01: bc(n); return;
-			case 0x11: de(n); return;
-			case 0x21: hl(n); return;
-			case 0x31: sp = n; return;
-			default: return;
-			}
+			// opcode: 0x01, 0x11, 0x21, 0x31
+			r16_<(Opcode >> 4) & 3>(imm16_());
 		}
 
 		void ld16_sp_hl_(const Instruction&)
@@ -534,7 +607,7 @@ namespace dmge
 		{
 			// opcode: 0xf8
 
-			const int8 n = mem_->read(pc + 1);
+			const int8 n = imm8_();
 
 			hl(sp + n);  //※符号付演算
 
@@ -547,83 +620,38 @@ namespace dmge
 		void ld16_n_sp_(const Instruction&)
 		{
 			// opcode: 0x08
-			const uint16 addr = mem_->read16(pc + 1);
+			const uint16 addr = imm16_();
 			mem_->write(addr, sp & 0xff);
 			mem_->write(addr + 1, (sp >> 8) & 0xff);
 		}
 
-		void push_(const Instruction& inst)
+		template <uint8 Opcode>
+		void push_(const Instruction&)
 		{
-			switch (inst.opcode)
-			{
-			case 0xf5:
-				mem_->write(--sp, a);
-				mem_->write(--sp, f);
-				return;
-
-			case 0xc5:
-				mem_->write(--sp, b);
-				mem_->write(--sp, c);
-				return;
-
-			case 0xd5:
-				mem_->write(--sp, d);
-				mem_->write(--sp, e);
-				return;
-
-			case 0xe5:
-				mem_->write(--sp, h);
-				mem_->write(--sp, l);
-				return;
-
-			default: return;
-			}
+			// opcode: 0xc5, 0xd5, 0xe5, 0xf5
+			const uint16 value = (Opcode == 0xf5) ? af() : r16_<(Opcode >> 4) & 3>();
+			mem_->write(--sp, value >> 8);
+			mem_->write(--sp, value & 0xff);
 		}
 
-		void pop_(const Instruction& inst)
+		template <uint8 Opcode>
+		void pop_(const Instruction&)
 		{
-			switch (inst.opcode)
-			{
-			case 0xf1:
-				af(mem_->read16(sp++) & 0xfff0);
-				break;
-
-			case 0xc1:
-				bc(mem_->read16(sp++));
-				break;
-
-			case 0xd1:
-				de(mem_->read16(sp++));
-				break;
-
-			case 0xe1:
-				hl(mem_->read16(sp++));
-				break;
-			}
+			// opcode: 0xc1, 0xd1, 0xe1, 0xf1
+			const uint16 value = mem_->read16(sp);
+			sp += 2;
 
-			++sp;
+			if constexpr (Opcode == 0xf1) af(value & 0xfff0);
+			else r16_<(Opcode >> 4) & 3>(value);
 		}
 
 		// Arithmetic
 		// (ADD, ADC, SUB, SBC, AND, OR, XOR, CP, INC, DEC)
 
-		void add_a_(const Instruction& inst)
+		template <uint8 Opcode>
+		void add_a_(const Instruction&)
 		{
-			uint8 n;
-
-			switch (inst.opcode)
-			{
-			case 0x87: n = a; break;
-			case 0x80: n = b; break;
-			case 0x81: n = c; break;
-			case 0x82: n = d; break;
-			case 0x83: n = e; break;
-			case 0x84: n = h; break;
-			case 0x85: n = l; break;
-			case 0x86: n = mem_->read(hl()); break;
-			case 0xc6: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			f_n(false);
 			f_h((a & 0xf) + (n & 0xf) > 0xf);
@@ -632,23 +660,10 @@ namespace dmge
 			f_z(a == 0);
 		}
 
-		void adc_a_(const Instruction& inst)
+		template <uint8 Opcode>
+		void adc_a_(const Instruction&)
 		{
-			uint8 n;
-
-			switch (inst.opcode)
-			{
-			case 0x8f: n = a; break;
-			case 0x88: n = b; break;
-			case 0x89: n = c; break;
-			case 0x8a: n = d; break;
-			case 0x8b: n = e; break;
-			case 0x8c: n = h; break;
-			case 0x8d: n = l; break;
-			case 0x8e: n = mem_->read(hl()); break;
-			case 0xce: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			const uint8 carry = (uint8)f_c();
 
@@ -659,23 +674,10 @@ namespace dmge
 			f_z(a == 0);
 		}
 
-		void sub_a_(const Instruction& inst)
+		template <uint8 Opcode>
+		void sub_a_(const Instruction&)
 		{
-			uint8 n;
-
-			switch (inst.opcode)
-			{
-			case 0x97: n = a; break;
-			case 0x90: n = b; break;
-			case 0x91: n = c; break;
-			case 0x92: n = d; break;
-			case 0x93: n = e; break;
-			case 0x94: n = h; break;
-			case 0x95: n = l; break;
-			case 0x96: n = mem_->read(hl()); break;
-			case 0xd6: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			f_n(true);
 			f_h((a & 0xf) - (n & 0xf) < 0);
@@ -684,23 +686,10 @@ namespace dmge
 			f_z(a == 0);
 		}
 
-		void sbc_a_(const Instruction& inst)
+		template <uint8 Opcode>
+		void sbc_a_(const Instruction&)
 		{
-			uint8 n;
-
-			switch (inst.opcode)
-			{
-			case 0x9f: n = a; break;
-			case 0x98: n = b; break;
-			case 0x99: n = c; break;
-			case 0x9a: n = d; break;
-			case 0x9b: n = e; break;
-			case 0x9c: n = h; break;
-			case 0x9d: n = l; break;
-			case 0x9e: n = mem_->read(hl()); break;
-			case 0xde: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			const uint8 carry = (uint8)f_c();
 
@@ -711,23 +700,10 @@ namespace dmge
 			f_z(a == 0);
 		}
 
-		void and_(const Instruction& inst)
+		template <uint8 Opcode>
+		void and_(const Instruction&)
 		{
-			uint8 n = 0;
-
-			switch (inst.opcode)
-			{
-			case 0xa7: n = a; break;
-			case 0xa0: n = b; break;
-			case 0xa1: n = c; break;
-			case 0xa2: n = d; break;
-			case 0xa3: n = e; break;
-			case 0xa4: n = h; break;
-			case 0xa5: n = l; break;
-			case 0xa6: n = mem_->read(hl()); break;
-			case 0xe6: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			a &= n;
 
@@ -737,23 +713,10 @@ namespace dmge
 			f_c(false);
 		}
 
-		void or_(const Instruction& inst)
+		template <uint8 Opcode>
+		void or_(const Instruction&)
 		{
-			uint8 n = 0;
-
-			switch (inst.opcode)
-			{
-			case 0xb7: n = a; break;
-			case 0xb0: n = b; break;
-			case 0xb1: n = c; break;
-			case 0xb2: n = d; break;
-			case 0xb3: n = e; break;
-			case 0xb4: n = h; break;
-			case 0xb5: n = l; break;
-			case 0xb6: n = mem_->read(hl()); break;
-			case 0xf6: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			a |= n;
 
@@ -763,23 +726,10 @@ namespace dmge
 			f_c(false);
 		}
 
-		void xor_(const Instruction& inst)
+		template <uint8 Opcode>
+		void xor_(const Instruction&)
 		{
-			uint8 n = 0;
-
-			switch (inst.opcode)
-			{
-			case 0xaf: n = a; break;
-			case 0xa8: n = b; break;
-			case 0xa9: n = c; break;
-			case 0xaa: n = d; break;
-			case 0xab: n = e; break;
-			case 0xac: n = h; break;
-			case 0xad: n = l; break;
-			case 0xae: n = mem_->read(hl()); break;
-			case 0xee: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			a ^= n;
 
@@ -789,23 +739,10 @@ namespace dmge
 			f_c(false);
 		}
 
-		void cp_(const Instruction& inst)
+		template <uint8 Opcode>
+		void cp_(const Instruction&)
 		{
-			uint8 n = 0;
-
-			switch (inst.opcode)
-			{
-			case 0xbf: n = a; break;
-			case 0xb8: n = b; break;
-			case 0xb9: n = c; break;
-			case 0xba: n = d; break;
-			case 0xbb: n = e; break;
-			case 0xbc: n = h; break;
-			case 0xbd: n = l; break;
-			case 0xbe: n = mem_->read(hl()); break;
-			case 0xfe: n = mem_->read(pc + 1); break;
-			default: return;
-			}
+			const uint8 n = aluOperand_<Opcode>();
 
 			f_z(a == n);
 			f_n(true);
@@ -813,28 +750,17 @@ namespace dmge
 			f_c(a < n);
 		}
 
-		void inc_(const Instruction& inst)
+		template <uint8 Opcode>
+		void inc_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x3c: p = &a; break;
-			case 0x04: p = &b; break;
-			case 0x0c: p = &c; break;
-			case 0x14: p = &d; break;
-			case 0x1c: p = &e; break;
-			case 0x24: p = &h; break;
-			case 0x2c: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<(Opcode >> 3) & 7>();
 
 			f_n(false);
-			f_h((*p & 0xf) == 0xf);
+			f_h((r & 0xf) == 0xf);
 
-			const uint8 result = *p + 1;
+			const uint8 result = r + 1;
 
-			*p = result;
+			r = result;
 			f_z(result == 0);
 		}
 
@@ -852,28 +778,17 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void dec_(const Instruction& inst)
+		template <uint8 Opcode>
+		void dec_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x3d: p = &a; break;
-			case 0x05: p = &b; break;
-			case 0x0d: p = &c; break;
-			case 0x15: p = &d; break;
-			case 0x1d: p = &e; break;
-			case 0x25: p = &h; break;
-			case 0x2d: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<(Opcode >> 3) & 7>();
 
 			f_n(true);
-			f_h((*p & 0xf) == 0);
+			f_h((r & 0xf) == 0);
 
-			const uint8 result = *p - 1;
+			const uint8 result = r - 1;
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -892,18 +807,11 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void add_hl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void add_hl_(const Instruction&)
 		{
-			uint16 n;
-
-			switch (inst.opcode)
-			{
-			case 0x09: n = bc(); break;
-			case 0x19: n = de(); break;
-			case 0x29: n = hl(); break;
-			case 0x39: n = sp; break;
-			default: return;
-			}
+			// opcode: 0x09, 0x19, 0x29, 0x39
+			const uint16 n = r16_<(Opcode >> 4) & 3>();
 
 			f_n(false);
 			f_h((hl() & 0x7ff) + (n & 0x7ff) > 0x7ff);
@@ -914,66 +822,38 @@ namespace dmge
 		void add_sp_(const Instruction&)
 		{
 			// opcode: 0xe8
-			const int8 n = mem_->read(pc + 1);
+			const int8 n = imm8_();
 			f = 0;
 			f_h((sp & 0xf) + (n & 0xf) > 0xf);
 			f_c((sp & 0xff) + (n & 0xff) > 0xff);
 			sp += n;
 		}
 
-		void inc16_(const Instruction& inst)
+		template <uint8 Opcode>
+		void inc16_(const Instruction&)
 		{
-			switch (inst.opcode)
-			{
-			case 0x03: bc(bc() + 1); return;
-			case 0x13: de(de() + 1); return;
-
-			case 0x22: //LDI (HL),A
-			case 0x2a: //LDI A,(HL)
-			case 0x23: hl(hl() + 1); return;
-
-			case 0x33: ++sp; return;
-			}
+			// opcode: 0x03, 0x13, 0x23, 0x33
+			r16_<(Opcode >> 4) & 3>(r16_<(Opcode >> 4) & 3>() + 1);
 		}
 
-		void dec16_(const Instruction& inst)
+		template <uint8 Opcode>
+		void dec16_(const Instruction&)
 		{
-			switch (inst.opcode)
-			{
-			case 0x0b: bc(bc() - 1); return;
-			case 0x1b: de(de() - 1); return;
-
-			case 0x32: // LDD (HL),A
-			case 0x3a: // LDD A,(HL)
-			case 0x2b: hl(hl() - 1); return;
-
-			case 0x3b: --sp; return;
-			default: return;
-			}
+			// opcode: 0x0b, 0x1b, 0x2b, 0x3b
+			r16_<(Opcode >> 4) & 3>(r16_<(Opcode >> 4) & 3>() - 1);
 		}
 
 		// Misc
 		// (SWAP, DAA, CPL, CCF, SCF, NOP, HALT, STOP, DI, EI)
 
-		void swap_(const Instruction& inst)
+		template <uint8 Opcode>
+		void swap_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x37: p = &a; break;
-			case 0x30: p = &b; break;
-			case 0x31: p = &c; break;
-			case 0x32: p = &d; break;
-			case 0x33: p = &e; break;
-			case 0x34: p = &h; break;
-			case 0x35: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
-			const uint8 result = (*p >> 4) | (*p << 4);
+			const uint8 result = (r >> 4) | (r << 4);
 
-			*p = result;
+			r = result;
 
 			f = 0;
 			f_z(result == 0);
@@ -1144,30 +1024,19 @@ namespace dmge
 			a = (a >> 1) | (carry << 7);
 		}
 
-		void rlc_(const Instruction& inst)
+		template <uint8 Opcode>
+		void rlc_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x07: p = &a; break;
-			case 0x00: p = &b; break;
-			case 0x01: p = &c; break;
-			case 0x02: p = &d; break;
-			case 0x03: p = &e; break;
-			case 0x04: p = &h; break;
-			case 0x05: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
-			const uint8 bit7 = *p >> 7;
+			const uint8 bit7 = r >> 7;
 			f = 0;
-			f_z(*p == 0);
+			f_z(r == 0);
 			f_c(bit7 == 1);
 
-			const uint8 result = (*p << 1) | bit7;
+			const uint8 result = (r << 1) | bit7;
 
-			*p = result;
+			r = result;
 		}
 
 		void rlc_hl_(const Instruction&)
@@ -1185,30 +1054,19 @@ namespace dmge
 			mem_->write(hl(), result);
 		}
 
-		void rl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void rl_(const Instruction&)
 		{
-			uint8* p;
+			uint8& r = r8_<Opcode & 7>();
 
-			switch (inst.opcode)
-			{
-			case 0x17: p = &a; break;
-			case 0x10: p = &b; break;
-			case 0x11: p = &c; break;
-			case 0x12: p = &d; break;
-			case 0x13: p = &e; break;
-			case 0x14: p = &h; break;
-			case 0x15: p = &l; break;
-			default: return;
-			}
-
-			const uint8 bit7 = *p >> 7;
+			const uint8 bit7 = r >> 7;
 			const uint8 carry = (uint8)f_c();
 			f = 0;
 			f_c(bit7 == 1);
 
-			const uint8 result = (*p << 1) | carry;
+			const uint8 result = (r << 1) | carry;
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -1230,31 +1088,20 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void rrc_(const Instruction& inst)
+		template <uint8 Opcode>
+		void rrc_(const Instruction&)
 		{
-			uint8* p;
+			uint8& r = r8_<Opcode & 7>();
 
-			switch (inst.opcode)
-			{
-			case 0x0f: p = &a; break;
-			case 0x08: p = &b; break;
-			case 0x09: p = &c; break;
-			case 0x0a: p = &d; break;
-			case 0x0b: p = &e; break;
-			case 0x0c: p = &h; break;
-			case 0x0d: p = &l; break;
-			default: return;
-			}
-
-			const uint8 bit0 = *p & 1;
+			const uint8 bit0 = r & 1;
 			f = 0;
 			f_c(bit0 == 1);
 
-			const uint8 result = (*p >> 1) | (bit0 << 7);
+			const uint8 result = (r >> 1) | (bit0 << 7);
 
-			*p = result;
+			r = result;
 
-			f_z(*p == 0);
+			f_z(r == 0);
 		}
 
 		void rrc_hl_(const Instruction&)
@@ -1273,30 +1120,19 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void rr_(const Instruction& inst)
+		template <uint8 Opcode>
+		void rr_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x1f: p = &a; break;
-			case 0x18: p = &b; break;
-			case 0x19: p = &c; break;
-			case 0x1a: p = &d; break;
-			case 0x1b: p = &e; break;
-			case 0x1c: p = &h; break;
-			case 0x1d: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
-			const uint8 bit0 = *p & 1;
+			const uint8 bit0 = r & 1;
 			const uint8 carry = (uint8)f_c();
 			f = 0;
 			f_c(bit0 == 1);
 
-			const uint8 result = (*p >> 1) | (carry << 7);
+			const uint8 result = (r >> 1) | (carry << 7);
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -1318,28 +1154,17 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void sla_(const Instruction& inst)
+		template <uint8 Opcode>
+		void sla_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x27: p = &a; break;
-			case 0x20: p = &b; break;
-			case 0x21: p = &c; break;
-			case 0x22: p = &d; break;
-			case 0x23: p = &e; break;
-			case 0x24: p = &h; break;
-			case 0x25: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
 			f = 0;
-			f_c(*p & (1 << 7));
+			f_c(r & (1 << 7));
 
-			const uint8 result = *p << 1;
+			const uint8 result = r << 1;
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -1359,28 +1184,17 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void sra_(const Instruction& inst)
+		template <uint8 Opcode>
+		void sra_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x2f: p = &a; break;
-			case 0x28: p = &b; break;
-			case 0x29: p = &c; break;
-			case 0x2a: p = &d; break;
-			case 0x2b: p = &e; break;
-			case 0x2c: p = &h; break;
-			case 0x2d: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
 			f = 0;
-			f_c(*p & 1);
+			f_c(r & 1);
 
-			const uint8 result = (*p >> 1) | (*p & (1 << 7));
+			const uint8 result = (r >> 1) | (r & (1 << 7));
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -1400,28 +1214,17 @@ namespace dmge
 			f_z(result == 0);
 		}
 
-		void srl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void srl_(const Instruction&)
 		{
-			uint8* p;
-
-			switch (inst.opcode)
-			{
-			case 0x3f: p = &a; break;
-			case 0x38: p = &b; break;
-			case 0x39: p = &c; break;
-			case 0x3a: p = &d; break;
-			case 0x3b: p = &e; break;
-			case 0x3c: p = &h; break;
-			case 0x3d: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
 			f = 0;
-			f_c(*p & 1);
+			f_c(r & 1);
 
-			const uint8 result = *p >> 1;
+			const uint8 result = r >> 1;
 
-			*p = result;
+			r = result;
 
 			f_z(result == 0);
 		}
@@ -1444,35 +1247,22 @@ namespace dmge
 		// Bit
 		// (BIT, SET)
 
-		void bit_(const Instruction& inst)
+		template <uint8 Opcode>
+		void bit_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0x40) / 8;
-
-			uint8* p;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
-			uint8 opl = inst.opcode & 0xf;
-			if (opl > 7) opl -= 8;
+			uint8& r = r8_<Opcode & 7>();
 
-			switch (opl)
-			{
-			case 0x7: p = &a; break;
-			case 0x0: p = &b; break;
-			case 0x1: p = &c; break;
-			case 0x2: p = &d; break;
-			case 0x3: p = &e; break;
-			case 0x4: p = &h; break;
-			case 0x5: p = &l; break;
-			default: return;
-			}
-
-			f_z((*p & (1 << bit)) == 0);
+			f_z((r & (1 << bit)) == 0);
 			f_n(false);
 			f_h(true);
 		}
 
-		void bit_hl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void bit_hl_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0x40) / 8;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
 			uint8 value = mem_->read(hl());
 
@@ -1481,35 +1271,22 @@ namespace dmge
 			f_h(true);
 		}
 
-		void set_(const Instruction& inst)
+		template <uint8 Opcode>
+		void set_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0xc0) / 8;
-
-			uint8* p;
-
-			uint8 opl = inst.opcode & 0xf;
-			if (opl > 7) opl -= 8;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
-			switch (opl)
-			{
-			case 0x7: p = &a; break;
-			case 0x0: p = &b; break;
-			case 0x1: p = &c; break;
-			case 0x2: p = &d; break;
-			case 0x3: p = &e; break;
-			case 0x4: p = &h; break;
-			case 0x5: p = &l; break;
-			default: return;
-			}
+			uint8& r = r8_<Opcode & 7>();
 
-			const uint8 result = *p | (1 << bit);
+			const uint8 result = r | (1 << bit);
 
-			*p = result;
+			r = result;
 		}
 
-		void set_hl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void set_hl_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0xc0) / 8;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
 			uint8 value = mem_->read(hl());
 
@@ -1518,35 +1295,22 @@ namespace dmge
 			mem_->write(hl(), result);
 		}
 
-		void res_(const Instruction& inst)
+		template <uint8 Opcode>
+		void res_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0x80) / 8;
-
-			uint8* p;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
-			uint8 opl = inst.opcode & 0xf;
-			if (opl > 7) opl -= 8;
+			uint8& r = r8_<Opcode & 7>();
 
-			switch (opl)
-			{
-			case 0x7: p = &a; break;
-			case 0x0: p = &b; break;
-			case 0x1: p = &c; break;
-			case 0x2: p = &d; break;
-			case 0x3: p = &e; break;
-			case 0x4: p = &h; break;
-			case 0x5: p = &l; break;
-			default: return;
-			}
+			const uint8 result = r & ~(1 << bit);
 
-			const uint8 result = *p & ~(1 << bit);
-
-			*p = result;
+			r = result;
 		}
 
-		void res_hl_(const Instruction& inst)
+		template <uint8 Opcode>
+		void res_hl_(const Instruction&)
 		{
-			const uint8 bit = (inst.opcode - 0x80) / 8;
+			constexpr uint8 bit = (Opcode >> 3) & 7;
 
 			uint8 value = mem_->read(hl());
 
@@ -1558,33 +1322,13 @@ namespace dmge
 		// Jumps
 		// (JP, JR)
 
+		template <uint8 Opcode>
 		void jp_(const Instruction& inst)
 		{
-			const uint16 dstAddr = mem_->read16(pc + 1);
-			bool toJump = false;
-
-			switch (inst.opcode)
-			{
-			case 0xc3:
-				toJump = true;
-				break;
-			case 0xc2:
-				if (not f_z()) toJump = true;
-				break;
-			case 0xca:
-				if (f_z()) toJump = true;
-				break;
-			case 0xd2:
-				if (not f_c()) toJump = true;
-				break;
-			case 0xda:
-				if (f_c()) toJump = true;
-				break;
-			}
-
-			if (toJump)
+			// opcode: 0xc3, 0xc2, 0xca, 0xd2, 0xda
+			if (condition_<Opcode, 0xc3>())
 			{
-				pcNext_ = dstAddr;
+				pcNext_ = imm16_();
 				return;
 			}
 
@@ -1597,33 +1341,13 @@ namespace dmge
 			pcNext_ = hl();
 		}
 
+		template <uint8 Opcode>
 		void jr_(const Instruction& inst)
 		{
-			const int8 n = mem_->read(pc + 1);
-			bool toJump = false;
-
-			switch (inst.opcode)
-			{
-			case 0x18:
-				toJump = true;
-				break;
-			case 0x20:
-				if (not f_z()) toJump = true;
-				break;
-			case 0x28:
-				if (f_z()) toJump = true;
-				break;
-			case 0x30:
-				if (not f_c()) toJump = true;
-				break;
-			case 0x38:
-				if (f_c()) toJump = true;
-				break;
-			}
-
-			if (toJump)
+			// opcode: 0x18, 0x20, 0x28, 0x30, 0x38
+			if (condition_<Opcode, 0x18>())
 			{
-				pcNext_ = pcNext_ + n;
+				pcNext_ = pcNext_ + static_cast<int8>(imm8_());
 				return;
 			}
 
@@ -1633,35 +1357,15 @@ namespace dmge
 		// Calls
 		// (CALL)
 
+		template <uint8 Opcode>
 		void call_(const Instruction& inst)
 		{
-			bool toCall = false;
-
-			switch (inst.opcode)
-			{
-			case 0xcd:
-				toCall = true;
-				break;
-			case 0xc4:
-				if (not f_z()) toCall = true;
-				break;
-			case 0xcc:
-				if (f_z()) toCall = true;
-				break;
-			case 0xd4:
-				if (not f_c()) toCall = true;
-				break;
-			case 0xdc:
-				if (f_c()) toCall = true;
-				break;
-			}
-
-			if (toCall)
+			// opcode: 0xcd, 0xc4, 0xcc, 0xd4, 0xdc
+			if (condition_<Opcode, 0xcd>())
 			{
-				const uint16 addr = mem_->read16(pc + 1);
 				mem_->write(--sp, (pc + 3) >> 8);
 				mem_->write(--sp, (pc + 3) & 0xff);
-				pcNext_ = addr;
+				pcNext_ = imm16_();
 				return;
 			}
 
@@ -1671,56 +1375,24 @@ namespace dmge
 		// Restarts
 		// (RST)
 
-		void rst_(const Instruction& inst)
+		template <uint8 Opcode>
+		void rst_(const Instruction&)
 		{
-			uint16 addr;
-
-			switch (inst.opcode)
-			{
-			case 0xc7: addr = 0x00; break;
-			case 0xcf: addr = 0x08; break;
-			case 0xd7: addr = 0x10; break;
-			case 0xdf: addr = 0x18; break;
-			case 0xe7: addr = 0x20; break;
-			case 0xef: addr = 0x28; break;
-			case 0xf7: addr = 0x30; break;
-			case 0xff: addr = 0x38; break;
-			default: return;
-			}
-
+			// opcode: 0xc7, 0xcf, 0xd7, 0xdf, 0xe7, 0xef, 0xf7, 0xff
 			mem_->write(--sp, (pc + 1) >> 8);
 			mem_->write(--sp, (pc + 1) & 0xff);
-			pcNext_ = addr;
+			pcNext_ = Opcode & 0x38;
 		}
 
 
 		// Returns
 		// (RET, RETI)
 
+		template <uint8 Opcode>
 		void ret_(const Instruction& inst)
 		{
-			bool toRet = false;
-
-			switch (inst.opcode)
-			{
-			case 0xc9:
-				toRet = true;
-				break;
-			case 0xc0:
-				if (not f_z()) toRet = true;
-				break;
-			case 0xc8:
-				if (f_z()) toRet = true;
-				break;
-			case 0xd0:
-				if (not f_c()) toRet = true;
-				break;
-			case 0xd8:
-				if (f_c()) toRet = true;
-				break;
-			}
-
-			if (toRet)
+			// opcode: 0xc9, 0xc0, 0xc8, 0xd0, 0xd8
+			if (condition_<Opcode, 0xc9>())
 			{
 				pcNext_ = mem_->read16(sp);
 				sp += 2;
@@ -1757,529 +1429,727 @@ namespace dmge
 			return cbprefixedInstructions[mem_->read(addr + 1)];
 		}
 
+		// 指定したアドレスにある命令と即値をメモリから読む
+		DecodedInstruction decodeFromMemory_(uint16 addr)
+		{
+			const Instruction& instruction = getInstruction_(addr);
+
+			switch (instruction.bytes)
+			{
+			case 2: return { &instruction, mem_->read(addr + 1) };
+			case 3: return { &instruction, mem_->read16(addr + 1) };
+			default: return { &instruction, 0 };
+			}
+		}
+
+		// 指定したアドレスにある命令をデコードする
+		// ROM 上の命令はキャッシュし、2回目以降はメモリを読まない
+		DecodedInstruction decode_(uint16 addr)
+		{
+			const uint8* page = mem_->romPage(addr);
+
+			if (page == nullptr)
+			{
+				return decodeFromMemory_(addr);
+			}
+
+			const uint8 pageIndex = addr >> 8;
+
+			if (currentPageKeys_[pageIndex] != page)
+			{
+				auto& decodedPage = decodedPages_[page];
+
+				if (not decodedPage)
+				{
+					decodedPage = std::make_unique<DecodedPage>();
+				}
+
+				currentPageKeys_[pageIndex] = page;
+				currentPages_[pageIndex] = decodedPage.get();
+			}
+
+			DecodedInstruction& cached = (*currentPages_[pageIndex])[addr & 0xff];
+
+			if (cached.instruction == nullptr)
+			{
+				const DecodedInstruction decoded = decodeFromMemory_(addr);
+
+				// 次のページにまたがる命令はキャッシュしない（次のページが別のバンクに切り替わりうる）
+				if ((addr & 0xff) + decoded.instruction->bytes > 0x100)
+				{
+					return decoded;
+				}
+
+				cached = decoded;
+			}
+
+			return cached;
+		}
+
+		void clearInstructionCache_()
+		{
+			decodedPages_.clear();
+			currentPageKeys_.fill(nullptr);
+			currentPages_.fill(nullptr);
+		}
+
+		// アイドルループ中に読んでも、ループを実行している間は値が変化しないアドレスか
+		// ROM・WRAM・HRAM はループ中に書き換わらない
+		// LY・STAT・IF はスケジューラのイベントの時刻にのみ変化する
+		static bool isIdleLoopReadable_(uint16 addr)
+		{
+			return addr <= Address::SwitchableROMBank_End ||
+				(addr >= Address::WRAM && addr <= Address::EchoRAM_End) ||
+				(addr >= Address::HRAM && addr <= Address::HRAM_End) ||
+				addr == Address::LY ||
+				addr == Address::STAT ||
+				addr == Address::IF;
+		}
+
+		// アイドルループの本体に含めてよい命令か
+		// メモリへの書き込み・スタック操作・IME の変更を行わず、isIdleLoopReadable_() なアドレスだけを読む命令
+		bool isIdleLoopSafe_(const Instruction& instruction) const
+		{
+			const uint8 op = instruction.opcode;
+
+			// CB prefixed: BIT のみ
+			if (&instruction >= cbprefixedInstructions.data() && &instruction < cbprefixedInstructions.data() + cbprefixedInstructions.size())
+			{
+				if (op < 0x40 || op > 0x7f) return false;
+
+				return (op & 7) != 6 || isIdleLoopReadable_(hl());
+			}
+
+			switch (op)
+			{
+			// NOP
+			case 0x00:
+				return true;
+
+			// LD r,d8
+			case 0x06: case 0x0e: case 0x16: case 0x1e: case 0x26: case 0x2e: case 0x3e:
+				return true;
+
+			// INC r, DEC r
+			case 0x04: case 0x0c: case 0x14: case 0x1c: case 0x24: case 0x2c: case 0x3c:
+			case 0x05: case 0x0d: case 0x15: case 0x1d: case 0x25: case 0x2d: case 0x3d:
+				return true;
+
+			// LD A,(BC), LD A,(DE), LDH A,(a8), LD A,(C), LD A,(a16)
+			case 0x0a: return isIdleLoopReadable_(bc());
+			case 0x1a: return isIdleLoopReadable_(de());
+			case 0xf0: return isIdleLoopReadable_(0xff00 + imm8_());
+			case 0xf2: return isIdleLoopReadable_(0xff00 + c);
+			case 0xfa: return isIdleLoopReadable_(imm16_());
+
+			// ADD, ADC, SUB, SBC, AND, XOR, OR, CP d8
+			case 0xc6: case 0xce: case 0xd6: case 0xde: case 0xe6: case 0xee: case 0xf6: case 0xfe:
+				return true;
+
+			// JR, JP
+			case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+			case 0xc3: case 0xc2: case 0xca: case 0xd2: case 0xda:
+				return true;
+
+			default:
+				break;
+			}
+
+			// LD r,r' (LD B,B はテスト終了の判定に使われるので除く、(HL) への書き込みと HALT も除く)
+			if (op >= 0x41 && op <= 0x7f)
+			{
+				if (op >= 0x70 && op <= 0x77) return false;
+
+				return (op & 7) != 6 || isIdleLoopReadable_(hl());
+			}
+
+			// ADD, ADC, SUB, SBC, AND, XOR, OR, CP r
+			if (op >= 0x80 && op <= 0xbf)
+			{
+				return (op & 7) != 6 || isIdleLoopReadable_(hl());
+			}
+
+			return false;
+		}
+
+		// 実行した命令をアイドルループの検出に反映する
+		void updateIdleLoop_(uint16 pcPrev, const Instruction& instruction, bool safe)
+		{
+			detectedIdleLoopCycles_ = 0;
+			detectedIdleLoopInstructions_ = 0;
+
+			idleLoopCycles_ += consumedCycles_;
+			++idleLoopInstructions_;
+			idleLoopSafe_ = idleLoopSafe_ && safe;
+
+			// 短い後方分岐をしたときだけ判定する
+			const bool jumped = pc != static_cast<uint16>(pcPrev + instruction.bytes);
+			if (not jumped || pc > pcPrev || pcPrev - pc >= MaxIdleLoopBytes)
+			{
+				return;
+			}
+
+			const uint64 registers = (static_cast<uint64>(af()) << 48) | (static_cast<uint64>(bc()) << 32) | (static_cast<uint64>(de()) << 16) | hl();
+			const bool ime = interrupt_->ime();
+
+			// 前回と同じ分岐先に、同じ状態で戻ってきた
+			if (idleLoopSafe_ && pc == idleLoopStart_ && registers == idleLoopRegisters_ && ime == idleLoopIME_)
+			{
+				detectedIdleLoopCycles_ = idleLoopCycles_;
+				detectedIdleLoopInstructions_ = idleLoopInstructions_;
+			}
+
+			idleLoopStart_ = pc;
+			idleLoopRegisters_ = registers;
+			idleLoopIME_ = ime;
+			idleLoopCycles_ = 0;
+			idleLoopInstructions_ = 0;
+			idleLoopSafe_ = true;
+		}
+
+		void resetIdleLoop_()
+		{
+			idleLoopSafe_ = false;
+			detectedIdleLoopCycles_ = 0;
+			detectedIdleLoopInstructions_ = 0;
+		}
+
+		// 実行中の命令の即値 (d8, a8, r8)
+		uint8 imm8_() const
+		{
+			return operand_ & 0xff;
+		}
+
+		// 実行中の命令の即値 (d16, a16)
+		uint16 imm16_() const
+		{
+			return operand_;
+		}
+
 		// Instructions List 0x00-0xff
+		// レジスタなどのオペランドはオペコードをテンプレート引数としてコンパイル時に決定する
 
-		std::array<Instruction, 256> unprefixedInstructions = {
+		static constexpr std::array<Instruction, 256> unprefixedInstructions = {
 			{
 				{ 0x00, 1, 4, 0, U"NOP"_sv, U""_sv, &CPU_detail::nop_ },
-				{ 0x01, 3, 12, 0, U"LD"_sv, U"BC,d16"_sv, &CPU_detail::ld16_ },
-				{ 0x02, 1, 8, 0, U"LD"_sv, U"BC,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x03, 1, 8, 0, U"INC"_sv, U"BC"_sv, &CPU_detail::inc16_ },
-				{ 0x04, 1, 4, 0, U"INC"_sv, U"B"_sv, &CPU_detail::inc_ },
-				{ 0x05, 1, 4, 0, U"DEC"_sv, U"B"_sv, &CPU_detail::dec_ },
-				{ 0x06, 2, 8, 0, U"LD"_sv, U"B,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x01, 3, 12, 0, U"LD"_sv, U"BC,d16"_sv, &CPU_detail::ld16_<0x01> },
+				{ 0x02, 1, 8, 0, U"LD"_sv, U"BC,A"_sv, &CPU_detail::ld_n_a_<0x02> },
+				{ 0x03, 1, 8, 0, U"INC"_sv, U"BC"_sv, &CPU_detail::inc16_<0x03> },
+				{ 0x04, 1, 4, 0, U"INC"_sv, U"B"_sv, &CPU_detail::inc_<0x04> },
+				{ 0x05, 1, 4, 0, U"DEC"_sv, U"B"_sv, &CPU_detail::dec_<0x05> },
+				{ 0x06, 2, 8, 0, U"LD"_sv, U"B,d8"_sv, &CPU_detail::ld_r_n_<0x06> },
 				{ 0x07, 1, 4, 0, U"RLCA"_sv, U""_sv, &CPU_detail::rlca_ },
 				{ 0x08, 3, 20, 0, U"LD"_sv, U"a16,SP"_sv, &CPU_detail::ld16_n_sp_ },
-				{ 0x09, 1, 8, 0, U"ADD"_sv, U"HL,BC"_sv, &CPU_detail::add_hl_ },
-				{ 0x0a, 1, 8, 0, U"LD"_sv, U"A,BC"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x0b, 1, 8, 0, U"DEC"_sv, U"BC"_sv, &CPU_detail::dec16_ },
-				{ 0x0c, 1, 4, 0, U"INC"_sv, U"C"_sv, &CPU_detail::inc_ },
-				{ 0x0d, 1, 4, 0, U"DEC"_sv, U"C"_sv, &CPU_detail::dec_ },
-				{ 0x0e, 2, 8, 0, U"LD"_sv, U"C,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x09, 1, 8, 0, U"ADD"_sv, U"HL,BC"_sv, &CPU_detail::add_hl_<0x09> },
+				{ 0x0a, 1, 8, 0, U"LD"_sv, U"A,BC"_sv, &CPU_detail::ld_a_n_<0x0a> },
+				{ 0x0b, 1, 8, 0, U"DEC"_sv, U"BC"_sv, &CPU_detail::dec16_<0x0b> },
+				{ 0x0c, 1, 4, 0, U"INC"_sv, U"C"_sv, &CPU_detail::inc_<0x0c> },
+				{ 0x0d, 1, 4, 0, U"DEC"_sv, U"C"_sv, &CPU_detail::dec_<0x0d> },
+				{ 0x0e, 2, 8, 0, U"LD"_sv, U"C,d8"_sv, &CPU_detail::ld_r_n_<0x0e> },
 				{ 0x0f, 1, 4, 0, U"RRCA"_sv, U""_sv, &CPU_detail::rrca_ },
 				{ 0x10, 2, 4, 0, U"STOP"_sv, U"d8"_sv, &CPU_detail::stop_ },
-				{ 0x11, 3, 12, 0, U"LD"_sv, U"DE,d16"_sv, &CPU_detail::ld16_ },
-				{ 0x12, 1, 8, 0, U"LD"_sv, U"DE,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x13, 1, 8, 0, U"INC"_sv, U"DE"_sv, &CPU_detail::inc16_ },
-				{ 0x14, 1, 4, 0, U"INC"_sv, U"D"_sv, &CPU_detail::inc_ },
-				{ 0x15, 1, 4, 0, U"DEC"_sv, U"D"_sv, &CPU_detail::dec_ },
-				{ 0x16, 2, 8, 0, U"LD"_sv, U"D,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x11, 3, 12, 0, U"LD"_sv, U"DE,d16"_sv, &CPU_detail::ld16_<0x11> },
+				{ 0x12, 1, 8, 0, U"LD"_sv, U"DE,A"_sv, &CPU_detail::ld_n_a_<0x12> },
+				{ 0x13, 1, 8, 0, U"INC"_sv, U"DE"_sv, &CPU_detail::inc16_<0x13> },
+				{ 0x14, 1, 4, 0, U"INC"_sv, U"D"_sv, &CPU_detail::inc_<0x14> },
+				{ 0x15, 1, 4, 0, U"DEC"_sv, U"D"_sv, &CPU_detail::dec_<0x15> },
+				{ 0x16, 2, 8, 0, U"LD"_sv, U"D,d8"_sv, &CPU_detail::ld_r_n_<0x16> },
 				{ 0x17, 1, 4, 0, U"RLA"_sv, U""_sv, &CPU_detail::rla_ },
-				{ 0x18, 2, 12, 0, U"JR"_sv, U"r8"_sv, &CPU_detail::jr_ },
-				{ 0x19, 1, 8, 0, U"ADD"_sv, U"HL,DE"_sv, &CPU_detail::add_hl_ },
-				{ 0x1a, 1, 8, 0, U"LD"_sv, U"A,DE"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x1b, 1, 8, 0, U"DEC"_sv, U"DE"_sv, &CPU_detail::dec16_ },
-				{ 0x1c, 1, 4, 0, U"INC"_sv, U"E"_sv, &CPU_detail::inc_ },
-				{ 0x1d, 1, 4, 0, U"DEC"_sv, U"E"_sv, &CPU_detail::dec_ },
-				{ 0x1e, 2, 8, 0, U"LD"_sv, U"E,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x18, 2, 12, 0, U"JR"_sv, U"r8"_sv, &CPU_detail::jr_<0x18> },
+				{ 0x19, 1, 8, 0, U"ADD"_sv, U"HL,DE"_sv, &CPU_detail::add_hl_<0x19> },
+				{ 0x1a, 1, 8, 0, U"LD"_sv, U"A,DE"_sv, &CPU_detail::ld_a_n_<0x1a> },
+				{ 0x1b, 1, 8, 0, U"DEC"_sv, U"DE"_sv, &CPU_detail::dec16_<0x1b> },
+				{ 0x1c, 1, 4, 0, U"INC"_sv, U"E"_sv, &CPU_detail::inc_<0x1c> },
+				{ 0x1d, 1, 4, 0, U"DEC"_sv, U"E"_sv, &CPU_detail::dec_<0x1d> },
+				{ 0x1e, 2, 8, 0, U"LD"_sv, U"E,d8"_sv, &CPU_detail::ld_r_n_<0x1e> },
 				{ 0x1f, 1, 4, 0, U"RRA"_sv, U""_sv, &CPU_detail::rra_ },
-				{ 0x20, 2, 12, 8, U"JR"_sv, U"NZ,r8"_sv, &CPU_detail::jr_ },
-				{ 0x21, 3, 12, 0, U"LD"_sv, U"HL,d16"_sv, &CPU_detail::ld16_ },
+				{ 0x20, 2, 12, 8, U"JR"_sv, U"NZ,r8"_sv, &CPU_detail::jr_<0x20> },
+				{ 0x21, 3, 12, 0, U"LD"_sv, U"HL,d16"_sv, &CPU_detail::ld16_<0x21> },
 				{ 0x22, 1, 8, 0, U"LDI"_sv, U"HL,A"_sv, &CPU_detail::ldi_hl_a_ },
-				{ 0x23, 1, 8, 0, U"INC"_sv, U"HL"_sv, &CPU_detail::inc16_ },
-				{ 0x24, 1, 4, 0, U"INC"_sv, U"H"_sv, &CPU_detail::inc_ },
-				{ 0x25, 1, 4, 0, U"DEC"_sv, U"H"_sv, &CPU_detail::dec_ },
-				{ 0x26, 2, 8, 0, U"LD"_sv, U"H,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x23, 1, 8, 0, U"INC"_sv, U"HL"_sv, &CPU_detail::inc16_<0x23> },
+				{ 0x24, 1, 4, 0, U"INC"_sv, U"H"_sv, &CPU_detail::inc_<0x24> },
+				{ 0x25, 1, 4, 0, U"DEC"_sv, U"H"_sv, &CPU_detail::dec_<0x25> },
+				{ 0x26, 2, 8, 0, U"LD"_sv, U"H,d8"_sv, &CPU_detail::ld_r_n_<0x26> },
 				{ 0x27, 1, 4, 0, U"DAA"_sv, U""_sv, &CPU_detail::daa_ },
-				{ 0x28, 2, 12, 8, U"JR"_sv, U"Z,r8"_sv, &CPU_detail::jr_ },
-				{ 0x29, 1, 8, 0, U"ADD"_sv, U"HL,HL"_sv, &CPU_detail::add_hl_ },
+				{ 0x28, 2, 12, 8, U"JR"_sv, U"Z,r8"_sv, &CPU_detail::jr_<0x28> },
+				{ 0x29, 1, 8, 0, U"ADD"_sv, U"HL,HL"_sv, &CPU_detail::add_hl_<0x29> },
 				{ 0x2a, 1, 8, 0, U"LD"_sv, U"A,HL"_sv, &CPU_detail::ldi_a_hl_ },
-				{ 0x2b, 1, 8, 0, U"DEC"_sv, U"HL"_sv, &CPU_detail::dec16_ },
-				{ 0x2c, 1, 4, 0, U"INC"_sv, U"L"_sv, &CPU_detail::inc_ },
-				{ 0x2d, 1, 4, 0, U"DEC"_sv, U"L"_sv, &CPU_detail::dec_ },
-				{ 0x2e, 2, 8, 0, U"LD"_sv, U"L,d8"_sv, &CPU_detail::ld_r_n_ },
+				{ 0x2b, 1, 8, 0, U"DEC"_sv, U"HL"_sv, &CPU_detail::dec16_<0x2b> },
+				{ 0x2c, 1, 4, 0, U"INC"_sv, U"L"_sv, &CPU_detail::inc_<0x2c> },
+				{ 0x2d, 1, 4, 0, U"DEC"_sv, U"L"_sv, &CPU_detail::dec_<0x2d> },
+				{ 0x2e, 2, 8, 0, U"LD"_sv, U"L,d8"_sv, &CPU_detail::ld_r_n_<0x2e> },
 				{ 0x2f, 1, 4, 0, U"CPL"_sv, U""_sv, &CPU_detail::cpl_ },
-				{ 0x30, 2, 12, 8, U"JR"_sv, U"NC,r8"_sv, &CPU_detail::jr_ },
-				{ 0x31, 3, 12, 0, U"LD"_sv, U"SP,d16"_sv, &CPU_detail::ld16_ },
+				{ 0x30, 2, 12, 8, U"JR"_sv, U"NC,r8"_sv, &CPU_detail::jr_<0x30> },
+				{ 0x31, 3, 12, 0, U"LD"_sv, U"SP,d16"_sv, &CPU_detail::ld16_<0x31> },
 				{ 0x32, 1, 8, 0, U"LD"_sv, U"HL,A"_sv, &CPU_detail::ldd_hl_a_ },
-				{ 0x33, 1, 8, 0, U"INC"_sv, U"SP"_sv, &CPU_detail::inc16_ },
+				{ 0x33, 1, 8, 0, U"INC"_sv, U"SP"_sv, &CPU_detail::inc16_<0x33> },
 				{ 0x34, 1, 12, 0, U"INC"_sv, U"HL"_sv, &CPU_detail::inc_hl_ },
 				{ 0x35, 1, 12, 0, U"DEC"_sv, U"HL"_sv, &CPU_detail::dec_hl_ },
-				{ 0x36, 2, 12, 0, U"LD"_sv, U"HL,d8"_sv, &CPU_detail::ld_r_r_ },
+				{ 0x36, 2, 12, 0, U"LD"_sv, U"HL,d8"_sv, &CPU_detail::ld_r_r_<0x36> },
 				{ 0x37, 1, 4, 0, U"SCF"_sv, U""_sv, &CPU_detail::scf_ },
-				{ 0x38, 2, 12, 8, U"JR"_sv, U"C,r8"_sv, &CPU_detail::jr_ },
-				{ 0x39, 1, 8, 0, U"ADD"_sv, U"HL,SP"_sv, &CPU_detail::add_hl_ },
+				{ 0x38, 2, 12, 8, U"JR"_sv, U"C,r8"_sv, &CPU_detail::jr_<0x38> },
+				{ 0x39, 1, 8, 0, U"ADD"_sv, U"HL,SP"_sv, &CPU_detail::add_hl_<0x39> },
 				{ 0x3a, 1, 8, 0, U"LD"_sv, U"A,HL"_sv, &CPU_detail::ldd_a_hl_ },
-				{ 0x3b, 1, 8, 0, U"DEC"_sv, U"SP"_sv, &CPU_detail::dec16_ },
-				{ 0x3c, 1, 4, 0, U"INC"_sv, U"A"_sv, &CPU_detail::inc_ },
-				{ 0x3d, 1, 4, 0, U"DEC"_sv, U"A"_sv, &CPU_detail::dec_ },
-				{ 0x3e, 2, 8, 0, U"LD"_sv, U"A,d8"_sv, &CPU_detail::ld_a_n_ },
+				{ 0x3b, 1, 8, 0, U"DEC"_sv, U"SP"_sv, &CPU_detail::dec16_<0x3b> },
+				{ 0x3c, 1, 4, 0, U"INC"_sv, U"A"_sv, &CPU_detail::inc_<0x3c> },
+				{ 0x3d, 1, 4, 0, U"DEC"_sv, U"A"_sv, &CPU_detail::dec_<0x3d> },
+				{ 0x3e, 2, 8, 0, U"LD"_sv, U"A,d8"_sv, &CPU_detail::ld_a_n_<0x3e> },
 				{ 0x3f, 1, 4, 0, U"CCF"_sv, U""_sv, &CPU_detail::ccf_ },
-				{ 0x40, 1, 4, 0, U"LD"_sv, U"B,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x41, 1, 4, 0, U"LD"_sv, U"B,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x42, 1, 4, 0, U"LD"_sv, U"B,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x43, 1, 4, 0, U"LD"_sv, U"B,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x44, 1, 4, 0, U"LD"_sv, U"B,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x45, 1, 4, 0, U"LD"_sv, U"B,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x46, 1, 8, 0, U"LD"_sv, U"B,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x47, 1, 4, 0, U"LD"_sv, U"B,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x48, 1, 4, 0, U"LD"_sv, U"C,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x49, 1, 4, 0, U"LD"_sv, U"C,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4a, 1, 4, 0, U"LD"_sv, U"C,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4b, 1, 4, 0, U"LD"_sv, U"C,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4c, 1, 4, 0, U"LD"_sv, U"C,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4d, 1, 4, 0, U"LD"_sv, U"C,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4e, 1, 8, 0, U"LD"_sv, U"C,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x4f, 1, 4, 0, U"LD"_sv, U"C,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x50, 1, 4, 0, U"LD"_sv, U"D,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x51, 1, 4, 0, U"LD"_sv, U"D,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x52, 1, 4, 0, U"LD"_sv, U"D,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x53, 1, 4, 0, U"LD"_sv, U"D,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x54, 1, 4, 0, U"LD"_sv, U"D,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x55, 1, 4, 0, U"LD"_sv, U"D,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x56, 1, 8, 0, U"LD"_sv, U"D,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x57, 1, 4, 0, U"LD"_sv, U"D,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x58, 1, 4, 0, U"LD"_sv, U"E,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x59, 1, 4, 0, U"LD"_sv, U"E,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5a, 1, 4, 0, U"LD"_sv, U"E,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5b, 1, 4, 0, U"LD"_sv, U"E,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5c, 1, 4, 0, U"LD"_sv, U"E,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5d, 1, 4, 0, U"LD"_sv, U"E,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5e, 1, 8, 0, U"LD"_sv, U"E,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x5f, 1, 4, 0, U"LD"_sv, U"E,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x60, 1, 4, 0, U"LD"_sv, U"H,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x61, 1, 4, 0, U"LD"_sv, U"H,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x62, 1, 4, 0, U"LD"_sv, U"H,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x63, 1, 4, 0, U"LD"_sv, U"H,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x64, 1, 4, 0, U"LD"_sv, U"H,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x65, 1, 4, 0, U"LD"_sv, U"H,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x66, 1, 8, 0, U"LD"_sv, U"H,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x67, 1, 4, 0, U"LD"_sv, U"H,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x68, 1, 4, 0, U"LD"_sv, U"L,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x69, 1, 4, 0, U"LD"_sv, U"L,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6a, 1, 4, 0, U"LD"_sv, U"L,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6b, 1, 4, 0, U"LD"_sv, U"L,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6c, 1, 4, 0, U"LD"_sv, U"L,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6d, 1, 4, 0, U"LD"_sv, U"L,L"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6e, 1, 8, 0, U"LD"_sv, U"L,HL"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x6f, 1, 4, 0, U"LD"_sv, U"L,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x70, 1, 8, 0, U"LD"_sv, U"HL,B"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x71, 1, 8, 0, U"LD"_sv, U"HL,C"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x72, 1, 8, 0, U"LD"_sv, U"HL,D"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x73, 1, 8, 0, U"LD"_sv, U"HL,E"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x74, 1, 8, 0, U"LD"_sv, U"HL,H"_sv, &CPU_detail::ld_r_r_ },
-				{ 0x75, 1, 8, 0, U"LD"_sv, U"HL,L"_sv, &CPU_detail::ld_r_r_ },
+				{ 0x40, 1, 4, 0, U"LD"_sv, U"B,B"_sv, &CPU_detail::ld_r_r_<0x40> },
+				{ 0x41, 1, 4, 0, U"LD"_sv, U"B,C"_sv, &CPU_detail::ld_r_r_<0x41> },
+				{ 0x42, 1, 4, 0, U"LD"_sv, U"B,D"_sv, &CPU_detail::ld_r_r_<0x42> },
+				{ 0x43, 1, 4, 0, U"LD"_sv, U"B,E"_sv, &CPU_detail::ld_r_r_<0x43> },
+				{ 0x44, 1, 4, 0, U"LD"_sv, U"B,H"_sv, &CPU_detail::ld_r_r_<0x44> },
+				{ 0x45, 1, 4, 0, U"LD"_sv, U"B,L"_sv, &CPU_detail::ld_r_r_<0x45> },
+				{ 0x46, 1, 8, 0, U"LD"_sv, U"B,HL"_sv, &CPU_detail::ld_r_r_<0x46> },
+				{ 0x47, 1, 4, 0, U"LD"_sv, U"B,A"_sv, &CPU_detail::ld_n_a_<0x47> },
+				{ 0x48, 1, 4, 0, U"LD"_sv, U"C,B"_sv, &CPU_detail::ld_r_r_<0x48> },
+				{ 0x49, 1, 4, 0, U"LD"_sv, U"C,C"_sv, &CPU_detail::ld_r_r_<0x49> },
+				{ 0x4a, 1, 4, 0, U"LD"_sv, U"C,D"_sv, &CPU_detail::ld_r_r_<0x4a> },
+				{ 0x4b, 1, 4, 0, U"LD"_sv, U"C,E"_sv, &CPU_detail::ld_r_r_<0x4b> },
+				{ 0x4c, 1, 4, 0, U"LD"_sv, U"C,H"_sv, &CPU_detail::ld_r_r_<0x4c> },
+				{ 0x4d, 1, 4, 0, U"LD"_sv, U"C,L"_sv, &CPU_detail::ld_r_r_<0x4d> },
+				{ 0x4e, 1, 8, 0, U"LD"_sv, U"C,HL"_sv, &CPU_detail::ld_r_r_<0x4e> },
+				{ 0x4f, 1, 4, 0, U"LD"_sv, U"C,A"_sv, &CPU_detail::ld_n_a_<0x4f> },
+				{ 0x50, 1, 4, 0, U"LD"_sv, U"D,B"_sv, &CPU_detail::ld_r_r_<0x50> },
+				{ 0x51, 1, 4, 0, U"LD"_sv, U"D,C"_sv, &CPU_detail::ld_r_r_<0x51> },
+				{ 0x52, 1, 4, 0, U"LD"_sv, U"D,D"_sv, &CPU_detail::ld_r_r_<0x52> },
+				{ 0x53, 1, 4, 0, U"LD"_sv, U"D,E"_sv, &CPU_detail::ld_r_r_<0x53> },
+				{ 0x54, 1, 4, 0, U"LD"_sv, U"D,H"_sv, &CPU_detail::ld_r_r_<0x54> },
+				{ 0x55, 1, 4, 0, U"LD"_sv, U"D,L"_sv, &CPU_detail::ld_r_r_<0x55> },
+				{ 0x56, 1, 8, 0, U"LD"_sv, U"D,HL"_sv, &CPU_detail::ld_r_r_<0x56> },
+				{ 0x57, 1, 4, 0, U"LD"_sv, U"D,A"_sv, &CPU_detail::ld_n_a_<0x57> },
+				{ 0x58, 1, 4, 0, U"LD"_sv, U"E,B"_sv, &CPU_detail::ld_r_r_<0x58> },
+				{ 0x59, 1, 4, 0, U"LD"_sv, U"E,C"_sv, &CPU_detail::ld_r_r_<0x59> },
+				{ 0x5a, 1, 4, 0, U"LD"_sv, U"E,D"_sv, &CPU_detail::ld_r_r_<0x5a> },
+				{ 0x5b, 1, 4, 0, U"LD"_sv, U"E,E"_sv, &CPU_detail::ld_r_r_<0x5b> },
+				{ 0x5c, 1, 4, 0, U"LD"_sv, U"E,H"_sv, &CPU_detail::ld_r_r_<0x5c> },
+				{ 0x5d, 1, 4, 0, U"LD"_sv, U"E,L"_sv, &CPU_detail::ld_r_r_<0x5d> },
+				{ 0x5e, 1, 8, 0, U"LD"_sv, U"E,HL"_sv, &CPU_detail::ld_r_r_<0x5e> },
+				{ 0x5f, 1, 4, 0, U"LD"_sv, U"E,A"_sv, &CPU_detail::ld_n_a_<0x5f> },
+				{ 0x60, 1, 4, 0, U"LD"_sv, U"H,B"_sv, &CPU_detail::ld_r_r_<0x60> },
+				{ 0x61, 1, 4, 0, U"LD"_sv, U"H,C"_sv, &CPU_detail::ld_r_r_<0x61> },
+				{ 0x62, 1, 4, 0, U"LD"_sv, U"H,D"_sv, &CPU_detail::ld_r_r_<0x62> },
+				{ 0x63, 1, 4, 0, U"LD"_sv, U"H,E"_sv, &CPU_detail::ld_r_r_<0x63> },
+				{ 0x64, 1, 4, 0, U"LD"_sv, U"H,H"_sv, &CPU_detail::ld_r_r_<0x64> },
+				{ 0x65, 1, 4, 0, U"LD"_sv, U"H,L"_sv, &CPU_detail::ld_r_r_<0x65> },
+				{ 0x66, 1, 8, 0, U"LD"_sv, U"H,HL"_sv, &CPU_detail::ld_r_r_<0x66> },
+				{ 0x67, 1, 4, 0, U"LD"_sv, U"H,A"_sv, &CPU_detail::ld_n_a_<0x67> },
+				{ 0x68, 1, 4, 0, U"LD"_sv, U"L,B"_sv, &CPU_detail::ld_r_r_<0x68> },
+				{ 0x69, 1, 4, 0, U"LD"_sv, U"L,C"_sv, &CPU_detail::ld_r_r_<0x69> },
+				{ 0x6a, 1, 4, 0, U"LD"_sv, U"L,D"_sv, &CPU_detail::ld_r_r_<0x6a> },
+				{ 0x6b, 1, 4, 0, U"LD"_sv, U"L,E"_sv, &CPU_detail::ld_r_r_<0x6b> },
+				{ 0x6c, 1, 4, 0, U"LD"_sv, U"L,H"_sv, &CPU_detail::ld_r_r_<0x6c> },
+				{ 0x6d, 1, 4, 0, U"LD"_sv, U"L,L"_sv, &CPU_detail::ld_r_r_<0x6d> },
+				{ 0x6e, 1, 8, 0, U"LD"_sv, U"L,HL"_sv, &CPU_detail::ld_r_r_<0x6e> },
+				{ 0x6f, 1, 4, 0, U"LD"_sv, U"L,A"_sv, &CPU_detail::ld_n_a_<0x6f> },
+				{ 0x70, 1, 8, 0, U"LD"_sv, U"HL,B"_sv, &CPU_detail::ld_r_r_<0x70> },
+				{ 0x71, 1, 8, 0, U"LD"_sv, U"HL,C"_sv, &CPU_detail::ld_r_r_<0x71> },
+				{ 0x72, 1, 8, 0, U"LD"_sv, U"HL,D"_sv, &CPU_detail::ld_r_r_<0x72> },
+				{ 0x73, 1, 8, 0, U"LD"_sv, U"HL,E"_sv, &CPU_detail::ld_r_r_<0x73> },
+				{ 0x74, 1, 8, 0, U"LD"_sv, U"HL,H"_sv, &CPU_detail::ld_r_r_<0x74> },
+				{ 0x75, 1, 8, 0, U"LD"_sv, U"HL,L"_sv, &CPU_detail::ld_r_r_<0x75> },
 				{ 0x76, 1, 4, 0, U"HALT"_sv, U""_sv, &CPU_detail::halt_ },
-				{ 0x77, 1, 8, 0, U"LD"_sv, U"HL,A"_sv, &CPU_detail::ld_n_a_ },
-				{ 0x78, 1, 4, 0, U"LD"_sv, U"A,B"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x79, 1, 4, 0, U"LD"_sv, U"A,C"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7a, 1, 4, 0, U"LD"_sv, U"A,D"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7b, 1, 4, 0, U"LD"_sv, U"A,E"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7c, 1, 4, 0, U"LD"_sv, U"A,H"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7d, 1, 4, 0, U"LD"_sv, U"A,L"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7e, 1, 8, 0, U"LD"_sv, U"A,HL"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x7f, 1, 4, 0, U"LD"_sv, U"A,A"_sv, &CPU_detail::ld_a_n_ },
-				{ 0x80, 1, 4, 0, U"ADD"_sv, U"A,B"_sv, &CPU_detail::add_a_ },
-				{ 0x81, 1, 4, 0, U"ADD"_sv, U"A,C"_sv, &CPU_detail::add_a_ },
-				{ 0x82, 1, 4, 0, U"ADD"_sv, U"A,D"_sv, &CPU_detail::add_a_ },
-				{ 0x83, 1, 4, 0, U"ADD"_sv, U"A,E"_sv, &CPU_detail::add_a_ },
-				{ 0x84, 1, 4, 0, U"ADD"_sv, U"A,H"_sv, &CPU_detail::add_a_ },
-				{ 0x85, 1, 4, 0, U"ADD"_sv, U"A,L"_sv, &CPU_detail::add_a_ },
-				{ 0x86, 1, 8, 0, U"ADD"_sv, U"A,HL"_sv, &CPU_detail::add_a_ },
-				{ 0x87, 1, 4, 0, U"ADD"_sv, U"A,A"_sv, &CPU_detail::add_a_ },
-				{ 0x88, 1, 4, 0, U"ADC"_sv, U"A,B"_sv, &CPU_detail::adc_a_ },
-				{ 0x89, 1, 4, 0, U"ADC"_sv, U"A,C"_sv, &CPU_detail::adc_a_ },
-				{ 0x8a, 1, 4, 0, U"ADC"_sv, U"A,D"_sv, &CPU_detail::adc_a_ },
-				{ 0x8b, 1, 4, 0, U"ADC"_sv, U"A,E"_sv, &CPU_detail::adc_a_ },
-				{ 0x8c, 1, 4, 0, U"ADC"_sv, U"A,H"_sv, &CPU_detail::adc_a_ },
-				{ 0x8d, 1, 4, 0, U"ADC"_sv, U"A,L"_sv, &CPU_detail::adc_a_ },
-				{ 0x8e, 1, 8, 0, U"ADC"_sv, U"A,HL"_sv, &CPU_detail::adc_a_ },
-				{ 0x8f, 1, 4, 0, U"ADC"_sv, U"A,A"_sv, &CPU_detail::adc_a_ },
-				{ 0x90, 1, 4, 0, U"SUB"_sv, U"B"_sv, &CPU_detail::sub_a_ },
-				{ 0x91, 1, 4, 0, U"SUB"_sv, U"C"_sv, &CPU_detail::sub_a_ },
-				{ 0x92, 1, 4, 0, U"SUB"_sv, U"D"_sv, &CPU_detail::sub_a_ },
-				{ 0x93, 1, 4, 0, U"SUB"_sv, U"E"_sv, &CPU_detail::sub_a_ },
-				{ 0x94, 1, 4, 0, U"SUB"_sv, U"H"_sv, &CPU_detail::sub_a_ },
-				{ 0x95, 1, 4, 0, U"SUB"_sv, U"L"_sv, &CPU_detail::sub_a_ },
-				{ 0x96, 1, 8, 0, U"SUB"_sv, U"HL"_sv, &CPU_detail::sub_a_ },
-				{ 0x97, 1, 4, 0, U"SUB"_sv, U"A"_sv, &CPU_detail::sub_a_ },
-				{ 0x98, 1, 4, 0, U"SBC"_sv, U"A,B"_sv, &CPU_detail::sbc_a_ },
-				{ 0x99, 1, 4, 0, U"SBC"_sv, U"A,C"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9a, 1, 4, 0, U"SBC"_sv, U"A,D"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9b, 1, 4, 0, U"SBC"_sv, U"A,E"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9c, 1, 4, 0, U"SBC"_sv, U"A,H"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9d, 1, 4, 0, U"SBC"_sv, U"A,L"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9e, 1, 8, 0, U"SBC"_sv, U"A,HL"_sv, &CPU_detail::sbc_a_ },
-				{ 0x9f, 1, 4, 0, U"SBC"_sv, U"A,A"_sv, &CPU_detail::sbc_a_ },
-				{ 0xa0, 1, 4, 0, U"AND"_sv, U"B"_sv, &CPU_detail::and_ },
-				{ 0xa1, 1, 4, 0, U"AND"_sv, U"C"_sv, &CPU_detail::and_ },
-				{ 0xa2, 1, 4, 0, U"AND"_sv, U"D"_sv, &CPU_detail::and_ },
-				{ 0xa3, 1, 4, 0, U"AND"_sv, U"E"_sv, &CPU_detail::and_ },
-				{ 0xa4, 1, 4, 0, U"AND"_sv, U"H"_sv, &CPU_detail::and_ },
-				{ 0xa5, 1, 4, 0, U"AND"_sv, U"L"_sv, &CPU_detail::and_ },
-				{ 0xa6, 1, 8, 0, U"AND"_sv, U"HL"_sv, &CPU_detail::and_ },
-				{ 0xa7, 1, 4, 0, U"AND"_sv, U"A"_sv, &CPU_detail::and_ },
-				{ 0xa8, 1, 4, 0, U"XOR"_sv, U"B"_sv, &CPU_detail::xor_ },
-				{ 0xa9, 1, 4, 0, U"XOR"_sv, U"C"_sv, &CPU_detail::xor_ },
-				{ 0xaa, 1, 4, 0, U"XOR"_sv, U"D"_sv, &CPU_detail::xor_ },
-				{ 0xab, 1, 4, 0, U"XOR"_sv, U"E"_sv, &CPU_detail::xor_ },
-				{ 0xac, 1, 4, 0, U"XOR"_sv, U"H"_sv, &CPU_detail::xor_ },
-				{ 0xad, 1, 4, 0, U"XOR"_sv, U"L"_sv, &CPU_detail::xor_ },
-				{ 0xae, 1, 8, 0, U"XOR"_sv, U"HL"_sv, &CPU_detail::xor_ },
-				{ 0xaf, 1, 4, 0, U"XOR"_sv, U"A"_sv, &CPU_detail::xor_ },
-				{ 0xb0, 1, 4, 0, U"OR"_sv, U"B"_sv, &CPU_detail::or_ },
-				{ 0xb1, 1, 4, 0, U"OR"_sv, U"C"_sv, &CPU_detail::or_ },
-				{ 0xb2, 1, 4, 0, U"OR"_sv, U"D"_sv, &CPU_detail::or_ },
-				{ 0xb3, 1, 4, 0, U"OR"_sv, U"E"_sv, &CPU_detail::or_ },
-				{ 0xb4, 1, 4, 0, U"OR"_sv, U"H"_sv, &CPU_detail::or_ },
-				{ 0xb5, 1, 4, 0, U"OR"_sv, U"L"_sv, &CPU_detail::or_ },
-				{ 0xb6, 1, 8, 0, U"OR"_sv, U"HL"_sv, &CPU_detail::or_ },
-				{ 0xb7, 1, 4, 0, U"OR"_sv, U"A"_sv, &CPU_detail::or_ },
-				{ 0xb8, 1, 4, 0, U"CP"_sv, U"B"_sv, &CPU_detail::cp_ },
-				{ 0xb9, 1, 4, 0, U"CP"_sv, U"C"_sv, &CPU_detail::cp_ },
-				{ 0xba, 1, 4, 0, U"CP"_sv, U"D"_sv, &CPU_detail::cp_ },
-				{ 0xbb, 1, 4, 0, U"CP"_sv, U"E"_sv, &CPU_detail::cp_ },
-				{ 0xbc, 1, 4, 0, U"CP"_sv, U"H"_sv, &CPU_detail::cp_ },
-				{ 0xbd, 1, 4, 0, U"CP"_sv, U"L"_sv, &CPU_detail::cp_ },
-				{ 0xbe, 1, 8, 0, U"CP"_sv, U"HL"_sv, &CPU_detail::cp_ },
-				{ 0xbf, 1, 4, 0, U"CP"_sv, U"A"_sv, &CPU_detail::cp_ },
-				{ 0xc0, 1, 20, 8, U"RET"_sv, U"NZ"_sv, &CPU_detail::ret_ },
-				{ 0xc1, 1, 12, 0, U"POP"_sv, U"BC"_sv, &CPU_detail::pop_ },
-				{ 0xc2, 3, 16, 12, U"JP"_sv, U"NZ,a16"_sv, &CPU_detail::jp_ },
-				{ 0xc3, 3, 16, 0, U"JP"_sv, U"a16"_sv, &CPU_detail::jp_ },
-				{ 0xc4, 3, 24, 12, U"CALL"_sv, U"NZ,a16"_sv, &CPU_detail::call_ },
-				{ 0xc5, 1, 16, 0, U"PUSH"_sv, U"BC"_sv, &CPU_detail::push_ },
-				{ 0xc6, 2, 8, 0, U"ADD"_sv, U"A,d8"_sv, &CPU_detail::add_a_ },
-				{ 0xc7, 1, 16, 0, U"RST"_sv, U"00H"_sv, &CPU_detail::rst_ },
-				{ 0xc8, 1, 20, 8, U"RET"_sv, U"Z"_sv, &CPU_detail::ret_ },
-				{ 0xc9, 1, 16, 0, U"RET"_sv, U""_sv, &CPU_detail::ret_ },
-				{ 0xca, 3, 16, 12, U"JP"_sv, U"Z,a16"_sv, &CPU_detail::jp_ },
+				{ 0x77, 1, 8, 0, U"LD"_sv, U"HL,A"_sv, &CPU_detail::ld_n_a_<0x77> },
+				{ 0x78, 1, 4, 0, U"LD"_sv, U"A,B"_sv, &CPU_detail::ld_a_n_<0x78> },
+				{ 0x79, 1, 4, 0, U"LD"_sv, U"A,C"_sv, &CPU_detail::ld_a_n_<0x79> },
+				{ 0x7a, 1, 4, 0, U"LD"_sv, U"A,D"_sv, &CPU_detail::ld_a_n_<0x7a> },
+				{ 0x7b, 1, 4, 0, U"LD"_sv, U"A,E"_sv, &CPU_detail::ld_a_n_<0x7b> },
+				{ 0x7c, 1, 4, 0, U"LD"_sv, U"A,H"_sv, &CPU_detail::ld_a_n_<0x7c> },
+				{ 0x7d, 1, 4, 0, U"LD"_sv, U"A,L"_sv, &CPU_detail::ld_a_n_<0x7d> },
+				{ 0x7e, 1, 8, 0, U"LD"_sv, U"A,HL"_sv, &CPU_detail::ld_a_n_<0x7e> },
+				{ 0x7f, 1, 4, 0, U"LD"_sv, U"A,A"_sv, &CPU_detail::ld_a_n_<0x7f> },
+				{ 0x80, 1, 4, 0, U"ADD"_sv, U"A,B"_sv, &CPU_detail::add_a_<0x80> },
+				{ 0x81, 1, 4, 0, U"ADD"_sv, U"A,C"_sv, &CPU_detail::add_a_<0x81> },
+				{ 0x82, 1, 4, 0, U"ADD"_sv, U"A,D"_sv, &CPU_detail::add_a_<0x82> },
+				{ 0x83, 1, 4, 0, U"ADD"_sv, U"A,E"_sv, &CPU_detail::add_a_<0x83> },
+				{ 0x84, 1, 4, 0, U"ADD"_sv, U"A,H"_sv, &CPU_detail::add_a_<0x84> },
+				{ 0x85, 1, 4, 0, U"ADD"_sv, U"A,L"_sv, &CPU_detail::add_a_<0x85> },
+				{ 0x86, 1, 8, 0, U"ADD"_sv, U"A,HL"_sv, &CPU_detail::add_a_<0x86> },
+				{ 0x87, 1, 4, 0, U"ADD"_sv, U"A,A"_sv, &CPU_detail::add_a_<0x87> },
+				{ 0x88, 1, 4, 0, U"ADC"_sv, U"A,B"_sv, &CPU_detail::adc_a_<0x88> },
+				{ 0x89, 1, 4, 0, U"ADC"_sv, U"A,C"_sv, &CPU_detail::adc_a_<0x89> },
+				{ 0x8a, 1, 4, 0, U"ADC"_sv, U"A,D"_sv, &CPU_detail::adc_a_<0x8a> },
+				{ 0x8b, 1, 4, 0, U"ADC"_sv, U"A,E"_sv, &CPU_detail::adc_a_<0x8b> },
+				{ 0x8c, 1, 4, 0, U"ADC"_sv, U"A,H"_sv, &CPU_detail::adc_a_<0x8c> },
+				{ 0x8d, 1, 4, 0, U"ADC"_sv, U"A,L"_sv, &CPU_detail::adc_a_<0x8d> },
+				{ 0x8e, 1, 8, 0, U"ADC"_sv, U"A,HL"_sv, &CPU_detail::adc_a_<0x8e> },
+				{ 0x8f, 1, 4, 0, U"ADC"_sv, U"A,A"_sv, &CPU_detail::adc_a_<0x8f> },
+				{ 0x90, 1, 4, 0, U"SUB"_sv, U"B"_sv, &CPU_detail::sub_a_<0x90> },
+				{ 0x91, 1, 4, 0, U"SUB"_sv, U"C"_sv, &CPU_detail::sub_a_<0x91> },
+				{ 0x92, 1, 4, 0, U"SUB"_sv, U"D"_sv, &CPU_detail::sub_a_<0x92> },
+				{ 0x93, 1, 4, 0, U"SUB"_sv, U"E"_sv, &CPU_detail::sub_a_<0x93> },
+				{ 0x94, 1, 4, 0, U"SUB"_sv, U"H"_sv, &CPU_detail::sub_a_<0x94> },
+				{ 0x95, 1, 4, 0, U"SUB"_sv, U"L"_sv, &CPU_detail::sub_a_<0x95> },
+				{ 0x96, 1, 8, 0, U"SUB"_sv, U"HL"_sv, &CPU_detail::sub_a_<0x96> },
+				{ 0x97, 1, 4, 0, U"SUB"_sv, U"A"_sv, &CPU_detail::sub_a_<0x97> },
+				{ 0x98, 1, 4, 0, U"SBC"_sv, U"A,B"_sv, &CPU_detail::sbc_a_<0x98> },
+				{ 0x99, 1, 4, 0, U"SBC"_sv, U"A,C"_sv, &CPU_detail::sbc_a_<0x99> },
+				{ 0x9a, 1, 4, 0, U"SBC"_sv, U"A,D"_sv, &CPU_detail::sbc_a_<0x9a> },
+				{ 0x9b, 1, 4, 0, U"SBC"_sv, U"A,E"_sv, &CPU_detail::sbc_a_<0x9b> },
+				{ 0x9c, 1, 4, 0, U"SBC"_sv, U"A,H"_sv, &CPU_detail::sbc_a_<0x9c> },
+				{ 0x9d, 1, 4, 0, U"SBC"_sv, U"A,L"_sv, &CPU_detail::sbc_a_<0x9d> },
+				{ 0x9e, 1, 8, 0, U"SBC"_sv, U"A,HL"_sv, &CPU_detail::sbc_a_<0x9e> },
+				{ 0x9f, 1, 4, 0, U"SBC"_sv, U"A,A"_sv, &CPU_detail::sbc_a_<0x9f> },
+				{ 0xa0, 1, 4, 0, U"AND"_sv, U"B"_sv, &CPU_detail::and_<0xa0> },
+				{ 0xa1, 1, 4, 0, U"AND"_sv, U"C"_sv, &CPU_detail::and_<0xa1> },
+				{ 0xa2, 1, 4, 0, U"AND"_sv, U"D"_sv, &CPU_detail::and_<0xa2> },
+				{ 0xa3, 1, 4, 0, U"AND"_sv, U"E"_sv, &CPU_detail::and_<0xa3> },
+				{ 0xa4, 1, 4, 0, U"AND"_sv, U"H"_sv, &CPU_detail::and_<0xa4> },
+				{ 0xa5, 1, 4, 0, U"AND"_sv, U"L"_sv, &CPU_detail::and_<0xa5> },
+				{ 0xa6, 1, 8, 0, U"AND"_sv, U"HL"_sv, &CPU_detail::and_<0xa6> },
+				{ 0xa7, 1, 4, 0, U"AND"_sv, U"A"_sv, &CPU_detail::and_<0xa7> },
+				{ 0xa8, 1, 4, 0, U"XOR"_sv, U"B"_sv, &CPU_detail::xor_<0xa8> },
+				{ 0xa9, 1, 4, 0, U"XOR"_sv, U"C"_sv, &CPU_detail::xor_<0xa9> },
+				{ 0xaa, 1, 4, 0, U"XOR"_sv, U"D"_sv, &CPU_detail::xor_<0xaa> },
+				{ 0xab, 1, 4, 0, U"XOR"_sv, U"E"_sv, &CPU_detail::xor_<0xab> },
+				{ 0xac, 1, 4, 0, U"XOR"_sv, U"H"_sv, &CPU_detail::xor_<0xac> },
+				{ 0xad, 1, 4, 0, U"XOR"_sv, U"L"_sv, &CPU_detail::xor_<0xad> },
+				{ 0xae, 1, 8, 0, U"XOR"_sv, U"HL"_sv, &CPU_detail::xor_<0xae> },
+				{ 0xaf, 1, 4, 0, U"XOR"_sv, U"A"_sv, &CPU_detail::xor_<0xaf> },
+				{ 0xb0, 1, 4, 0, U"OR"_sv, U"B"_sv, &CPU_detail::or_<0xb0> },
+				{ 0xb1, 1, 4, 0, U"OR"_sv, U"C"_sv, &CPU_detail::or_<0xb1> },
+				{ 0xb2, 1, 4, 0, U"OR"_sv, U"D"_sv, &CPU_detail::or_<0xb2> },
+				{ 0xb3, 1, 4, 0, U"OR"_sv, U"E"_sv, &CPU_detail::or_<0xb3> },
+				{ 0xb4, 1, 4, 0, U"OR"_sv, U"H"_sv, &CPU_detail::or_<0xb4> },
+				{ 0xb5, 1, 4, 0, U"OR"_sv, U"L"_sv, &CPU_detail::or_<0xb5> },
+				{ 0xb6, 1, 8, 0, U"OR"_sv, U"HL"_sv, &CPU_detail::or_<0xb6> },
+				{ 0xb7, 1, 4, 0, U"OR"_sv, U"A"_sv, &CPU_detail::or_<0xb7> },
+				{ 0xb8, 1, 4, 0, U"CP"_sv, U"B"_sv, &CPU_detail::cp_<0xb8> },
+				{ 0xb9, 1, 4, 0, U"CP"_sv, U"C"_sv, &CPU_detail::cp_<0xb9> },
+				{ 0xba, 1, 4, 0, U"CP"_sv, U"D"_sv, &CPU_detail::cp_<0xba> },
+				{ 0xbb, 1, 4, 0, U"CP"_sv, U"E"_sv, &CPU_detail::cp_<0xbb> },
+				{ 0xbc, 1, 4, 0, U"CP"_sv, U"H"_sv, &CPU_detail::cp_<0xbc> },
+				{ 0xbd, 1, 4, 0, U"CP"_sv, U"L"_sv, &CPU_detail::cp_<0xbd> },
+				{ 0xbe, 1, 8, 0, U"CP"_sv, U"HL"_sv, &CPU_detail::cp_<0xbe> },
+				{ 0xbf, 1, 4, 0, U"CP"_sv, U"A"_sv, &CPU_detail::cp_<0xbf> },
+				{ 0xc0, 1, 20, 8, U"RET"_sv, U"NZ"_sv, &CPU_detail::ret_<0xc0> },
+				{ 0xc1, 1, 12, 0, U"POP"_sv, U"BC"_sv, &CPU_detail::pop_<0xc1> },
+				{ 0xc2, 3, 16, 12, U"JP"_sv, U"NZ,a16"_sv, &CPU_detail::jp_<0xc2> },
+				{ 0xc3, 3, 16, 0, U"JP"_sv, U"a16"_sv, &CPU_detail::jp_<0xc3> },
+				{ 0xc4, 3, 24, 12, U"CALL"_sv, U"NZ,a16"_sv, &CPU_detail::call_<0xc4> },
+				{ 0xc5, 1, 16, 0, U"PUSH"_sv, U"BC"_sv, &CPU_detail::push_<0xc5> },
+				{ 0xc6, 2, 8, 0, U"ADD"_sv, U"A,d8"_sv, &CPU_detail::add_a_<0xc6> },
+				{ 0xc7, 1, 16, 0, U"RST"_sv, U"00H"_sv, &CPU_detail::rst_<0xc7> },
+				{ 0xc8, 1, 20, 8, U"RET"_sv, U"Z"_sv, &CPU_detail::ret_<0xc8> },
+				{ 0xc9, 1, 16, 0, U"RET"_sv, U""_sv, &CPU_detail::ret_<0xc9> },
+				{ 0xca, 3, 16, 12, U"JP"_sv, U"Z,a16"_sv, &CPU_detail::jp_<0xca> },
 				{ 0xcb, 1, 4, 0, U"PREFIX"_sv, U""_sv, &CPU_detail::cbprefix_ },
-				{ 0xcc, 3, 24, 12, U"CALL"_sv, U"Z,a16"_sv, &CPU_detail::call_ },
-				{ 0xcd, 3, 24, 0, U"CALL"_sv, U"a16"_sv, &CPU_detail::call_ },
-				{ 0xce, 2, 8, 0, U"ADC"_sv, U"A,d8"_sv, &CPU_detail::adc_a_ },
-				{ 0xcf, 1, 16, 0, U"RST"_sv, U"08H"_sv, &CPU_detail::rst_ },
-				{ 0xd0, 1, 20, 8, U"RET"_sv, U"NC"_sv, &CPU_detail::ret_ },
-				{ 0xd1, 1, 12, 0, U"POP"_sv, U"DE"_sv, &CPU_detail::pop_ },
-				{ 0xd2, 3, 16, 12, U"JP"_sv, U"NC,a16"_sv, &CPU_detail::jp_ },
+				{ 0xcc, 3, 24, 12, U"CALL"_sv, U"Z,a16"_sv, &CPU_detail::call_<0xcc> },
+				{ 0xcd, 3, 24, 0, U"CALL"_sv, U"a16"_sv, &CPU_detail::call_<0xcd> },
+				{ 0xce, 2, 8, 0, U"ADC"_sv, U"A,d8"_sv, &CPU_detail::adc_a_<0xce> },
+				{ 0xcf, 1, 16, 0, U"RST"_sv, U"08H"_sv, &CPU_detail::rst_<0xcf> },
+				{ 0xd0, 1, 20, 8, U"RET"_sv, U"NC"_sv, &CPU_detail::ret_<0xd0> },
+				{ 0xd1, 1, 12, 0, U"POP"_sv, U"DE"_sv, &CPU_detail::pop_<0xd1> },
+				{ 0xd2, 3, 16, 12, U"JP"_sv, U"NC,a16"_sv, &CPU_detail::jp_<0xd2> },
 				{ 0xd3, 1, 4, 0, U"ILLEGAL_D3"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xd4, 3, 24, 12, U"CALL"_sv, U"NC,a16"_sv, &CPU_detail::call_ },
-				{ 0xd5, 1, 16, 0, U"PUSH"_sv, U"DE"_sv, &CPU_detail::push_ },
-				{ 0xd6, 2, 8, 0, U"SUB"_sv, U"d8"_sv, &CPU_detail::sub_a_ },
-				{ 0xd7, 1, 16, 0, U"RST"_sv, U"10H"_sv, &CPU_detail::rst_ },
-				{ 0xd8, 1, 20, 8, U"RET"_sv, U"C"_sv, &CPU_detail::ret_ },
+				{ 0xd4, 3, 24, 12, U"CALL"_sv, U"NC,a16"_sv, &CPU_detail::call_<0xd4> },
+				{ 0xd5, 1, 16, 0, U"PUSH"_sv, U"DE"_sv, &CPU_detail::push_<0xd5> },
+				{ 0xd6, 2, 8, 0, U"SUB"_sv, U"d8"_sv, &CPU_detail::sub_a_<0xd6> },
+				{ 0xd7, 1, 16, 0, U"RST"_sv, U"10H"_sv, &CPU_detail::rst_<0xd7> },
+				{ 0xd8, 1, 20, 8, U"RET"_sv, U"C"_sv, &CPU_detail::ret_<0xd8> },
 				{ 0xd9, 1, 16, 0, U"RETI"_sv, U""_sv, &CPU_detail::reti_ },
-				{ 0xda, 3, 16, 12, U"JP"_sv, U"C,a16"_sv, &CPU_detail::jp_ },
+				{ 0xda, 3, 16, 12, U"JP"_sv, U"C,a16"_sv, &CPU_detail::jp_<0xda> },
 				{ 0xdb, 1, 4, 0, U"ILLEGAL_DB"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xdc, 3, 24, 12, U"CALL"_sv, U"C,a16"_sv, &CPU_detail::call_ },
+				{ 0xdc, 3, 24, 12, U"CALL"_sv, U"C,a16"_sv, &CPU_detail::call_<0xdc> },
 				{ 0xdd, 1, 4, 0, U"ILLEGAL_DD"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xde, 2, 8, 0, U"SBC"_sv, U"A,d8"_sv, &CPU_detail::sbc_a_ },
-				{ 0xdf, 1, 16, 0, U"RST"_sv, U"18H"_sv, &CPU_detail::rst_ },
-				{ 0xe0, 2, 12, 0, U"LDH"_sv, U"a8,A"_sv, &CPU_detail::ldh_ },
-				{ 0xe1, 1, 12, 0, U"POP"_sv, U"HL"_sv, &CPU_detail::pop_ },
+				{ 0xde, 2, 8, 0, U"SBC"_sv, U"A,d8"_sv, &CPU_detail::sbc_a_<0xde> },
+				{ 0xdf, 1, 16, 0, U"RST"_sv, U"18H"_sv, &CPU_detail::rst_<0xdf> },
+				{ 0xe0, 2, 12, 0, U"LDH"_sv, U"a8,A"_sv, &CPU_detail::ldh_<0xe0> },
+				{ 0xe1, 1, 12, 0, U"POP"_sv, U"HL"_sv, &CPU_detail::pop_<0xe1> },
 				{ 0xe2, 1, 8, 0, U"LD"_sv, U"C,A"_sv, &CPU_detail::ld_c_a_ },
 				{ 0xe3, 1, 4, 0, U"ILLEGAL_E3"_sv, U""_sv, &CPU_detail::illegal_ },
 				{ 0xe4, 1, 4, 0, U"ILLEGAL_E4"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xe5, 1, 16, 0, U"PUSH"_sv, U"HL"_sv, &CPU_detail::push_ },
-				{ 0xe6, 2, 8, 0, U"AND"_sv, U"d8"_sv, &CPU_detail::and_ },
-				{ 0xe7, 1, 16, 0, U"RST"_sv, U"20H"_sv, &CPU_detail::rst_ },
+				{ 0xe5, 1, 16, 0, U"PUSH"_sv, U"HL"_sv, &CPU_detail::push_<0xe5> },
+				{ 0xe6, 2, 8, 0, U"AND"_sv, U"d8"_sv, &CPU_detail::and_<0xe6> },
+				{ 0xe7, 1, 16, 0, U"RST"_sv, U"20H"_sv, &CPU_detail::rst_<0xe7> },
 				{ 0xe8, 2, 16, 0, U"ADD"_sv, U"SP,r8"_sv, &CPU_detail::add_sp_ },
 				{ 0xe9, 1, 4, 0, U"JP"_sv, U"HL"_sv, &CPU_detail::jp_hl_ },
-				{ 0xea, 3, 16, 0, U"LD"_sv, U"a16,A"_sv, &CPU_detail::ld_n_a_ },
+				{ 0xea, 3, 16, 0, U"LD"_sv, U"a16,A"_sv, &CPU_detail::ld_n_a_<0xea> },
 				{ 0xeb, 1, 4, 0, U"ILLEGAL_EB"_sv, U""_sv, &CPU_detail::illegal_ },
 				{ 0xec, 1, 4, 0, U"ILLEGAL_EC"_sv, U""_sv, &CPU_detail::illegal_ },
 				{ 0xed, 1, 4, 0, U"ILLEGAL_ED"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xee, 2, 8, 0, U"XOR"_sv, U"d8"_sv, &CPU_detail::xor_ },
-				{ 0xef, 1, 16, 0, U"RST"_sv, U"28H"_sv, &CPU_detail::rst_ },
-				{ 0xf0, 2, 12, 0, U"LDH"_sv, U"A,a8"_sv, &CPU_detail::ldh_ },
-				{ 0xf1, 1, 12, 0, U"POP"_sv, U"AF"_sv, &CPU_detail::pop_ },
+				{ 0xee, 2, 8, 0, U"XOR"_sv, U"d8"_sv, &CPU_detail::xor_<0xee> },
+				{ 0xef, 1, 16, 0, U"RST"_sv, U"28H"_sv, &CPU_detail::rst_<0xef> },
+				{ 0xf0, 2, 12, 0, U"LDH"_sv, U"A,a8"_sv, &CPU_detail::ldh_<0xf0> },
+				{ 0xf1, 1, 12, 0, U"POP"_sv, U"AF"_sv, &CPU_detail::pop_<0xf1> },
 				{ 0xf2, 1, 8, 0, U"LD"_sv, U"A,C"_sv, &CPU_detail::ld_a_c_ },
 				{ 0xf3, 1, 4, 0, U"DI"_sv, U""_sv, &CPU_detail::di_ },
 				{ 0xf4, 1, 4, 0, U"ILLEGAL_F4"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xf5, 1, 16, 0, U"PUSH"_sv, U"AF"_sv, &CPU_detail::push_ },
-				{ 0xf6, 2, 8, 0, U"OR"_sv, U"d8"_sv, &CPU_detail::or_ },
-				{ 0xf7, 1, 16, 0, U"RST"_sv, U"30H"_sv, &CPU_detail::rst_ },
+				{ 0xf5, 1, 16, 0, U"PUSH"_sv, U"AF"_sv, &CPU_detail::push_<0xf5> },
+				{ 0xf6, 2, 8, 0, U"OR"_sv, U"d8"_sv, &CPU_detail::or_<0xf6> },
+				{ 0xf7, 1, 16, 0, U"RST"_sv, U"30H"_sv, &CPU_detail::rst_<0xf7> },
 				{ 0xf8, 2, 12, 0, U"LD"_sv, U"HL,SP,r8"_sv, &CPU_detail::ldhl_sp_n_ },
 				{ 0xf9, 1, 8, 0, U"LD"_sv, U"SP,HL"_sv, &CPU_detail::ld16_sp_hl_ },
-				{ 0xfa, 3, 16, 0, U"LD"_sv, U"A,a16"_sv, &CPU_detail::ld_a_n_ },
+				{ 0xfa, 3, 16, 0, U"LD"_sv, U"A,a16"_sv, &CPU_detail::ld_a_n_<0xfa> },
 				{ 0xfb, 1, 4, 0, U"EI"_sv, U""_sv, &CPU_detail::ei_ },
 				{ 0xfc, 1, 4, 0, U"ILLEGAL_FC"_sv, U""_sv, &CPU_detail::illegal_ },
 				{ 0xfd, 1, 4, 0, U"ILLEGAL_FD"_sv, U""_sv, &CPU_detail::illegal_ },
-				{ 0xfe, 2, 8, 0, U"CP"_sv, U"d8"_sv, &CPU_detail::cp_ },
-				{ 0xff, 1, 16, 0, U"RST"_sv, U"38H"_sv, &CPU_detail::rst_ },
+				{ 0xfe, 2, 8, 0, U"CP"_sv, U"d8"_sv, &CPU_detail::cp_<0xfe> },
+				{ 0xff, 1, 16, 0, U"RST"_sv, U"38H"_sv, &CPU_detail::rst_<0xff> },
 			}
 		};
 
 		// Instructions List (0xcb Prefixed) 0x00-0xff
 
-		std::array<Instruction, 256> cbprefixedInstructions = {
+		static constexpr std::array<Instruction, 256> cbprefixedInstructions = {
 			{
-				{ 0x00, 2, 8, 0, U"RLC"_sv, U"B"_sv, &CPU_detail::rlc_ },
-				{ 0x01, 2, 8, 0, U"RLC"_sv, U"C"_sv, &CPU_detail::rlc_ },
-				{ 0x02, 2, 8, 0, U"RLC"_sv, U"D"_sv, &CPU_detail::rlc_ },
-				{ 0x03, 2, 8, 0, U"RLC"_sv, U"E"_sv, &CPU_detail::rlc_ },
-				{ 0x04, 2, 8, 0, U"RLC"_sv, U"H"_sv, &CPU_detail::rlc_ },
-				{ 0x05, 2, 8, 0, U"RLC"_sv, U"L"_sv, &CPU_detail::rlc_ },
+				{ 0x00, 2, 8, 0, U"RLC"_sv, U"B"_sv, &CPU_detail::rlc_<0x00> },
+				{ 0x01, 2, 8, 0, U"RLC"_sv, U"C"_sv, &CPU_detail::rlc_<0x01> },
+				{ 0x02, 2, 8, 0, U"RLC"_sv, U"D"_sv, &CPU_detail::rlc_<0x02> },
+				{ 0x03, 2, 8, 0, U"RLC"_sv, U"E"_sv, &CPU_detail::rlc_<0x03> },
+				{ 0x04, 2, 8, 0, U"RLC"_sv, U"H"_sv, &CPU_detail::rlc_<0x04> },
+				{ 0x05, 2, 8, 0, U"RLC"_sv, U"L"_sv, &CPU_detail::rlc_<0x05> },
 				{ 0x06, 2, 16, 0, U"RLC"_sv, U"HL"_sv, &CPU_detail::rlc_hl_ },
-				{ 0x07, 2, 8, 0, U"RLC"_sv, U"A"_sv, &CPU_detail::rlc_ },
-				{ 0x08, 2, 8, 0, U"RRC"_sv, U"B"_sv, &CPU_detail::rrc_ },
-				{ 0x09, 2, 8, 0, U"RRC"_sv, U"C"_sv, &CPU_detail::rrc_ },
-				{ 0x0a, 2, 8, 0, U"RRC"_sv, U"D"_sv, &CPU_detail::rrc_ },
-				{ 0x0b, 2, 8, 0, U"RRC"_sv, U"E"_sv, &CPU_detail::rrc_ },
-				{ 0x0c, 2, 8, 0, U"RRC"_sv, U"H"_sv, &CPU_detail::rrc_ },
-				{ 0x0d, 2, 8, 0, U"RRC"_sv, U"L"_sv, &CPU_detail::rrc_ },
+				{ 0x07, 2, 8, 0, U"RLC"_sv, U"A"_sv, &CPU_detail::rlc_<0x07> },
+				{ 0x08, 2, 8, 0, U"RRC"_sv, U"B"_sv, &CPU_detail::rrc_<0x08> },
+				{ 0x09, 2, 8, 0, U"RRC"_sv, U"C"_sv, &CPU_detail::rrc_<0x09> },
+				{ 0x0a, 2, 8, 0, U"RRC"_sv, U"D"_sv, &CPU_detail::rrc_<0x0a> },
+				{ 0x0b, 2, 8, 0, U"RRC"_sv, U"E"_sv, &CPU_detail::rrc_<0x0b> },
+				{ 0x0c, 2, 8, 0, U"RRC"_sv, U"H"_sv, &CPU_detail::rrc_<0x0c> },
+				{ 0x0d, 2, 8, 0, U"RRC"_sv, U"L"_sv, &CPU_detail::rrc_<0x0d> },
 				{ 0x0e, 2, 16, 0, U"RRC"_sv, U"HL"_sv, &CPU_detail::rrc_hl_ },
-				{ 0x0f, 2, 8, 0, U"RRC"_sv, U"A"_sv, &CPU_detail::rrc_ },
-				{ 0x10, 2, 8, 0, U"RL"_sv, U"B"_sv, &CPU_detail::rl_ },
-				{ 0x11, 2, 8, 0, U"RL"_sv, U"C"_sv, &CPU_detail::rl_ },
-				{ 0x12, 2, 8, 0, U"RL"_sv, U"D"_sv, &CPU_detail::rl_ },
-				{ 0x13, 2, 8, 0, U"RL"_sv, U"E"_sv, &CPU_detail::rl_ },
-				{ 0x14, 2, 8, 0, U"RL"_sv, U"H"_sv, &CPU_detail::rl_ },
-				{ 0x15, 2, 8, 0, U"RL"_sv, U"L"_sv, &CPU_detail::rl_ },
+				{ 0x0f, 2, 8, 0, U"RRC"_sv, U"A"_sv, &CPU_detail::rrc_<0x0f> },
+				{ 0x10, 2, 8, 0, U"RL"_sv, U"B"_sv, &CPU_detail::rl_<0x10> },
+				{ 0x11, 2, 8, 0, U"RL"_sv, U"C"_sv, &CPU_detail::rl_<0x11> },
+				{ 0x12, 2, 8, 0, U"RL"_sv, U"D"_sv, &CPU_detail::rl_<0x12> },
+				{ 0x13, 2, 8, 0, U"RL"_sv, U"E"_sv, &CPU_detail::rl_<0x13> },
+				{ 0x14, 2, 8, 0, U"RL"_sv, U"H"_sv, &CPU_detail::rl_<0x14> },
+				{ 0x15, 2, 8, 0, U"RL"_sv, U"L"_sv, &CPU_detail::rl_<0x15> },
 				{ 0x16, 2, 16, 0, U"RL"_sv, U"HL"_sv, &CPU_detail::rl_hl_ },
-				{ 0x17, 2, 8, 0, U"RL"_sv, U"A"_sv, &CPU_detail::rl_ },
-				{ 0x18, 2, 8, 0, U"RR"_sv, U"B"_sv, &CPU_detail::rr_ },
-				{ 0x19, 2, 8, 0, U"RR"_sv, U"C"_sv, &CPU_detail::rr_ },
-				{ 0x1a, 2, 8, 0, U"RR"_sv, U"D"_sv, &CPU_detail::rr_ },
-				{ 0x1b, 2, 8, 0, U"RR"_sv, U"E"_sv, &CPU_detail::rr_ },
-				{ 0x1c, 2, 8, 0, U"RR"_sv, U"H"_sv, &CPU_detail::rr_ },
-				{ 0x1d, 2, 8, 0, U"RR"_sv, U"L"_sv, &CPU_detail::rr_ },
+				{ 0x17, 2, 8, 0, U"RL"_sv, U"A"_sv, &CPU_detail::rl_<0x17> },
+				{ 0x18, 2, 8, 0, U"RR"_sv, U"B"_sv, &CPU_detail::rr_<0x18> },
+				{ 0x19, 2, 8, 0, U"RR"_sv, U"C"_sv, &CPU_detail::rr_<0x19> },
+				{ 0x1a, 2, 8, 0, U"RR"_sv, U"D"_sv, &CPU_detail::rr_<0x1a> },
+				{ 0x1b, 2, 8, 0, U"RR"_sv, U"E"_sv, &CPU_detail::rr_<0x1b> },
+				{ 0x1c, 2, 8, 0, U"RR"_sv, U"H"_sv, &CPU_detail::rr_<0x1c> },
+				{ 0x1d, 2, 8, 0, U"RR"_sv, U"L"_sv, &CPU_detail::rr_<0x1d> },
 				{ 0x1e, 2, 16, 0, U"RR"_sv, U"HL"_sv, &CPU_detail::rr_hl_ },
-				{ 0x1f, 2, 8, 0, U"RR"_sv, U"A"_sv, &CPU_detail::rr_ },
-				{ 0x20, 2, 8, 0, U"SLA"_sv, U"B"_sv, &CPU_detail::sla_ },
-				{ 0x21, 2, 8, 0, U"SLA"_sv, U"C"_sv, &CPU_detail::sla_ },
-				{ 0x22, 2, 8, 0, U"SLA"_sv, U"D"_sv, &CPU_detail::sla_ },
-				{ 0x23, 2, 8, 0, U"SLA"_sv, U"E"_sv, &CPU_detail::sla_ },
-				{ 0x24, 2, 8, 0, U"SLA"_sv, U"H"_sv, &CPU_detail::sla_ },
-				{ 0x25, 2, 8, 0, U"SLA"_sv, U"L"_sv, &CPU_detail::sla_ },
+				{ 0x1f, 2, 8, 0, U"RR"_sv, U"A"_sv, &CPU_detail::rr_<0x1f> },
+				{ 0x20, 2, 8, 0, U"SLA"_sv, U"B"_sv, &CPU_detail::sla_<0x20> },
+				{ 0x21, 2, 8, 0, U"SLA"_sv, U"C"_sv, &CPU_detail::sla_<0x21> },
+				{ 0x22, 2, 8, 0, U"SLA"_sv, U"D"_sv, &CPU_detail::sla_<0x22> },
+				{ 0x23, 2, 8, 0, U"SLA"_sv, U"E"_sv, &CPU_detail::sla_<0x23> },
+				{ 0x24, 2, 8, 0, U"SLA"_sv, U"H"_sv, &CPU_detail::sla_<0x24> },
+				{ 0x25, 2, 8, 0, U"SLA"_sv, U"L"_sv, &CPU_detail::sla_<0x25> },
 				{ 0x26, 2, 16, 0, U"SLA"_sv, U"HL"_sv, &CPU_detail::sla_hl_ },
-				{ 0x27, 2, 8, 0, U"SLA"_sv, U"A"_sv, &CPU_detail::sla_ },
-				{ 0x28, 2, 8, 0, U"SRA"_sv, U"B"_sv, &CPU_detail::sra_ },
-				{ 0x29, 2, 8, 0, U"SRA"_sv, U"C"_sv, &CPU_detail::sra_ },
-				{ 0x2a, 2, 8, 0, U"SRA"_sv, U"D"_sv, &CPU_detail::sra_ },
-				{ 0x2b, 2, 8, 0, U"SRA"_sv, U"E"_sv, &CPU_detail::sra_ },
-				{ 0x2c, 2, 8, 0, U"SRA"_sv, U"H"_sv, &CPU_detail::sra_ },
-				{ 0x2d, 2, 8, 0, U"SRA"_sv, U"L"_sv, &CPU_detail::sra_ },
+				{ 0x27, 2, 8, 0, U"SLA"_sv, U"A"_sv, &CPU_detail::sla_<0x27> },
+				{ 0x28, 2, 8, 0, U"SRA"_sv, U"B"_sv, &CPU_detail::sra_<0x28> },
+				{ 0x29, 2, 8, 0, U"SRA"_sv, U"C"_sv, &CPU_detail::sra_<0x29> },
+				{ 0x2a, 2, 8, 0, U"SRA"_sv, U"D"_sv, &CPU_detail::sra_<0x2a> },
+				{ 0x2b, 2, 8, 0, U"SRA"_sv, U"E"_sv, &CPU_detail::sra_<0x2b> },
+				{ 0x2c, 2, 8, 0, U"SRA"_sv, U"H"_sv, &CPU_detail::sra_<0x2c> },
+				{ 0x2d, 2, 8, 0, U"SRA"_sv, U"L"_sv, &CPU_detail::sra_<0x2d> },
 				{ 0x2e, 2, 16, 0, U"SRA"_sv, U"HL"_sv, &CPU_detail::sra_hl_ },
-				{ 0x2f, 2, 8, 0, U"SRA"_sv, U"A"_sv, &CPU_detail::sra_ },
-				{ 0x30, 2, 8, 0, U"SWAP"_sv, U"B"_sv, &CPU_detail::swap_ },
-				{ 0x31, 2, 8, 0, U"SWAP"_sv, U"C"_sv, &CPU_detail::swap_ },
-				{ 0x32, 2, 8, 0, U"SWAP"_sv, U"D"_sv, &CPU_detail::swap_ },
-				{ 0x33, 2, 8, 0, U"SWAP"_sv, U"E"_sv, &CPU_detail::swap_ },
-				{ 0x34, 2, 8, 0, U"SWAP"_sv, U"H"_sv, &CPU_detail::swap_ },
-				{ 0x35, 2, 8, 0, U"SWAP"_sv, U"L"_sv, &CPU_detail::swap_ },
+				{ 0x2f, 2, 8, 0, U"SRA"_sv, U"A"_sv, &CPU_detail::sra_<0x2f> },
+				{ 0x30, 2, 8, 0, U"SWAP"_sv, U"B"_sv, &CPU_detail::swap_<0x30> },
+				{ 0x31, 2, 8, 0, U"SWAP"_sv, U"C"_sv, &CPU_detail::swap_<0x31> },
+				{ 0x32, 2, 8, 0, U"SWAP"_sv, U"D"_sv, &CPU_detail::swap_<0x32> },
+				{ 0x33, 2, 8, 0, U"SWAP"_sv, U"E"_sv, &CPU_detail::swap_<0x33> },
+				{ 0x34, 2, 8, 0, U"SWAP"_sv, U"H"_sv, &CPU_detail::swap_<0x34> },
+				{ 0x35, 2, 8, 0, U"SWAP"_sv, U"L"_sv, &CPU_detail::swap_<0x35> },
 				{ 0x36, 2, 16, 0, U"SWAP"_sv, U"HL"_sv, &CPU_detail::swap_hl_ },
-				{ 0x37, 2, 8, 0, U"SWAP"_sv, U"A"_sv, &CPU_detail::swap_ },
-				{ 0x38, 2, 8, 0, U"SRL"_sv, U"B"_sv, &CPU_detail::srl_ },
-				{ 0x39, 2, 8, 0, U"SRL"_sv, U"C"_sv, &CPU_detail::srl_ },
-				{ 0x3a, 2, 8, 0, U"SRL"_sv, U"D"_sv, &CPU_detail::srl_ },
-				{ 0x3b, 2, 8, 0, U"SRL"_sv, U"E"_sv, &CPU_detail::srl_ },
-				{ 0x3c, 2, 8, 0, U"SRL"_sv, U"H"_sv, &CPU_detail::srl_ },
-				{ 0x3d, 2, 8, 0, U"SRL"_sv, U"L"_sv, &CPU_detail::srl_ },
+				{ 0x37, 2, 8, 0, U"SWAP"_sv, U"A"_sv, &CPU_detail::swap_<0x37> },
+				{ 0x38, 2, 8, 0, U"SRL"_sv, U"B"_sv, &CPU_detail::srl_<0x38> },
+				{ 0x39, 2, 8, 0, U"SRL"_sv, U"C"_sv, &CPU_detail::srl_<0x39> },
+				{ 0x3a, 2, 8, 0, U"SRL"_sv, U"D"_sv, &CPU_detail::srl_<0x3a> },
+				{ 0x3b, 2, 8, 0, U"SRL"_sv, U"E"_sv, &CPU_detail::srl_<0x3b> },
+				{ 0x3c, 2, 8, 0, U"SRL"_sv, U"H"_sv, &CPU_detail::srl_<0x3c> },
+				{ 0x3d, 2, 8, 0, U"SRL"_sv, U"L"_sv, &CPU_detail::srl_<0x3d> },
 				{ 0x3e, 2, 16, 0, U"SRL"_sv, U"HL"_sv, &CPU_detail::srl_hl_ },
-				{ 0x3f, 2, 8, 0, U"SRL"_sv, U"A"_sv, &CPU_detail::srl_ },
-				{ 0x40, 2, 8, 0, U"BIT"_sv, U"0,B"_sv, &CPU_detail::bit_ },
-				{ 0x41, 2, 8, 0, U"BIT"_sv, U"0,C"_sv, &CPU_detail::bit_ },
-				{ 0x42, 2, 8, 0, U"BIT"_sv, U"0,D"_sv, &CPU_detail::bit_ },
-				{ 0x43, 2, 8, 0, U"BIT"_sv, U"0,E"_sv, &CPU_detail::bit_ },
-				{ 0x44, 2, 8, 0, U"BIT"_sv, U"0,H"_sv, &CPU_detail::bit_ },
-				{ 0x45, 2, 8, 0, U"BIT"_sv, U"0,L"_sv, &CPU_detail::bit_ },
-				{ 0x46, 2, 12, 0, U"BIT"_sv, U"0,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x47, 2, 8, 0, U"BIT"_sv, U"0,A"_sv, &CPU_detail::bit_ },
-				{ 0x48, 2, 8, 0, U"BIT"_sv, U"1,B"_sv, &CPU_detail::bit_ },
-				{ 0x49, 2, 8, 0, U"BIT"_sv, U"1,C"_sv, &CPU_detail::bit_ },
-				{ 0x4a, 2, 8, 0, U"BIT"_sv, U"1,D"_sv, &CPU_detail::bit_ },
-				{ 0x4b, 2, 8, 0, U"BIT"_sv, U"1,E"_sv, &CPU_detail::bit_ },
-				{ 0x4c, 2, 8, 0, U"BIT"_sv, U"1,H"_sv, &CPU_detail::bit_ },
-				{ 0x4d, 2, 8, 0, U"BIT"_sv, U"1,L"_sv, &CPU_detail::bit_ },
-				{ 0x4e, 2, 12, 0, U"BIT"_sv, U"1,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x4f, 2, 8, 0, U"BIT"_sv, U"1,A"_sv, &CPU_detail::bit_ },
-				{ 0x50, 2, 8, 0, U"BIT"_sv, U"2,B"_sv, &CPU_detail::bit_ },
-				{ 0x51, 2, 8, 0, U"BIT"_sv, U"2,C"_sv, &CPU_detail::bit_ },
-				{ 0x52, 2, 8, 0, U"BIT"_sv, U"2,D"_sv, &CPU_detail::bit_ },
-				{ 0x53, 2, 8, 0, U"BIT"_sv, U"2,E"_sv, &CPU_detail::bit_ },
-				{ 0x54, 2, 8, 0, U"BIT"_sv, U"2,H"_sv, &CPU_detail::bit_ },
-				{ 0x55, 2, 8, 0, U"BIT"_sv, U"2,L"_sv, &CPU_detail::bit_ },
-				{ 0x56, 2, 12, 0, U"BIT"_sv, U"2,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x57, 2, 8, 0, U"BIT"_sv, U"2,A"_sv, &CPU_detail::bit_ },
-				{ 0x58, 2, 8, 0, U"BIT"_sv, U"3,B"_sv, &CPU_detail::bit_ },
-				{ 0x59, 2, 8, 0, U"BIT"_sv, U"3,C"_sv, &CPU_detail::bit_ },
-				{ 0x5a, 2, 8, 0, U"BIT"_sv, U"3,D"_sv, &CPU_detail::bit_ },
-				{ 0x5b, 2, 8, 0, U"BIT"_sv, U"3,E"_sv, &CPU_detail::bit_ },
-				{ 0x5c, 2, 8, 0, U"BIT"_sv, U"3,H"_sv, &CPU_detail::bit_ },
-				{ 0x5d, 2, 8, 0, U"BIT"_sv, U"3,L"_sv, &CPU_detail::bit_ },
-				{ 0x5e, 2, 12, 0, U"BIT"_sv, U"3,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x5f, 2, 8, 0, U"BIT"_sv, U"3,A"_sv, &CPU_detail::bit_ },
-				{ 0x60, 2, 8, 0, U"BIT"_sv, U"4,B"_sv, &CPU_detail::bit_ },
-				{ 0x61, 2, 8, 0, U"BIT"_sv, U"4,C"_sv, &CPU_detail::bit_ },
-				{ 0x62, 2, 8, 0, U"BIT"_sv, U"4,D"_sv, &CPU_detail::bit_ },
-				{ 0x63, 2, 8, 0, U"BIT"_sv, U"4,E"_sv, &CPU_detail::bit_ },
-				{ 0x64, 2, 8, 0, U"BIT"_sv, U"4,H"_sv, &CPU_detail::bit_ },
-				{ 0x65, 2, 8, 0, U"BIT"_sv, U"4,L"_sv, &CPU_detail::bit_ },
-				{ 0x66, 2, 12, 0, U"BIT"_sv, U"4,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x67, 2, 8, 0, U"BIT"_sv, U"4,A"_sv, &CPU_detail::bit_ },
-				{ 0x68, 2, 8, 0, U"BIT"_sv, U"5,B"_sv, &CPU_detail::bit_ },
-				{ 0x69, 2, 8, 0, U"BIT"_sv, U"5,C"_sv, &CPU_detail::bit_ },
-				{ 0x6a, 2, 8, 0, U"BIT"_sv, U"5,D"_sv, &CPU_detail::bit_ },
-				{ 0x6b, 2, 8, 0, U"BIT"_sv, U"5,E"_sv, &CPU_detail::bit_ },
-				{ 0x6c, 2, 8, 0, U"BIT"_sv, U"5,H"_sv, &CPU_detail::bit_ },
-				{ 0x6d, 2, 8, 0, U"BIT"_sv, U"5,L"_sv, &CPU_detail::bit_ },
-				{ 0x6e, 2, 12, 0, U"BIT"_sv, U"5,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x6f, 2, 8, 0, U"BIT"_sv, U"5,A"_sv, &CPU_detail::bit_ },
-				{ 0x70, 2, 8, 0, U"BIT"_sv, U"6,B"_sv, &CPU_detail::bit_ },
-				{ 0x71, 2, 8, 0, U"BIT"_sv, U"6,C"_sv, &CPU_detail::bit_ },
-				{ 0x72, 2, 8, 0, U"BIT"_sv, U"6,D"_sv, &CPU_detail::bit_ },
-				{ 0x73, 2, 8, 0, U"BIT"_sv, U"6,E"_sv, &CPU_detail::bit_ },
-				{ 0x74, 2, 8, 0, U"BIT"_sv, U"6,H"_sv, &CPU_detail::bit_ },
-				{ 0x75, 2, 8, 0, U"BIT"_sv, U"6,L"_sv, &CPU_detail::bit_ },
-				{ 0x76, 2, 12, 0, U"BIT"_sv, U"6,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x77, 2, 8, 0, U"BIT"_sv, U"6,A"_sv, &CPU_detail::bit_ },
-				{ 0x78, 2, 8, 0, U"BIT"_sv, U"7,B"_sv, &CPU_detail::bit_ },
-				{ 0x79, 2, 8, 0, U"BIT"_sv, U"7,C"_sv, &CPU_detail::bit_ },
-				{ 0x7a, 2, 8, 0, U"BIT"_sv, U"7,D"_sv, &CPU_detail::bit_ },
-				{ 0x7b, 2, 8, 0, U"BIT"_sv, U"7,E"_sv, &CPU_detail::bit_ },
-				{ 0x7c, 2, 8, 0, U"BIT"_sv, U"7,H"_sv, &CPU_detail::bit_ },
-				{ 0x7d, 2, 8, 0, U"BIT"_sv, U"7,L"_sv, &CPU_detail::bit_ },
-				{ 0x7e, 2, 12, 0, U"BIT"_sv, U"7,HL"_sv, &CPU_detail::bit_hl_ },
-				{ 0x7f, 2, 8, 0, U"BIT"_sv, U"7,A"_sv, &CPU_detail::bit_ },
-				{ 0x80, 2, 8, 0, U"RES"_sv, U"0,B"_sv, &CPU_detail::res_ },
-				{ 0x81, 2, 8, 0, U"RES"_sv, U"0,C"_sv, &CPU_detail::res_ },
-				{ 0x82, 2, 8, 0, U"RES"_sv, U"0,D"_sv, &CPU_detail::res_ },
-				{ 0x83, 2, 8, 0, U"RES"_sv, U"0,E"_sv, &CPU_detail::res_ },
-				{ 0x84, 2, 8, 0, U"RES"_sv, U"0,H"_sv, &CPU_detail::res_ },
-				{ 0x85, 2, 8, 0, U"RES"_sv, U"0,L"_sv, &CPU_detail::res_ },
-				{ 0x86, 2, 16, 0, U"RES"_sv, U"0,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0x87, 2, 8, 0, U"RES"_sv, U"0,A"_sv, &CPU_detail::res_ },
-				{ 0x88, 2, 8, 0, U"RES"_sv, U"1,B"_sv, &CPU_detail::res_ },
-				{ 0x89, 2, 8, 0, U"RES"_sv, U"1,C"_sv, &CPU_detail::res_ },
-				{ 0x8a, 2, 8, 0, U"RES"_sv, U"1,D"_sv, &CPU_detail::res_ },
-				{ 0x8b, 2, 8, 0, U"RES"_sv, U"1,E"_sv, &CPU_detail::res_ },
-				{ 0x8c, 2, 8, 0, U"RES"_sv, U"1,H"_sv, &CPU_detail::res_ },
-				{ 0x8d, 2, 8, 0, U"RES"_sv, U"1,L"_sv, &CPU_detail::res_ },
-				{ 0x8e, 2, 16, 0, U"RES"_sv, U"1,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0x8f, 2, 8, 0, U"RES"_sv, U"1,A"_sv, &CPU_detail::res_ },
-				{ 0x90, 2, 8, 0, U"RES"_sv, U"2,B"_sv, &CPU_detail::res_ },
-				{ 0x91, 2, 8, 0, U"RES"_sv, U"2,C"_sv, &CPU_detail::res_ },
-				{ 0x92, 2, 8, 0, U"RES"_sv, U"2,D"_sv, &CPU_detail::res_ },
-				{ 0x93, 2, 8, 0, U"RES"_sv, U"2,E"_sv, &CPU_detail::res_ },
-				{ 0x94, 2, 8, 0, U"RES"_sv, U"2,H"_sv, &CPU_detail::res_ },
-				{ 0x95, 2, 8, 0, U"RES"_sv, U"2,L"_sv, &CPU_detail::res_ },
-				{ 0x96, 2, 16, 0, U"RES"_sv, U"2,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0x97, 2, 8, 0, U"RES"_sv, U"2,A"_sv, &CPU_detail::res_ },
-				{ 0x98, 2, 8, 0, U"RES"_sv, U"3,B"_sv, &CPU_detail::res_ },
-				{ 0x99, 2, 8, 0, U"RES"_sv, U"3,C"_sv, &CPU_detail::res_ },
-				{ 0x9a, 2, 8, 0, U"RES"_sv, U"3,D"_sv, &CPU_detail::res_ },
-				{ 0x9b, 2, 8, 0, U"RES"_sv, U"3,E"_sv, &CPU_detail::res_ },
-				{ 0x9c, 2, 8, 0, U"RES"_sv, U"3,H"_sv, &CPU_detail::res_ },
-				{ 0x9d, 2, 8, 0, U"RES"_sv, U"3,L"_sv, &CPU_detail::res_ },
-				{ 0x9e, 2, 16, 0, U"RES"_sv, U"3,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0x9f, 2, 8, 0, U"RES"_sv, U"3,A"_sv, &CPU_detail::res_ },
-				{ 0xa0, 2, 8, 0, U"RES"_sv, U"4,B"_sv, &CPU_detail::res_ },
-				{ 0xa1, 2, 8, 0, U"RES"_sv, U"4,C"_sv, &CPU_detail::res_ },
-				{ 0xa2, 2, 8, 0, U"RES"_sv, U"4,D"_sv, &CPU_detail::res_ },
-				{ 0xa3, 2, 8, 0, U"RES"_sv, U"4,E"_sv, &CPU_detail::res_ },
-				{ 0xa4, 2, 8, 0, U"RES"_sv, U"4,H"_sv, &CPU_detail::res_ },
-				{ 0xa5, 2, 8, 0, U"RES"_sv, U"4,L"_sv, &CPU_detail::res_ },
-				{ 0xa6, 2, 16, 0, U"RES"_sv, U"4,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0xa7, 2, 8, 0, U"RES"_sv, U"4,A"_sv, &CPU_detail::res_ },
-				{ 0xa8, 2, 8, 0, U"RES"_sv, U"5,B"_sv, &CPU_detail::res_ },
-				{ 0xa9, 2, 8, 0, U"RES"_sv, U"5,C"_sv, &CPU_detail::res_ },
-				{ 0xaa, 2, 8, 0, U"RES"_sv, U"5,D"_sv, &CPU_detail::res_ },
-				{ 0xab, 2, 8, 0, U"RES"_sv, U"5,E"_sv, &CPU_detail::res_ },
-				{ 0xac, 2, 8, 0, U"RES"_sv, U"5,H"_sv, &CPU_detail::res_ },
-				{ 0xad, 2, 8, 0, U"RES"_sv, U"5,L"_sv, &CPU_detail::res_ },
-				{ 0xae, 2, 16, 0, U"RES"_sv, U"5,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0xaf, 2, 8, 0, U"RES"_sv, U"5,A"_sv, &CPU_detail::res_ },
-				{ 0xb0, 2, 8, 0, U"RES"_sv, U"6,B"_sv, &CPU_detail::res_ },
-				{ 0xb1, 2, 8, 0, U"RES"_sv, U"6,C"_sv, &CPU_detail::res_ },
-				{ 0xb2, 2, 8, 0, U"RES"_sv, U"6,D"_sv, &CPU_detail::res_ },
-				{ 0xb3, 2, 8, 0, U"RES"_sv, U"6,E"_sv, &CPU_detail::res_ },
-				{ 0xb4, 2, 8, 0, U"RES"_sv, U"6,H"_sv, &CPU_detail::res_ },
-				{ 0xb5, 2, 8, 0, U"RES"_sv, U"6,L"_sv, &CPU_detail::res_ },
-				{ 0xb6, 2, 16, 0, U"RES"_sv, U"6,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0xb7, 2, 8, 0, U"RES"_sv, U"6,A"_sv, &CPU_detail::res_ },
-				{ 0xb8, 2, 8, 0, U"RES"_sv, U"7,B"_sv, &CPU_detail::res_ },
-				{ 0xb9, 2, 8, 0, U"RES"_sv, U"7,C"_sv, &CPU_detail::res_ },
-				{ 0xba, 2, 8, 0, U"RES"_sv, U"7,D"_sv, &CPU_detail::res_ },
-				{ 0xbb, 2, 8, 0, U"RES"_sv, U"7,E"_sv, &CPU_detail::res_ },
-				{ 0xbc, 2, 8, 0, U"RES"_sv, U"7,H"_sv, &CPU_detail::res_ },
-				{ 0xbd, 2, 8, 0, U"RES"_sv, U"7,L"_sv, &CPU_detail::res_ },
-				{ 0xbe, 2, 16, 0, U"RES"_sv, U"7,HL"_sv, &CPU_detail::res_hl_ },
-				{ 0xbf, 2, 8, 0, U"RES"_sv, U"7,A"_sv, &CPU_detail::res_ },
-				{ 0xc0, 2, 8, 0, U"SET"_sv, U"0,B"_sv, &CPU_detail::set_ },
-				{ 0xc1, 2, 8, 0, U"SET"_sv, U"0,C"_sv, &CPU_detail::set_ },
-				{ 0xc2, 2, 8, 0, U"SET"_sv, U"0,D"_sv, &CPU_detail::set_ },
-				{ 0xc3, 2, 8, 0, U"SET"_sv, U"0,E"_sv, &CPU_detail::set_ },
-				{ 0xc4, 2, 8, 0, U"SET"_sv, U"0,H"_sv, &CPU_detail::set_ },
-				{ 0xc5, 2, 8, 0, U"SET"_sv, U"0,L"_sv, &CPU_detail::set_ },
-				{ 0xc6, 2, 16, 0, U"SET"_sv, U"0,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xc7, 2, 8, 0, U"SET"_sv, U"0,A"_sv, &CPU_detail::set_ },
-				{ 0xc8, 2, 8, 0, U"SET"_sv, U"1,B"_sv, &CPU_detail::set_ },
-				{ 0xc9, 2, 8, 0, U"SET"_sv, U"1,C"_sv, &CPU_detail::set_ },
-				{ 0xca, 2, 8, 0, U"SET"_sv, U"1,D"_sv, &CPU_detail::set_ },
-				{ 0xcb, 2, 8, 0, U"SET"_sv, U"1,E"_sv, &CPU_detail::set_ },
-				{ 0xcc, 2, 8, 0, U"SET"_sv, U"1,H"_sv, &CPU_detail::set_ },
-				{ 0xcd, 2, 8, 0, U"SET"_sv, U"1,L"_sv, &CPU_detail::set_ },
-				{ 0xce, 2, 16, 0, U"SET"_sv, U"1,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xcf, 2, 8, 0, U"SET"_sv, U"1,A"_sv, &CPU_detail::set_ },
-				{ 0xd0, 2, 8, 0, U"SET"_sv, U"2,B"_sv, &CPU_detail::set_ },
-				{ 0xd1, 2, 8, 0, U"SET"_sv, U"2,C"_sv, &CPU_detail::set_ },
-				{ 0xd2, 2, 8, 0, U"SET"_sv, U"2,D"_sv, &CPU_detail::set_ },
-				{ 0xd3, 2, 8, 0, U"SET"_sv, U"2,E"_sv, &CPU_detail::set_ },
-				{ 0xd4, 2, 8, 0, U"SET"_sv, U"2,H"_sv, &CPU_detail::set_ },
-				{ 0xd5, 2, 8, 0, U"SET"_sv, U"2,L"_sv, &CPU_detail::set_ },
-				{ 0xd6, 2, 16, 0, U"SET"_sv, U"2,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xd7, 2, 8, 0, U"SET"_sv, U"2,A"_sv, &CPU_detail::set_ },
-				{ 0xd8, 2, 8, 0, U"SET"_sv, U"3,B"_sv, &CPU_detail::set_ },
-				{ 0xd9, 2, 8, 0, U"SET"_sv, U"3,C"_sv, &CPU_detail::set_ },
-				{ 0xda, 2, 8, 0, U"SET"_sv, U"3,D"_sv, &CPU_detail::set_ },
-				{ 0xdb, 2, 8, 0, U"SET"_sv, U"3,E"_sv, &CPU_detail::set_ },
-				{ 0xdc, 2, 8, 0, U"SET"_sv, U"3,H"_sv, &CPU_detail::set_ },
-				{ 0xdd, 2, 8, 0, U"SET"_sv, U"3,L"_sv, &CPU_detail::set_ },
-				{ 0xde, 2, 16, 0, U"SET"_sv, U"3,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xdf, 2, 8, 0, U"SET"_sv, U"3,A"_sv, &CPU_detail::set_ },
-				{ 0xe0, 2, 8, 0, U"SET"_sv, U"4,B"_sv, &CPU_detail::set_ },
-				{ 0xe1, 2, 8, 0, U"SET"_sv, U"4,C"_sv, &CPU_detail::set_ },
-				{ 0xe2, 2, 8, 0, U"SET"_sv, U"4,D"_sv, &CPU_detail::set_ },
-				{ 0xe3, 2, 8, 0, U"SET"_sv, U"4,E"_sv, &CPU_detail::set_ },
-				{ 0xe4, 2, 8, 0, U"SET"_sv, U"4,H"_sv, &CPU_detail::set_ },
-				{ 0xe5, 2, 8, 0, U"SET"_sv, U"4,L"_sv, &CPU_detail::set_ },
-				{ 0xe6, 2, 16, 0, U"SET"_sv, U"4,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xe7, 2, 8, 0, U"SET"_sv, U"4,A"_sv, &CPU_detail::set_ },
-				{ 0xe8, 2, 8, 0, U"SET"_sv, U"5,B"_sv, &CPU_detail::set_ },
-				{ 0xe9, 2, 8, 0, U"SET"_sv, U"5,C"_sv, &CPU_detail::set_ },
-				{ 0xea, 2, 8, 0, U"SET"_sv, U"5,D"_sv, &CPU_detail::set_ },
-				{ 0xeb, 2, 8, 0, U"SET"_sv, U"5,E"_sv, &CPU_detail::set_ },
-				{ 0xec, 2, 8, 0, U"SET"_sv, U"5,H"_sv, &CPU_detail::set_ },
-				{ 0xed, 2, 8, 0, U"SET"_sv, U"5,L"_sv, &CPU_detail::set_ },
-				{ 0xee, 2, 16, 0, U"SET"_sv, U"5,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xef, 2, 8, 0, U"SET"_sv, U"5,A"_sv, &CPU_detail::set_ },
-				{ 0xf0, 2, 8, 0, U"SET"_sv, U"6,B"_sv, &CPU_detail::set_ },
-				{ 0xf1, 2, 8, 0, U"SET"_sv, U"6,C"_sv, &CPU_detail::set_ },
-				{ 0xf2, 2, 8, 0, U"SET"_sv, U"6,D"_sv, &CPU_detail::set_ },
-				{ 0xf3, 2, 8, 0, U"SET"_sv, U"6,E"_sv, &CPU_detail::set_ },
-				{ 0xf4, 2, 8, 0, U"SET"_sv, U"6,H"_sv, &CPU_detail::set_ },
-				{ 0xf5, 2, 8, 0, U"SET"_sv, U"6,L"_sv, &CPU_detail::set_ },
-				{ 0xf6, 2, 16, 0, U"SET"_sv, U"6,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xf7, 2, 8, 0, U"SET"_sv, U"6,A"_sv, &CPU_detail::set_ },
-				{ 0xf8, 2, 8, 0, U"SET"_sv, U"7,B"_sv, &CPU_detail::set_ },
-				{ 0xf9, 2, 8, 0, U"SET"_sv, U"7,C"_sv, &CPU_detail::set_ },
-				{ 0xfa, 2, 8, 0, U"SET"_sv, U"7,D"_sv, &CPU_detail::set_ },
-				{ 0xfb, 2, 8, 0, U"SET"_sv, U"7,E"_sv, &CPU_detail::set_ },
-				{ 0xfc, 2, 8, 0, U"SET"_sv, U"7,H"_sv, &CPU_detail::set_ },
-				{ 0xfd, 2, 8, 0, U"SET"_sv, U"7,L"_sv, &CPU_detail::set_ },
-				{ 0xfe, 2, 16, 0, U"SET"_sv, U"7,HL"_sv, &CPU_detail::set_hl_ },
-				{ 0xff, 2, 8, 0, U"SET"_sv, U"7,A"_sv, &CPU_detail::set_ },
+				{ 0x3f, 2, 8, 0, U"SRL"_sv, U"A"_sv, &CPU_detail::srl_<0x3f> },
+				{ 0x40, 2, 8, 0, U"BIT"_sv, U"0,B"_sv, &CPU_detail::bit_<0x40> },
+				{ 0x41, 2, 8, 0, U"BIT"_sv, U"0,C"_sv, &CPU_detail::bit_<0x41> },
+				{ 0x42, 2, 8, 0, U"BIT"_sv, U"0,D"_sv, &CPU_detail::bit_<0x42> },
+				{ 0x43, 2, 8, 0, U"BIT"_sv, U"0,E"_sv, &CPU_detail::bit_<0x43> },
+				{ 0x44, 2, 8, 0, U"BIT"_sv, U"0,H"_sv, &CPU_detail::bit_<0x44> },
+				{ 0x45, 2, 8, 0, U"BIT"_sv, U"0,L"_sv, &CPU_detail::bit_<0x45> },
+				{ 0x46, 2, 12, 0, U"BIT"_sv, U"0,HL"_sv, &CPU_detail::bit_hl_<0x46> },
+				{ 0x47, 2, 8, 0, U"BIT"_sv, U"0,A"_sv, &CPU_detail::bit_<0x47> },
+				{ 0x48, 2, 8, 0, U"BIT"_sv, U"1,B"_sv, &CPU_detail::bit_<0x48> },
+				{ 0x49, 2, 8, 0, U"BIT"_sv, U"1,C"_sv, &CPU_detail::bit_<0x49> },
+				{ 0x4a, 2, 8, 0, U"BIT"_sv, U"1,D"_sv, &CPU_detail::bit_<0x4a> },
+				{ 0x4b, 2, 8, 0, U"BIT"_sv, U"1,E"_sv, &CPU_detail::bit_<0x4b> },
+				{ 0x4c, 2, 8, 0, U"BIT"_sv, U"1,H"_sv, &CPU_detail::bit_<0x4c> },
+				{ 0x4d, 2, 8, 0, U"BIT"_sv, U"1,L"_sv, &CPU_detail::bit_<0x4d> },
+				{ 0x4e, 2, 12, 0, U"BIT"_sv, U"1,HL"_sv, &CPU_detail::bit_hl_<0x4e> },
+				{ 0x4f, 2, 8, 0, U"BIT"_sv, U"1,A"_sv, &CPU_detail::bit_<0x4f> },
+				{ 0x50, 2, 8, 0, U"BIT"_sv, U"2,B"_sv, &CPU_detail::bit_<0x50> },
+				{ 0x51, 2, 8, 0, U"BIT"_sv, U"2,C"_sv, &CPU_detail::bit_<0x51> },
+				{ 0x52, 2, 8, 0, U"BIT"_sv, U"2,D"_sv, &CPU_detail::bit_<0x52> },
+				{ 0x53, 2, 8, 0, U"BIT"_sv, U"2,E"_sv, &CPU_detail::bit_<0x53> },
+				{ 0x54, 2, 8, 0, U"BIT"_sv, U"2,H"_sv, &CPU_detail::bit_<0x54> },
+				{ 0x55, 2, 8, 0, U"BIT"_sv, U"2,L"_sv, &CPU_detail::bit_<0x55> },
+				{ 0x56, 2, 12, 0, U"BIT"_sv, U"2,HL"_sv, &CPU_detail::bit_hl_<0x56> },
+				{ 0x57, 2, 8, 0, U"BIT"_sv, U"2,A"_sv, &CPU_detail::bit_<0x57> },
+				{ 0x58, 2, 8, 0, U"BIT"_sv, U"3,B"_sv, &CPU_detail::bit_<0x58> },
+				{ 0x59, 2, 8, 0, U"BIT"_sv, U"3,C"_sv, &CPU_detail::bit_<0x59> },
+				{ 0x5a, 2, 8, 0, U"BIT"_sv, U"3,D"_sv, &CPU_detail::bit_<0x5a> },
+				{ 0x5b, 2, 8, 0, U"BIT"_sv, U"3,E"_sv, &CPU_detail::bit_<0x5b> },
+				{ 0x5c, 2, 8, 0, U"BIT"_sv, U"3,H"_sv, &CPU_detail::bit_<0x5c> },
+				{ 0x5d, 2, 8, 0, U"BIT"_sv, U"3,L"_sv, &CPU_detail::bit_<0x5d> },
+				{ 0x5e, 2, 12, 0, U"BIT"_sv, U"3,HL"_sv, &CPU_detail::bit_hl_<0x5e> },
+				{ 0x5f, 2, 8, 0, U"BIT"_sv, U"3,A"_sv, &CPU_detail::bit_<0x5f> },
+				{ 0x60, 2, 8, 0, U"BIT"_sv, U"4,B"_sv, &CPU_detail::bit_<0x60> },
+				{ 0x61, 2, 8, 0, U"BIT"_sv, U"4,C"_sv, &CPU_detail::bit_<0x61> },
+				{ 0x62, 2, 8, 0, U"BIT"_sv, U"4,D"_sv, &CPU_detail::bit_<0x62> },
+				{ 0x63, 2, 8, 0, U"BIT"_sv, U"4,E"_sv, &CPU_detail::bit_<0x63> },
+				{ 0x64, 2, 8, 0, U"BIT"_sv, U"4,H"_sv, &CPU_detail::bit_<0x64> },
+				{ 0x65, 2, 8, 0, U"BIT"_sv, U"4,L"_sv, &CPU_detail::bit_<0x65> },
+				{ 0x66, 2, 12, 0, U"BIT"_sv, U"4,HL"_sv, &CPU_detail::bit_hl_<0x66> },
+				{ 0x67, 2, 8, 0, U"BIT"_sv, U"4,A"_sv, &CPU_detail::bit_<0x67> },
+				{ 0x68, 2, 8, 0, U"BIT"_sv, U"5,B"_sv, &CPU_detail::bit_<0x68> },
+				{ 0x69, 2, 8, 0, U"BIT"_sv, U"5,C"_sv, &CPU_detail::bit_<0x69> },
+				{ 0x6a, 2, 8, 0, U"BIT"_sv, U"5,D"_sv, &CPU_detail::bit_<0x6a> },
+				{ 0x6b, 2, 8, 0, U"BIT"_sv, U"5,E"_sv, &CPU_detail::bit_<0x6b> },
+				{ 0x6c, 2, 8, 0, U"BIT"_sv, U"5,H"_sv, &CPU_detail::bit_<0x6c> },
+				{ 0x6d, 2, 8, 0, U"BIT"_sv, U"5,L"_sv, &CPU_detail::bit_<0x6d> },
+				{ 0x6e, 2, 12, 0, U"BIT"_sv, U"5,HL"_sv, &CPU_detail::bit_hl_<0x6e> },
+				{ 0x6f, 2, 8, 0, U"BIT"_sv, U"5,A"_sv, &CPU_detail::bit_<0x6f> },
+				{ 0x70, 2, 8, 0, U"BIT"_sv, U"6,B"_sv, &CPU_detail::bit_<0x70> },
+				{ 0x71, 2, 8, 0, U"BIT"_sv, U"6,C"_sv, &CPU_detail::bit_<0x71> },
+				{ 0x72, 2, 8, 0, U"BIT"_sv, U"6,D"_sv, &CPU_detail::bit_<0x72> },
+				{ 0x73, 2, 8, 0, U"BIT"_sv, U"6,E"_sv, &CPU_detail::bit_<0x73> },
+				{ 0x74, 2, 8, 0, U"BIT"_sv, U"6,H"_sv, &CPU_detail::bit_<0x74> },
+				{ 0x75, 2, 8, 0, U"BIT"_sv, U"6,L"_sv, &CPU_detail::bit_<0x75> },
+				{ 0x76, 2, 12, 0, U"BIT"_sv, U"6,HL"_sv, &CPU_detail::bit_hl_<0x76> },
+				{ 0x77, 2, 8, 0, U"BIT"_sv, U"6,A"_sv, &CPU_detail::bit_<0x77> },
+				{ 0x78, 2, 8, 0, U"BIT"_sv, U"7,B"_sv, &CPU_detail::bit_<0x78> },
+				{ 0x79, 2, 8, 0, U"BIT"_sv, U"7,C"_sv, &CPU_detail::bit_<0x79> },
+				{ 0x7a, 2, 8, 0, U"BIT"_sv, U"7,D"_sv, &CPU_detail::bit_<0x7a> },
+				{ 0x7b, 2, 8, 0, U"BIT"_sv, U"7,E"_sv, &CPU_detail::bit_<0x7b> },
+				{ 0x7c, 2, 8, 0, U"BIT"_sv, U"7,H"_sv, &CPU_detail::bit_<0x7c> },
+				{ 0x7d, 2, 8, 0, U"BIT"_sv, U"7,L"_sv, &CPU_detail::bit_<0x7d> },
+				{ 0x7e, 2, 12, 0, U"BIT"_sv, U"7,HL"_sv, &CPU_detail::bit_hl_<0x7e> },
+				{ 0x7f, 2, 8, 0, U"BIT"_sv, U"7,A"_sv, &CPU_detail::bit_<0x7f> },
+				{ 0x80, 2, 8, 0, U"RES"_sv, U"0,B"_sv, &CPU_detail::res_<0x80> },
+				{ 0x81, 2, 8, 0, U"RES"_sv, U"0,C"_sv, &CPU_detail::res_<0x81> },
+				{ 0x82, 2, 8, 0, U"RES"_sv, U"0,D"_sv, &CPU_detail::res_<0x82> },
+				{ 0x83, 2, 8, 0, U"RES"_sv, U"0,E"_sv, &CPU_detail::res_<0x83> },
+				{ 0x84, 2, 8, 0, U"RES"_sv, U"0,H"_sv, &CPU_detail::res_<0x84> },
+				{ 0x85, 2, 8, 0, U"RES"_sv, U"0,L"_sv, &CPU_detail::res_<0x85> },
+				{ 0x86, 2, 16, 0, U"RES"_sv, U"0,HL"_sv, &CPU_detail::res_hl_<0x86> },
+				{ 0x87, 2, 8, 0, U"RES"_sv, U"0,A"_sv, &CPU_detail::res_<0x87> },
+				{ 0x88, 2, 8, 0, U"RES"_sv, U"1,B"_sv, &CPU_detail::res_<0x88> },
+				{ 0x89, 2, 8, 0, U"RES"_sv, U"1,C"_sv, &CPU_detail::res_<0x89> },
+				{ 0x8a, 2, 8, 0, U"RES"_sv, U"1,D"_sv, &CPU_detail::res_<0x8a> },
+				{ 0x8b, 2, 8, 0, U"RES"_sv, U"1,E"_sv, &CPU_detail::res_<0x8b> },
+				{ 0x8c, 2, 8, 0, U"RES"_sv, U"1,H"_sv, &CPU_detail::res_<0x8c> },
+				{ 0x8d, 2, 8, 0, U"RES"_sv, U"1,L"_sv, &CPU_detail::res_<0x8d> },
+				{ 0x8e, 2, 16, 0, U"RES"_sv, U"1,HL"_sv, &CPU_detail::res_hl_<0x8e> },
+				{ 0x8f, 2, 8, 0, U"RES"_sv, U"1,A"_sv, &CPU_detail::res_<0x8f> },
+				{ 0x90, 2, 8, 0, U"RES"_sv, U"2,B"_sv, &CPU_detail::res_<0x90> },
+				{ 0x91, 2, 8, 0, U"RES"_sv, U"2,C"_sv, &CPU_detail::res_<0x91> },
+				{ 0x92, 2, 8, 0, U"RES"_sv, U"2,D"_sv, &CPU_detail::res_<0x92> },
+				{ 0x93, 2, 8, 0, U"RES"_sv, U"2,E"_sv, &CPU_detail::res_<0x93> },
+				{ 0x94, 2, 8, 0, U"RES"_sv, U"2,H"_sv, &CPU_detail::res_<0x94> },
+				{ 0x95, 2, 8, 0, U"RES"_sv, U"2,L"_sv, &CPU_detail::res_<0x95> },
+				{ 0x96, 2, 16, 0, U"RES"_sv, U"2,HL"_sv, &CPU_detail::res_hl_<0x96> },
+				{ 0x97, 2, 8, 0, U"RES"_sv, U"2,A"_sv, &CPU_detail::res_<0x97> },
+				{ 0x98, 2, 8, 0, U"RES"_sv, U"3,B"_sv, &CPU_detail::res_<0x98> },
+				{ 0x99, 2, 8, 0, U"RES"_sv, U"3,C"_sv, &CPU_detail::res_<0x99> },
+				{ 0x9a, 2, 8, 0, U"RES"_sv, U"3,D"_sv, &CPU_detail::res_<0x9a> },
+				{ 0x9b, 2, 8, 0, U"RES"_sv, U"3,E"_sv, &CPU_detail::res_<0x9b> },
+				{ 0x9c, 2, 8, 0, U"RES"_sv, U"3,H"_sv, &CPU_detail::res_<0x9c> },
+				{ 0x9d, 2, 8, 0, U"RES"_sv, U"3,L"_sv, &CPU_detail::res_<0x9d> },
+				{ 0x9e, 2, 16, 0, U"RES"_sv, U"3,HL"_sv, &CPU_detail::res_hl_<0x9e> },
+				{ 0x9f, 2, 8, 0, U"RES"_sv, U"3,A"_sv, &CPU_detail::res_<0x9f> },
+				{ 0xa0, 2, 8, 0, U"RES"_sv, U"4,B"_sv, &CPU_detail::res_<0xa0> },
+				{ 0xa1, 2, 8, 0, U"RES"_sv, U"4,C"_sv, &CPU_detail::res_<0xa1> },
+				{ 0xa2, 2, 8, 0, U"RES"_sv, U"4,D"_sv, &CPU_detail::res_<0xa2> },
+				{ 0xa3, 2, 8, 0, U"RES"_sv, U"4,E"_sv, &CPU_detail::res_<0xa3> },
+				{ 0xa4, 2, 8, 0, U"RES"_sv, U"4,H"_sv, &CPU_detail::res_<0xa4> },
+				{ 0xa5, 2, 8, 0, U"RES"_sv, U"4,L"_sv, &CPU_detail::res_<0xa5> },
+				{ 0xa6, 2, 16, 0, U"RES"_sv, U"4,HL"_sv, &CPU_detail::res_hl_<0xa6> },
+				{ 0xa7, 2, 8, 0, U"RES"_sv, U"4,A"_sv, &CPU_detail::res_<0xa7> },
+				{ 0xa8, 2, 8, 0, U"RES"_sv, U"5,B"_sv, &CPU_detail::res_<0xa8> },
+				{ 0xa9, 2, 8, 0, U"RES"_sv, U"5,C"_sv, &CPU_detail::res_<0xa9> },
+				{ 0xaa, 2, 8, 0, U"RES"_sv, U"5,D"_sv, &CPU_detail::res_<0xaa> },
+				{ 0xab, 2, 8, 0, U"RES"_sv, U"5,E"_sv, &CPU_detail::res_<0xab> },
+				{ 0xac, 2, 8, 0, U"RES"_sv, U"5,H"_sv, &CPU_detail::res_<0xac> },
+				{ 0xad, 2, 8, 0, U"RES"_sv, U"5,L"_sv, &CPU_detail::res_<0xad> },
+				{ 0xae, 2, 16, 0, U"RES"_sv, U"5,HL"_sv, &CPU_detail::res_hl_<0xae> },
+				{ 0xaf, 2, 8, 0, U"RES"_sv, U"5,A"_sv, &CPU_detail::res_<0xaf> },
+				{ 0xb0, 2, 8, 0, U"RES"_sv, U"6,B"_sv, &CPU_detail::res_<0xb0> },
+				{ 0xb1, 2, 8, 0, U"RES"_sv, U"6,C"_sv, &CPU_detail::res_<0xb1> },
+				{ 0xb2, 2, 8, 0, U"RES"_sv, U"6,D"_sv, &CPU_detail::res_<0xb2> },
+				{ 0xb3, 2, 8, 0, U"RES"_sv, U"6,E"_sv, &CPU_detail::res_<0xb3> },
+				{ 0xb4, 2, 8, 0, U"RES"_sv, U"6,H"_sv, &CPU_detail::res_<0xb4> },
+				{ 0xb5, 2, 8, 0, U"RES"_sv, U"6,L"_sv, &CPU_detail::res_<0xb5> },
+				{ 0xb6, 2, 16, 0, U"RES"_sv, U"6,HL"_sv, &CPU_detail::res_hl_<0xb6> },
+				{ 0xb7, 2, 8, 0, U"RES"_sv, U"6,A"_sv, &CPU_detail::res_<0xb7> },
+				{ 0xb8, 2, 8, 0, U"RES"_sv, U"7,B"_sv, &CPU_detail::res_<0xb8> },
+				{ 0xb9, 2, 8, 0, U"RES"_sv, U"7,C"_sv, &CPU_detail::res_<0xb9> },
+				{ 0xba, 2, 8, 0, U"RES"_sv, U"7,D"_sv, &CPU_detail::res_<0xba> },
+				{ 0xbb, 2, 8, 0, U"RES"_sv, U"7,E"_sv, &CPU_detail::res_<0xbb> },
+				{ 0xbc, 2, 8, 0, U"RES"_sv, U"7,H"_sv, &CPU_detail::res_<0xbc> },
+				{ 0xbd, 2, 8, 0, U"RES"_sv, U"7,L"_sv, &CPU_detail::res_<0xbd> },
+				{ 0xbe, 2, 16, 0, U"RES"_sv, U"7,HL"_sv, &CPU_detail::res_hl_<0xbe> },
+				{ 0xbf, 2, 8, 0, U"RES"_sv, U"7,A"_sv, &CPU_detail::res_<0xbf> },
+				{ 0xc0, 2, 8, 0, U"SET"_sv, U"0,B"_sv, &CPU_detail::set_<0xc0> },
+				{ 0xc1, 2, 8, 0, U"SET"_sv, U"0,C"_sv, &CPU_detail::set_<0xc1> },
+				{ 0xc2, 2, 8, 0, U"SET"_sv, U"0,D"_sv, &CPU_detail::set_<0xc2> },
+				{ 0xc3, 2, 8, 0, U"SET"_sv, U"0,E"_sv, &CPU_detail::set_<0xc3> },
+				{ 0xc4, 2, 8, 0, U"SET"_sv, U"0,H"_sv, &CPU_detail::set_<0xc4> },
+				{ 0xc5, 2, 8, 0, U"SET"_sv, U"0,L"_sv, &CPU_detail::set_<0xc5> },
+				{ 0xc6, 2, 16, 0, U"SET"_sv, U"0,HL"_sv, &CPU_detail::set_hl_<0xc6> },
+				{ 0xc7, 2, 8, 0, U"SET"_sv, U"0,A"_sv, &CPU_detail::set_<0xc7> },
+				{ 0xc8, 2, 8, 0, U"SET"_sv, U"1,B"_sv, &CPU_detail::set_<0xc8> },
+				{ 0xc9, 2, 8, 0, U"SET"_sv, U"1,C"_sv, &CPU_detail::set_<0xc9> },
+				{ 0xca, 2, 8, 0, U"SET"_sv, U"1,D"_sv, &CPU_detail::set_<0xca> },
+				{ 0xcb, 2, 8, 0, U"SET"_sv, U"1,E"_sv, &CPU_detail::set_<0xcb> },
+				{ 0xcc, 2, 8, 0, U"SET"_sv, U"1,H"_sv, &CPU_detail::set_<0xcc> },
+				{ 0xcd, 2, 8, 0, U"SET"_sv, U"1,L"_sv, &CPU_detail::set_<0xcd> },
+				{ 0xce, 2, 16, 0, U"SET"_sv, U"1,HL"_sv, &CPU_detail::set_hl_<0xce> },
+				{ 0xcf, 2, 8, 0, U"SET"_sv, U"1,A"_sv, &CPU_detail::set_<0xcf> },
+				{ 0xd0, 2, 8, 0, U"SET"_sv, U"2,B"_sv, &CPU_detail::set_<0xd0> },
+				{ 0xd1, 2, 8, 0, U"SET"_sv, U"2,C"_sv, &CPU_detail::set_<0xd1> },
+				{ 0xd2, 2, 8, 0, U"SET"_sv, U"2,D"_sv, &CPU_detail::set_<0xd2> },
+				{ 0xd3, 2, 8, 0, U"SET"_sv, U"2,E"_sv, &CPU_detail::set_<0xd3> },
+				{ 0xd4, 2, 8, 0, U"SET"_sv, U"2,H"_sv, &CPU_detail::set_<0xd4> },
+				{ 0xd5, 2, 8, 0, U"SET"_sv, U"2,L"_sv, &CPU_detail::set_<0xd5> },
+				{ 0xd6, 2, 16, 0, U"SET"_sv, U"2,HL"_sv, &CPU_detail::set_hl_<0xd6> },
+				{ 0xd7, 2, 8, 0, U"SET"_sv, U"2,A"_sv, &CPU_detail::set_<0xd7> },
+				{ 0xd8, 2, 8, 0, U"SET"_sv, U"3,B"_sv, &CPU_detail::set_<0xd8> },
+				{ 0xd9, 2, 8, 0, U"SET"_sv, U"3,C"_sv, &CPU_detail::set_<0xd9> },
+				{ 0xda, 2, 8, 0, U"SET"_sv, U"3,D"_sv, &CPU_detail::set_<0xda> },
+				{ 0xdb, 2, 8, 0, U"SET"_sv, U"3,E"_sv, &CPU_detail::set_<0xdb> },
+				{ 0xdc, 2, 8, 0, U"SET"_sv, U"3,H"_sv, &CPU_detail::set_<0xdc> },
+				{ 0xdd, 2, 8, 0, U"SET"_sv, U"3,L"_sv, &CPU_detail::set_<0xdd> },
+				{ 0xde, 2, 16, 0, U"SET"_sv, U"3,HL"_sv, &CPU_detail::set_hl_<0xde> },
+				{ 0xdf, 2, 8, 0, U"SET"_sv, U"3,A"_sv, &CPU_detail::set_<0xdf> },
+				{ 0xe0, 2, 8, 0, U"SET"_sv, U"4,B"_sv, &CPU_detail::set_<0xe0> },
+				{ 0xe1, 2, 8, 0, U"SET"_sv, U"4,C"_sv, &CPU_detail::set_<0xe1> },
+				{ 0xe2, 2, 8, 0, U"SET"_sv, U"4,D"_sv, &CPU_detail::set_<0xe2> },
+				{ 0xe3, 2, 8, 0, U"SET"_sv, U"4,E"_sv, &CPU_detail::set_<0xe3> },
+				{ 0xe4, 2, 8, 0, U"SET"_sv, U"4,H"_sv, &CPU_detail::set_<0xe4> },
+				{ 0xe5, 2, 8, 0, U"SET"_sv, U"4,L"_sv, &CPU_detail::set_<0xe5> },
+				{ 0xe6, 2, 16, 0, U"SET"_sv, U"4,HL"_sv, &CPU_detail::set_hl_<0xe6> },
+				{ 0xe7, 2, 8, 0, U"SET"_sv, U"4,A"_sv, &CPU_detail::set_<0xe7> },
+				{ 0xe8, 2, 8, 0, U"SET"_sv, U"5,B"_sv, &CPU_detail::set_<0xe8> },
+				{ 0xe9, 2, 8, 0, U"SET"_sv, U"5,C"_sv, &CPU_detail::set_<0xe9> },
+				{ 0xea, 2, 8, 0, U"SET"_sv, U"5,D"_sv, &CPU_detail::set_<0xea> },
+				{ 0xeb, 2, 8, 0, U"SET"_sv, U"5,E"_sv, &CPU_detail::set_<0xeb> },
+				{ 0xec, 2, 8, 0, U"SET"_sv, U"5,H"_sv, &CPU_detail::set_<0xec> },
+				{ 0xed, 2, 8, 0, U"SET"_sv, U"5,L"_sv, &CPU_detail::set_<0xed> },
+				{ 0xee, 2, 16, 0, U"SET"_sv, U"5,HL"_sv, &CPU_detail::set_hl_<0xee> },
+				{ 0xef, 2, 8, 0, U"SET"_sv, U"5,A"_sv, &CPU_detail::set_<0xef> },
+				{ 0xf0, 2, 8, 0, U"SET"_sv, U"6,B"_sv, &CPU_detail::set_<0xf0> },
+				{ 0xf1, 2, 8, 0, U"SET"_sv, U"6,C"_sv, &CPU_detail::set_<0xf1> },
+				{ 0xf2, 2, 8, 0, U"SET"_sv, U"6,D"_sv, &CPU_detail::set_<0xf2> },
+				{ 0xf3, 2, 8, 0, U"SET"_sv, U"6,E"_sv, &CPU_detail::set_<0xf3> },
+				{ 0xf4, 2, 8, 0, U"SET"_sv, U"6,H"_sv, &CPU_detail::set_<0xf4> },
+				{ 0xf5, 2, 8, 0, U"SET"_sv, U"6,L"_sv, &CPU_detail::set_<0xf5> },
+				{ 0xf6, 2, 16, 0, U"SET"_sv, U"6,HL"_sv, &CPU_detail::set_hl_<0xf6> },
+				{ 0xf7, 2, 8, 0, U"SET"_sv, U"6,A"_sv, &CPU_detail::set_<0xf7> },
+				{ 0xf8, 2, 8, 0, U"SET"_sv, U"7,B"_sv, &CPU_detail::set_<0xf8> },
+				{ 0xf9, 2, 8, 0, U"SET"_sv, U"7,C"_sv, &CPU_detail::set_<0xf9> },
+				{ 0xfa, 2, 8, 0, U"SET"_sv, U"7,D"_sv, &CPU_detail::set_<0xfa> },
+				{ 0xfb, 2, 8, 0, U"SET"_sv, U"7,E"_sv, &CPU_detail::set_<0xfb> },
+				{ 0xfc, 2, 8, 0, U"SET"_sv, U"7,H"_sv, &CPU_detail::set_<0xfc> },
+				{ 0xfd, 2, 8, 0, U"SET"_sv, U"7,L"_sv, &CPU_detail::set_<0xfd> },
+				{ 0xfe, 2, 16, 0, U"SET"_sv, U"7,HL"_sv, &CPU_detail::set_hl_<0xfe> },
+				{ 0xff, 2, 8, 0, U"SET"_sv, U"7,A"_sv, &CPU_detail::set_<0xff> },
 			}
 		};
 	};
@@ -2330,6 +2200,21 @@ namespace dmge
 		return cpuDetail_->pc;
 	}
 
+	bool CPU::halted() const
+	{
+		return cpuDetail_->powerSavingMode_;
+	}
+
+	int CPU::idleLoopCycles() const
+	{
+		return cpuDetail_->detectedIdleLoopCycles_;
+	}
+
+	int CPU::idleLoopInstructions() const
+	{
+		return cpuDetail_->detectedIdleLoopInstructions_;
+	}
+
 	int CPU::consumedCycles() const
 	{
 		return cpuDetail_->consumedCycles_;
@@ -2353,4 +2238,14 @@ namespace dmge
 	{
 		return cpuDetail_->mooneyeTestResult_;
 	}
+
+	void CPU::saveState(StateWriter& writer) const
+	{
+		cpuDetail_->saveState(writer);
+	}
+
+	void CPU::loadState(StateReader& reader)
+	{
+		cpuDetail_->loadState(reader);
+	}
 }
@@ -7,6 +7,10 @@ namespace dmge
 	class Memory;
 	class Interrupt;
 	class CPU_detail;
+	class StateWriter;
+	class StateReader;
+	class StateWriter;
+	class StateReader;
 
 	struct CPUState
 	{
@@ -47,6 +51,17 @@ namespace dmge
 		// 現在のプログラムカウンタ(PC)
 		uint16 currentPC() const;
 
+		// HALTによって低電力モードになっているか
+		bool halted() const;
+
+		// 直前の run() でアイドルループ（メモリに書き込まず、レジスタを変えずに LY・STAT・IF などを待つループ）を
+		// 検出した場合、ループ1回分のサイクル数・命令数
+		// 検出していなければ 0
+		// ループが読むアドレスの値は次のイベントの時刻まで変化しないので、それまでのループの繰り返しは省略できる
+		int idleLoopCycles() const;
+
+		int idleLoopInstructions() const;
+
 		// run()により実行された命令が消費したクロック数
 		int consumedCycles() const;
 
@@ -55,6 +70,11 @@ namespace dmge
 
 		MooneyeTestResult mooneyeTestResult() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory* mem_;
 
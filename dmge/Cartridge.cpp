@@ -48,6 +48,10 @@ namespace dmge
 			case 4: ramSizeKB = 128; break;
 			case 5: ramSizeKB = 64; break;
 		}
+
+		// Global checksum (big endian)
+
+		globalChecksum = (header[Address::GlobalChecksum] << 8) | header[Address::GlobalChecksum + 1];
 	}
 
 	void CartridgeHeader::dump()
@@ -77,4 +81,9 @@ namespace dmge
 	{
 		return FileSystem::PathAppend(FileSystem::ParentPath(cartridgePath), FileSystem::BaseName(cartridgePath)) + U".sav";
 	}
+
+	FilePath GetSaveStateFilePath(FilePathView cartridgePath)
+	{
+		return FileSystem::PathAppend(FileSystem::ParentPath(cartridgePath), FileSystem::BaseName(cartridgePath)) + U".state";
+	}
 }
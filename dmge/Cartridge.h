@@ -69,6 +69,9 @@ namespace dmge
 		// RAM size (0x0149)
 		int ramSizeKB{};
 
+		// Global checksum (0x014E - 0x014F)
+		uint16 globalChecksum{};
+
 		CartridgeHeader() = default;
 
 		CartridgeHeader(FilePath cartridgePath);
@@ -80,4 +83,6 @@ namespace dmge
 
 	FilePath GetSaveFilePath(FilePathView cartridgePath);
 
+	FilePath GetSaveStateFilePath(FilePathView cartridgePath);
+
 }
@@ -0,0 +1,403 @@
+﻿#include "stdafx.h"
+#include "Core.h"
+#include "Memory.h"
+#include "CPU.h"
+#include "PPU.h"
+#include "PPUConstants.h"
+#include "LCD.h"
+#include "Audio/APU.h"
+#include "Timer.h"
+#include "Joypad.h"
+#include "Serial.h"
+#include "Interrupt.h"
+#include "SaveState.h"
+
+namespace dmge
+{
+	Core::Core(bool headless, int audioSampleRate)
+		:
+		headless_{ headless },
+		scheduler_{ std::make_unique<Scheduler>() },
+		mem_{ std::make_unique<Memory>() },
+		interrupt_{ std::make_unique<Interrupt>() },
+		lcd_{ std::make_unique<LCD>(*mem_.get()) },
+		ppu_{ std::make_unique<PPU>(mem_.get(), lcd_.get(), interrupt_.get(), scheduler_.get(), headless) },
+		timer_{ std::make_unique<Timer>(mem_.get(), interrupt_.get(), scheduler_.get()) },
+		apu_{ std::make_unique<APU>(*timer_.get(), *scheduler_.get(), audioSampleRate, headless) },
+		cpu_{ std::make_unique<CPU>(mem_.get(), interrupt_.get()) },
+		joypad_{ std::make_unique<Joypad>(mem_.get()) },
+		serial_{ std::make_unique<Serial>(*interrupt_.get(), *scheduler_.get()) }
+	{
+		mem_->init(ppu_.get(), apu_.get(), timer_.get(), joypad_.get(), lcd_.get(), interrupt_.get(), serial_.get());
+
+		if (headless_)
+		{
+			joypad_->setEnable(false);
+		}
+	}
+
+	Core::~Core()
+	{
+	}
+
+	bool Core::loadCartridge(FilePathView cartridgePath)
+	{
+		return mem_->loadCartridge(FilePath{ cartridgePath });
+	}
+
+	void Core::boot(const CoreBootOptions& options)
+	{
+		// BootROM
+		const bool enableBootROM = not options.bootROMPath.isEmpty() && FileSystem::Exists(options.bootROMPath);
+		if (enableBootROM)
+		{
+			mem_->enableBootROM(options.bootROMPath);
+		}
+
+		// CGBモードの適用
+		if (mem_->isSupportedCGBMode() && options.detectCGB)
+		{
+			mem_->setCGBMode(true);
+			ppu_->setCGBMode(true);
+			apu_->setCGBMode(true);
+			cpu_->setCGBMode(true);
+		}
+
+		cpu_->reset(enableBootROM);
+
+		// SGBモードの適用
+		if (not mem_->isCGBMode() && mem_->isSupportedSGBMode() && options.detectSGB)
+		{
+			mem_->setSGBMode(true);
+			ppu_->setSGBMode(true);
+			cpu_->setSGBMode(true);
+		}
+
+		// メモリの内容をリセット（SGB/CGBモード確定後にリセットする必要がある）
+		mem_->reset();
+
+		// 各ユニットの最初のイベントを登録
+		timer_->sync();
+		serial_->sync();
+		ppu_->sync();
+		apu_->sync();
+	}
+
+	int Core::step()
+	{
+		int cycles;
+
+		if (cpu_->halted())
+		{
+			// HALT 中は割り込み要求があるまで命令を実行しない
+			// 割り込み要求はイベントの処理時にしか発生しないので、次のイベントの時刻まで一度に進める
+			cycles = haltSkipCycles_();
+		}
+		else
+		{
+			// CPUコマンドを1回実行する
+			cpu_->run();
+			++instructionCount_;
+
+			cycles = cpu_->consumedCycles();
+		}
+
+		tickUnits(cycles);
+
+		// 割り込み
+		if (cpu_->interrupt())
+		{
+			tickUnits(5 * 4);
+		}
+		else if (cpu_->idleLoopCycles() > 0)
+		{
+			cycles += skipIdleLoop_();
+		}
+
+		return cycles;
+	}
+
+	int Core::haltSkipCycles_() const
+	{
+		// HALT 中の1回分のサイクル数（HALT 命令の実行時のもの）
+		const int haltCycles = cpu_->consumedCycles();
+
+		// OAM DMA 転送中は、転送と PPU の同期を保つため1回ずつ進める
+		if (mem_->isOAMDMARunning())
+		{
+			return haltCycles;
+		}
+
+		const uint64 now = scheduler_->now();
+		const uint64 next = Min(scheduler_->nextEventTimestamp(), now + MaxSkipCycles);
+
+		if (next <= now)
+		{
+			return haltCycles;
+		}
+
+		// 1回ずつ進めた場合と同じ時刻（haltCycles の倍数）でイベントを処理する
+		const uint64 steps = (next - now + haltCycles - 1) / haltCycles;
+
+		return static_cast<int>(steps * haltCycles);
+	}
+
+	int Core::skipIdleLoop_()
+	{
+		// OAM DMA 転送中は、転送と PPU の同期を保つため省略しない
+		if (mem_->isOAMDMARunning())
+		{
+			return 0;
+		}
+
+		// ループが読む値は次のイベントの時刻まで変化しないので、
+		// ループ1回分が次のイベントの時刻までに収まる回数だけ、ループの繰り返しを省略できる
+		// （CPU の状態はループの先頭で変わらず、時刻だけが進む）
+		const uint64 loopCycles = cpu_->idleLoopCycles();
+		const uint64 now = scheduler_->now();
+		const uint64 next = Min(scheduler_->nextEventTimestamp(), now + MaxSkipCycles);
+		const uint64 loops = (next - now) / loopCycles;
+
+		if (loops == 0)
+		{
+			return 0;
+		}
+
+		const int cycles = static_cast<int>(loops * loopCycles);
+
+		instructionCount_ += loops * cpu_->idleLoopInstructions();
+
+		tickUnits(cycles);
+
+		// 割り込み
+		if (cpu_->interrupt())
+		{
+			tickUnits(5 * 4);
+		}
+
+		return cycles;
+	}
+
+	void Core::tickUnits(int cycles)
+	{
+		// RTC, DMA
+		mem_->update(cycles);
+
+		// 時刻を進め、期限が来たイベントを処理する
+		// Timer, Serial, PPU, APU はここか、レジスタへのアクセス時にまとめて現在時刻まで進められる
+
+		scheduler_->advance(cycles);
+
+		while (const auto event = scheduler_->popDueEvent())
+		{
+			dispatchEvent_(*event);
+		}
+	}
+
+	void Core::runFrame()
+	{
+		const uint64 frameEnd = scheduler_->now() + FrameDots * (mem_->isDoubleSpeed() ? 2 : 1);
+
+		while (scheduler_->now() < frameEnd)
+		{
+			step();
+
+			if (cpu_->mooneyeTestResult() != MooneyeTestResult::Running)
+			{
+				break;
+			}
+		}
+	}
+
+	void Core::runToNextVBlank()
+	{
+		const uint64 frameCount = ppu_->frameCount();
+		const uint64 frameBegin = scheduler_->now();
+		const int doubleSpeedFactor = mem_->isDoubleSpeed() ? 2 : 1;
+
+		while (ppu_->frameCount() == frameCount)
+		{
+			// LCD がオフの場合は VBlank に入らないので、ちょうど1フレーム分のサイクルで終了する
+			// LCD がオンの場合は、PPU の同期が VBlank への移行より遅れる場合に備え、1行分の余裕をもたせる
+			const int maxDots = lcd_->isEnabled() ? FrameDots + LineDots : FrameDots;
+
+			if (scheduler_->now() >= frameBegin + maxDots * doubleSpeedFactor)
+			{
+				break;
+			}
+
+			step();
+		}
+	}
+
+	uint64 Core::instructionCount() const
+	{
+		return instructionCount_;
+	}
+
+	MooneyeTestResult Core::mooneyeTestResult() const
+	{
+		return cpu_->mooneyeTestResult();
+	}
+
+	void Core::saveState(StateWriter& writer) const
+	{
+		const auto& header = mem_->cartridgeHeader();
+
+		writer.write(SaveStateMagic);
+		writer.write(SaveStateVersion);
+		writer.write(header.type);
+		writer.write(header.globalChecksum);
+
+		saveUnitsState_(writer);
+	}
+
+	bool Core::loadState(StateReader& reader)
+	{
+		const auto& header = mem_->cartridgeHeader();
+
+		uint32 magic = 0;
+		uint32 version = 0;
+		CartridgeType type{};
+		uint16 globalChecksum = 0;
+
+		reader.read(magic);
+		reader.read(version);
+		reader.read(type);
+		reader.read(globalChecksum);
+
+		if (reader.failed() ||
+			magic != SaveStateMagic ||
+			version != SaveStateVersion ||
+			type != header.type ||
+			globalChecksum != header.globalChecksum)
+		{
+			return false;
+		}
+
+		// データが途中で足りなかった場合や不正な値があった場合に元に戻せるよう、現在の状態を退避しておく
+		StateWriter backup;
+		saveUnitsState_(backup);
+
+		loadUnitsState_(reader);
+
+		if (not reader.finished())
+		{
+			StateReader backupReader{ backup.data().data(), backup.data().size() };
+			loadUnitsState_(backupReader);
+			return false;
+		}
+
+		return true;
+	}
+
+	void Core::saveSnapshot(StateWriter& writer) const
+	{
+		saveUnitsState_(writer);
+	}
+
+	void Core::loadSnapshot(StateReader& reader)
+	{
+		loadUnitsState_(reader);
+	}
+
+	Scheduler& Core::scheduler()
+	{
+		return *scheduler_;
+	}
+
+	Memory& Core::memory()
+	{
+		return *mem_;
+	}
+
+	Interrupt& Core::interrupt()
+	{
+		return *interrupt_;
+	}
+
+	LCD& Core::lcd()
+	{
+		return *lcd_;
+	}
+
+	PPU& Core::ppu()
+	{
+		return *ppu_;
+	}
+
+	Timer& Core::timer()
+	{
+		return *timer_;
+	}
+
+	APU& Core::apu()
+	{
+		return *apu_;
+	}
+
+	CPU& Core::cpu()
+	{
+		return *cpu_;
+	}
+
+	Joypad& Core::joypad()
+	{
+		return *joypad_;
+	}
+
+	Serial& Core::serial()
+	{
+		return *serial_;
+	}
+
+	void Core::dispatchEvent_(SchedulerEvent event)
+	{
+		switch (event)
+		{
+		case SchedulerEvent::Timer:
+			timer_->sync();
+			break;
+
+		case SchedulerEvent::Serial:
+			serial_->sync();
+			break;
+
+		case SchedulerEvent::PPU:
+			ppu_->sync();
+			break;
+
+		case SchedulerEvent::APU:
+			apu_->sync();
+			break;
+		}
+	}
+
+	void Core::saveUnitsState_(StateWriter& writer) const
+	{
+		scheduler_->saveState(writer);
+		interrupt_->saveState(writer);
+		cpu_->saveState(writer);
+		mem_->saveState(writer);
+		lcd_->saveState(writer);
+		ppu_->saveState(writer);
+		timer_->saveState(writer);
+		apu_->saveState(writer);
+		joypad_->saveState(writer);
+		serial_->saveState(writer);
+	}
+
+	void Core::loadUnitsState_(StateReader& reader)
+	{
+		scheduler_->loadState(reader);
+		interrupt_->loadState(reader);
+		cpu_->loadState(reader);
+		mem_->loadState(reader);
+		lcd_->loadState(reader);
+		ppu_->loadState(reader);
+		timer_->loadState(reader);
+		apu_->loadState(reader);
+		joypad_->loadState(reader);
+		serial_->loadState(reader);
+	}
+}
@@ -0,0 +1,132 @@
+﻿#pragma once
+
+#include "Scheduler.h"
+#include "Test.h"
+
+namespace dmge
+{
+	class Memory;
+	class Interrupt;
+	class LCD;
+	class PPU;
+	class APU;
+	class Timer;
+	class CPU;
+	class Joypad;
+	class Serial;
+	class StateWriter;
+	class StateReader;
+
+	// 電源投入時の設定
+	struct CoreBootOptions
+	{
+		// カートリッジが対応していれば CGB モードで実行する
+		bool detectCGB = true;
+
+		// カートリッジが対応していれば SGB モードで実行する
+		bool detectSGB = true;
+
+		// Bootstrap ROMのパス（空の場合は使用しない）
+		FilePath bootROMPath{};
+	};
+
+	// エミュレーションの中核
+	// 各ユニットを所有し、CPU 命令の実行とユニットの同期を行う
+	// ウィンドウ・入力・オーディオ出力は扱わない（DmgeApp やベンチマークなどの利用側が扱う）
+	class Core
+	{
+	public:
+		// headless == true の場合、描画・オーディオ出力用のリソースを作成しない
+		// 入力デバイスも参照しない
+		// audioSampleRate : オーディオの出力サンプリングレート [Hz]
+		explicit Core(bool headless = false, int audioSampleRate = 48000);
+
+		~Core();
+
+		// カートリッジを読み込む
+		// 対応する MBC がない場合は false
+		bool loadCartridge(FilePathView cartridgePath);
+
+		// CGB・SGB モードを確定させ、電源投入直後の状態にする
+		// loadCartridge() の後に呼ぶ
+		void boot(const CoreBootOptions& options);
+
+		// CPU 命令を1つ実行し、消費したサイクル数だけ各ユニットを進める
+		// HALT 中やアイドルループの実行中は、次のイベントの時刻まで何回分かの命令の実行をまとめて行う
+		// CPU が消費したサイクル数（割り込み処理の分を除く）を返す
+		int step();
+
+		// 各ユニットを cycles T-cycles 進める
+		void tickUnits(int cycles);
+
+		// step() を繰り返し、1フレーム分 (FrameDots) 以上のサイクルを進める
+		// テスト ROM の結果が確定した場合はそこで終了する
+		void runFrame();
+
+		// step() を繰り返し、PPU が次に VBlank に入るまで進める
+		// LCD がオフの場合は1フレーム分 (FrameDots) のサイクルを進めたところで終了する
+		void runToNextVBlank();
+
+		// 実行した CPU 命令の数
+		uint64 instructionCount() const;
+
+		MooneyeTestResult mooneyeTestResult() const;
+
+		// セーブステートを書き込む
+		// ヘッダ（SaveState.h）に続けて、全ユニットの状態を書き込む
+		void saveState(StateWriter& writer) const;
+
+		// セーブステートを読み込み、書き込んだ時点の状態に戻す
+		// 別のカートリッジ・別のバージョンのセーブステートの場合や、データが壊れている場合は何もせず false を返す
+		bool loadState(StateReader& reader);
+
+		// 実行中の状態を一時的に退避・復元する（ラン・アヘッド用）
+		// 同じ Core で直前に saveSnapshot() したデータだけを読み込むこと（ヘッダの検証や、データ不足時の復旧を行わない）
+		void saveSnapshot(StateWriter& writer) const;
+		void loadSnapshot(StateReader& reader);
+
+		Scheduler& scheduler();
+		Memory& memory();
+		Interrupt& interrupt();
+		LCD& lcd();
+		PPU& ppu();
+		Timer& timer();
+		APU& apu();
+		CPU& cpu();
+		Joypad& joypad();
+		Serial& serial();
+
+	private:
+		bool headless_;
+
+		std::unique_ptr<Scheduler> scheduler_;
+		std::unique_ptr<Memory> mem_;
+		std::unique_ptr<Interrupt> interrupt_;
+		std::unique_ptr<LCD> lcd_;
+		std::unique_ptr<PPU> ppu_;
+		std::unique_ptr<Timer> timer_;
+		std::unique_ptr<APU> apu_;
+		std::unique_ptr<CPU> cpu_;
+		std::unique_ptr<Joypad> joypad_;
+		std::unique_ptr<Serial> serial_;
+
+		uint64 instructionCount_ = 0;
+
+		// HALT 中・アイドルループの実行中にまとめて進めるサイクル数の上限
+		static constexpr uint64 MaxSkipCycles = 456;
+
+		// HALT 中に、次のイベントの時刻までに何サイクル進めればよいか
+		int haltSkipCycles_() const;
+
+		// アイドルループを次のイベントの時刻の直前まで繰り返したものとして進める
+		// 進めたサイクル数を返す
+		int skipIdleLoop_();
+
+		// 期限が来たイベントに対応するユニットを現在時刻まで進める
+		void dispatchEvent_(SchedulerEvent event);
+
+		// 全ユニットの状態（セーブステートのヘッダ以外の部分）
+		void saveUnitsState_(StateWriter& writer) const;
+		void loadUnitsState_(StateReader& reader);
+	};
+}
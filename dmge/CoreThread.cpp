@@ -0,0 +1,222 @@
+﻿#include "stdafx.h"
+#include "CoreThread.h"
+#include "Core.h"
+#include "PPU.h"
+#include "LCD.h"
+#include "PPUConstants.h"
+#include "Timing.h"
+
+namespace dmge
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// 1フレームの実時間
+		const auto FrameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{ static_cast<double>(FrameDots) / ClockFrequency });
+
+		constexpr uint8 NewFrameBit = 0x80;
+
+		thread_local bool IsCoreThread = false;
+	}
+
+	CoreThread::CoreThread(Core& core)
+		: core_{ core }
+	{
+	}
+
+	CoreThread::~CoreThread()
+	{
+		stop();
+	}
+
+	void CoreThread::start(std::function<void()> onFrame)
+	{
+		if (isRunning()) return;
+
+		onFrame_ = std::move(onFrame);
+		quit_ = false;
+		pauseRequested_ = false;
+		paused_ = false;
+
+		thread_ = std::thread{ [this] { run_(); } };
+	}
+
+	void CoreThread::stop()
+	{
+		if (not isRunning()) return;
+
+		{
+			std::lock_guard lock{ mutex_ };
+			quit_ = true;
+		}
+
+		cv_.notify_all();
+		thread_.join();
+
+		// 実行されなかったコマンドは、停止したコアに対してここで実行する
+		for (auto& command : commands_)
+		{
+			command();
+		}
+
+		commands_.clear();
+	}
+
+	bool CoreThread::isRunning() const
+	{
+		return thread_.joinable();
+	}
+
+	void CoreThread::post(std::function<void()> command)
+	{
+		{
+			std::lock_guard lock{ mutex_ };
+			commands_.push_back(std::move(command));
+		}
+
+		cv_.notify_all();
+	}
+
+	void CoreThread::pause()
+	{
+		if (not isRunning()) return;
+
+		std::unique_lock lock{ mutex_ };
+		pauseRequested_ = true;
+		cv_.notify_all();
+
+		cv_.wait(lock, [&] { return paused_; });
+	}
+
+	void CoreThread::resume()
+	{
+		if (not isRunning()) return;
+
+		{
+			std::lock_guard lock{ mutex_ };
+			pauseRequested_ = false;
+		}
+
+		cv_.notify_all();
+	}
+
+	void CoreThread::setSpeed(int speed)
+	{
+		speed_ = speed;
+		cv_.notify_all();
+	}
+
+	int CoreThread::speed() const
+	{
+		return speed_;
+	}
+
+	void CoreThread::publishFrame()
+	{
+		auto& frame = frames_[back_];
+
+		if (not core_.ppu().copyRenderingResult(frame.image))
+		{
+			return;
+		}
+
+		frame.lcdEnabled = core_.lcd().isEnabled();
+
+		back_ = middle_.exchange(back_ | NewFrameBit, std::memory_order_acq_rel) & ~NewFrameBit;
+	}
+
+	bool CoreThread::updateFrame()
+	{
+		if ((middle_.load(std::memory_order_relaxed) & NewFrameBit) == 0)
+		{
+			return false;
+		}
+
+		front_ = middle_.exchange(front_, std::memory_order_acq_rel) & ~NewFrameBit;
+		return true;
+	}
+
+	const CoreThread::Frame& CoreThread::frame() const
+	{
+		return frames_[front_];
+	}
+
+	bool CoreThread::IsCurrentThread()
+	{
+		return IsCoreThread;
+	}
+
+	void CoreThread::run_()
+	{
+		IsCoreThread = true;
+
+		auto nextFrameTime = Clock::now();
+
+		Array<std::function<void()>> commands;
+
+		while (true)
+		{
+			// 次のフレームの時刻まで待つ
+			// 待っている間もコマンドと一時停止の要求を処理する
+			{
+				std::unique_lock lock{ mutex_ };
+
+				while (true)
+				{
+					if (quit_) return;
+
+					if (not commands_.isEmpty())
+					{
+						std::swap(commands, commands_);
+
+						lock.unlock();
+
+						for (auto& command : commands)
+						{
+							command();
+						}
+
+						commands.clear();
+
+						lock.lock();
+						continue;
+					}
+
+					if (pauseRequested_)
+					{
+						paused_ = true;
+						cv_.notify_all();
+
+						cv_.wait(lock, [&] { return not pauseRequested_ || quit_; });
+
+						paused_ = false;
+
+						// 停止していた時間の分は取り戻さない
+						nextFrameTime = Clock::now();
+						continue;
+					}
+
+					if (speed_ == 0 || Clock::now() >= nextFrameTime) break;
+
+					cv_.wait_until(lock, nextFrameTime);
+				}
+			}
+
+			core_.runToNextVBlank();
+
+			onFrame_();
+
+			// 次のフレームの時刻
+			// 処理が間に合わず1フレーム以上遅れた場合は、遅れを取り戻そうとせず現在時刻から数え直す
+			const auto now = Clock::now();
+
+			nextFrameTime += FrameDuration / Max(speed_.load(), 1);
+
+			if (nextFrameTime + FrameDuration < now)
+			{
+				nextFrameTime = now;
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+﻿#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace dmge
+{
+	class Core;
+
+	// エミュレーションを専用のスレッドで実行する
+	// - VBlank から次の VBlank までを1フレームとして実行し、実時間に合わせて待機する
+	// - 完成したフレームはトリプルバッファで受け渡すので、画面の更新が遅れてもエミュレーションは待たない
+	// - 他のスレッドからのコマンドと一時停止の要求は、フレームの間で処理する
+	//   他のスレッドから Core にアクセスする場合は、pause() で一時停止してから行う
+	class CoreThread
+	{
+	public:
+		// 1フレーム分のレンダリング結果
+		struct Frame
+		{
+			Image image;
+
+			// LCD が有効か（無効の場合は画面に何も表示しない）
+			bool lcdEnabled = false;
+		};
+
+		explicit CoreThread(Core& core);
+
+		~CoreThread();
+
+		// スレッドを開始する
+		// onFrame はコアのスレッドで1フレームごとに呼ばれる。publishFrame() でフレームを出力すること
+		void start(std::function<void()> onFrame);
+
+		// スレッドを終了し、終了を待つ
+		void stop();
+
+		bool isRunning() const;
+
+		// コマンドを追加する
+		// コマンドはコアのスレッドで、フレームの間に追加した順に実行する
+		void post(std::function<void()> command);
+
+		// コアのスレッドをフレームの間で一時停止する
+		// 戻った時点で停止しているので、resume() までは呼び出したスレッドから Core にアクセスできる
+		// スレッドを実行していない場合は何もしない
+		void pause();
+
+		void resume();
+
+		// 実時間に対する速度の倍率（0 の場合は待機しない）
+		void setSpeed(int speed);
+
+		int speed() const;
+
+		// (コアのスレッド) PPU のレンダリング結果を最新のフレームとして出力する
+		void publishFrame();
+
+		// 新しいフレームが出力されていれば frame() を最新のフレームに更新し、true を返す
+		bool updateFrame();
+
+		const Frame& frame() const;
+
+		// 現在のスレッドがコアのスレッドか
+		static bool IsCurrentThread();
+
+	private:
+		Core& core_;
+
+		std::function<void()> onFrame_;
+
+		std::thread thread_;
+
+		std::mutex mutex_;
+
+		std::condition_variable cv_;
+
+		// 未実行のコマンド
+		Array<std::function<void()>> commands_;
+
+		bool quit_ = false;
+
+		bool pauseRequested_ = false;
+
+		bool paused_ = false;
+
+		std::atomic<int> speed_ = 1;
+
+		// トリプルバッファ
+		// コアのスレッドが back に書き込み、middle と交換して出力する
+		// 読み出し側は新しいフレームがあれば middle と front を交換する
+		std::array<Frame, 3> frames_;
+
+		// middle のインデックス（NewFrameBit: 読み出し側がまだ取得していない）
+		std::atomic<uint8> middle_ = 1;
+
+		uint8 back_ = 0;
+
+		uint8 front_ = 2;
+
+		void run_();
+	};
+}
@@ -1,6 +1,7 @@
 ﻿#include "stdafx.h"
 #include "DMA.h"
 #include "Memory.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -41,4 +42,20 @@ namespace dmge
 	{
 		return running_;
 	}
+
+	void DMA::saveState(StateWriter& writer) const
+	{
+		writer.write(running_);
+		writer.write(srcAddr_);
+		writer.write(cycleCount_);
+		writer.write(offset_);
+	}
+
+	void DMA::loadState(StateReader& reader)
+	{
+		reader.read(running_);
+		reader.read(srcAddr_);
+		reader.read(cycleCount_);
+		reader.read(offset_);
+	}
 }
@@ -3,6 +3,8 @@
 namespace dmge
 {
 	class Memory;
+	class StateWriter;
+	class StateReader;
 
 	class DMA
 	{
@@ -15,6 +17,11 @@ namespace dmge
 
 		bool running() const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory* mem_;
 		bool running_ = false;
@@ -22,6 +22,14 @@ namespace dmge
 		{
 			return U"{:02X} ({:08b})"_fmt(num, num);
 		}
+
+		// 表示する IO レジスタ
+		constexpr std::array<uint16, 20> IORegisters = {
+			Address::DIV, Address::TIMA, Address::TMA, Address::TAC,
+			Address::LCDC, Address::STAT, Address::SCY, Address::SCX, Address::LY, Address::LYC,
+			Address::BGP, Address::OBP0, Address::OBP1, Address::WY, Address::WX,
+			Address::KEY1, Address::IF, Address::IE, Address::NR52, Address::JOYP,
+		};
 	}
 
 
@@ -59,37 +67,23 @@ namespace dmge
 			pos_.y += LineHeight * nLine;
 		}
 
-		void drawMemoryDump(Memory* mem, uint16 addr)
+		void drawMemoryDump(const std::array<uint8, 64>& dump)
 		{
-			for (uint16 row = 0; row < 4u; row++)
+			for (int row = 0; row < 4; row++)
 			{
+				const uint8* data = dump.data() + row * 16;
+
 				FontAsset(U"debug")(U"{:02X} {:02X} {:02X} {:02X} {:02X} {:02X} {:02X} {:02X} | {:02X} {:02X} {:02X} {:02X} {:02X} {:02X} {:02X} {:02X}"_fmt(
-					mem->read(addr + row * 16 + 0),
-					mem->read(addr + row * 16 + 1),
-					mem->read(addr + row * 16 + 2),
-					mem->read(addr + row * 16 + 3),
-					mem->read(addr + row * 16 + 4),
-					mem->read(addr + row * 16 + 5),
-					mem->read(addr + row * 16 + 6),
-					mem->read(addr + row * 16 + 7),
-					mem->read(addr + row * 16 + 8),
-					mem->read(addr + row * 16 + 9),
-					mem->read(addr + row * 16 + 10),
-					mem->read(addr + row * 16 + 11),
-					mem->read(addr + row * 16 + 12),
-					mem->read(addr + row * 16 + 13),
-					mem->read(addr + row * 16 + 14),
-					mem->read(addr + row * 16 + 15)))
+					data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7],
+					data[8], data[9], data[10], data[11], data[12], data[13], data[14], data[15]))
 					.draw(FontSize.y, pos_, TextColor);
 
 				pos_.y += LineHeight;
 			}
 		}
 
-		void drawChannelsAmplitude(APU* apu)
+		void drawChannelsAmplitude(const std::array<int, 4>& ampList, const std::array<bool, 4>& muteList)
 		{
-			const auto ampList = apu->getAmplitude();
-
 			for (const auto [index, amp] : Indexed(ampList))
 			{
 				const double amp01 = amp / 15.0;
@@ -99,7 +93,7 @@ namespace dmge
 				const Vec2 bottomLeft{ pos_.x + index * (rectSize.x + xPadding), pos_.y + LineHeight };
 				const RectF rect{ Arg::bottomLeft = bottomLeft, rectSize };
 
-				if (apu->getMute(index))
+				if (muteList[index])
 				{
 					rect.draw(ColorF{ 0.05 }).drawFrame(0, 1, ColorF{ Palette::Red, 0.5 });
 				}
@@ -135,6 +129,57 @@ namespace dmge
 	{
 	}
 
+	void DebugMonitor::capture()
+	{
+		std::lock_guard lock{ mutex_ };
+
+		auto& s = captured_;
+
+		s.cgbMode = mem_->isCGBMode();
+		s.sgbMode = mem_->isSGBMode();
+		s.mapper = mem_->cartridgeHeader().typeText.substr(0, 16);
+		s.romBank = mem_->romBank();
+		s.ramBank = mem_->ramBank();
+
+		for (const uint16 addr : IORegisters)
+		{
+			s.io[addr & 0xff] = mem_->read(addr);
+		}
+
+		s.dumpAddress = dumpAddress_;
+
+		for (int i = 0; i < static_cast<int>(s.memoryDump.size()); ++i)
+		{
+			s.memoryDump[i] = mem_->read(s.dumpAddress + i);
+		}
+
+		s.cpu = cpu_->getCurrentCPUState();
+		s.ime = interrupt_->ime();
+
+		s.buffer = apu_->getBufferState();
+		s.amplitude = apu_->getAmplitude();
+
+		for (int i = 0; i < 4; ++i)
+		{
+			s.mute[i] = apu_->getMute(i);
+		}
+
+		if (captureCount_++ % 16 == 0)
+		{
+			if (mem_->isVRAMTileDataModified())
+			{
+				tileDataTexture_.updateImage();
+
+				if (mem_->isCGBMode())
+				{
+					tileDataTextureCGB_.updateImage();
+				}
+
+				mem_->resetVRAMTileDataModified();
+			}
+		}
+	}
+
 	void DebugMonitor::update()
 	{
 		const bool showDumpAddressTextbox = textbox_.isVisible();
@@ -167,25 +212,23 @@ namespace dmge
 			}
 		}
 
-		static int cnt = 0;
-		if (cnt++ % 16 == 0)
-		{
-			if (mem_->isVRAMTileDataModified())
-			{
-				tileDataTexture_.update();
+		// capture() で取得した状態を反映する
 
-				if (mem_->isCGBMode())
-				{
-					tileDataTextureCGB_.update();
-				}
+		std::lock_guard lock{ mutex_ };
 
-				mem_->resetVRAMTileDataModified();
-			}
-		}
+		state_ = captured_;
+
+		tileDataTexture_.uploadTexture();
+		tileDataTextureCGB_.uploadTexture();
 	}
 
 	void DebugMonitor::draw(const Point& pos) const
 	{
+		const auto& s = state_;
+
+		// IO レジスタの値
+		const auto io = [&](uint16 addr) { return s.io[addr & 0xff]; };
+
 		{
 			const ScopedViewport2D viewport{ pos.x, pos.y, ViewportSize.x, Scene::Height() };
 
@@ -197,35 +240,35 @@ namespace dmge
 				// Cartridge
 
 				d.drawSection(U"Cartridge");
-				d.drawText(U"{} mode"_fmt(mem_->isCGBMode() ? U"CGB"_sv : mem_->isSGBMode() ? U"SGB"_sv : U"DMG"_sv));
-				d.drawLabelAndValue(U"Mapper", U"{}"_fmt(mem_->cartridgeHeader().typeText.substrView(0, 16)));
-				d.drawLabelAndValue(U"ROM Bank", U"{:X}"_fmt(mem_->romBank()));
-				d.drawLabelAndValue(U"RAM Bank", U"{:X}"_fmt(mem_->ramBank()));
+				d.drawText(U"{} mode"_fmt(s.cgbMode ? U"CGB"_sv : s.sgbMode ? U"SGB"_sv : U"DMG"_sv));
+				d.drawLabelAndValue(U"Mapper", s.mapper);
+				d.drawLabelAndValue(U"ROM Bank", U"{:X}"_fmt(s.romBank));
+				d.drawLabelAndValue(U"RAM Bank", U"{:X}"_fmt(s.ramBank));
 				d.drawEmptyLine();
 
 				// Timer
 
 				d.drawSection(U"Timer");
-				d.drawLabelAndValue(U"FF04 DIV ", Uint8ToHexAndBin(mem_->read(Address::DIV)));
-				d.drawLabelAndValue(U"FF05 TIMA", Uint8ToHexAndBin(mem_->read(Address::TIMA)));
-				d.drawLabelAndValue(U"FF06 TMA ", Uint8ToHexAndBin(mem_->read(Address::TMA)));
-				d.drawLabelAndValue(U"FF07 TAC ", Uint8ToHexAndBin(mem_->read(Address::TAC)));
+				d.drawLabelAndValue(U"FF04 DIV ", Uint8ToHexAndBin(io(Address::DIV)));
+				d.drawLabelAndValue(U"FF05 TIMA", Uint8ToHexAndBin(io(Address::TIMA)));
+				d.drawLabelAndValue(U"FF06 TMA ", Uint8ToHexAndBin(io(Address::TMA)));
+				d.drawLabelAndValue(U"FF07 TAC ", Uint8ToHexAndBin(io(Address::TAC)));
 				d.drawEmptyLine();
 
 				// Rendering
 
 				d.drawSection(U"Rendering");
-				d.drawLabelAndValue(U"FF40 LCDC", Uint8ToHexAndBin(mem_->read(Address::LCDC)));
-				d.drawLabelAndValue(U"FF41 STAT", Uint8ToHexAndBin(mem_->read(Address::STAT)));
-				d.drawLabelAndValue(U"FF42 SCY ", Uint8ToHexAndBin(mem_->read(Address::SCY)));
-				d.drawLabelAndValue(U"FF43 SCX ", Uint8ToHexAndBin(mem_->read(Address::SCX)));
-				d.drawLabelAndValue(U"FF44 LY  ", Uint8ToHexAndBin(mem_->read(Address::LY)));
-				d.drawLabelAndValue(U"FF45 LYC ", Uint8ToHexAndBin(mem_->read(Address::LYC)));
-				d.drawLabelAndValue(U"FF47 BGP ", Uint8ToHexAndBin(mem_->read(Address::BGP)));
-				d.drawLabelAndValue(U"FF48 OBP0", Uint8ToHexAndBin(mem_->read(Address::OBP0)));
-				d.drawLabelAndValue(U"FF49 OBP1", Uint8ToHexAndBin(mem_->read(Address::OBP1)));
-				d.drawLabelAndValue(U"FF4A WY  ", Uint8ToHexAndBin(mem_->read(Address::WY)));
-				d.drawLabelAndValue(U"FF4B WX  ", Uint8ToHexAndBin(mem_->read(Address::WX)));
+				d.drawLabelAndValue(U"FF40 LCDC", Uint8ToHexAndBin(io(Address::LCDC)));
+				d.drawLabelAndValue(U"FF41 STAT", Uint8ToHexAndBin(io(Address::STAT)));
+				d.drawLabelAndValue(U"FF42 SCY ", Uint8ToHexAndBin(io(Address::SCY)));
+				d.drawLabelAndValue(U"FF43 SCX ", Uint8ToHexAndBin(io(Address::SCX)));
+				d.drawLabelAndValue(U"FF44 LY  ", Uint8ToHexAndBin(io(Address::LY)));
+				d.drawLabelAndValue(U"FF45 LYC ", Uint8ToHexAndBin(io(Address::LYC)));
+				d.drawLabelAndValue(U"FF47 BGP ", Uint8ToHexAndBin(io(Address::BGP)));
+				d.drawLabelAndValue(U"FF48 OBP0", Uint8ToHexAndBin(io(Address::OBP0)));
+				d.drawLabelAndValue(U"FF49 OBP1", Uint8ToHexAndBin(io(Address::OBP1)));
+				d.drawLabelAndValue(U"FF4A WY  ", Uint8ToHexAndBin(io(Address::WY)));
+				d.drawLabelAndValue(U"FF4B WX  ", Uint8ToHexAndBin(io(Address::WX)));
 				d.drawEmptyLine();
 
 				// スペース
@@ -234,8 +277,8 @@ namespace dmge
 
 				// Memory dump
 
-				d.drawSection(U"Memory ({:04X})"_fmt(dumpAddress_));
-				d.drawMemoryDump(mem_, dumpAddress_);
+				d.drawSection(U"Memory ({:04X})"_fmt(s.dumpAddress));
+				d.drawMemoryDump(s.memoryDump);
 				d.drawEmptyLine();
 			}
 
@@ -244,7 +287,7 @@ namespace dmge
 
 				// CPU
 
-				const auto cpuState = cpu_->getCurrentCPUState();
+				const auto& cpuState = s.cpu;
 
 				d.drawSection(U"CPU");
 				d.drawLabelAndValue(U"AF  ", U"{:04X}"_fmt(cpuState.af));
@@ -254,25 +297,27 @@ namespace dmge
 				d.drawLabelAndValue(U"SP  ", U"{:04X}"_fmt(cpuState.sp));
 				d.drawLabelAndValue(U"PC  ", U"{:04X}"_fmt(cpuState.pc));
 				d.drawLabelAndValue(U"Halt", U"{:d}"_fmt(cpuState.halt));
-				d.drawLabelAndValue(U"Double Speed", U"{:d}"_fmt(mem_->read(Address::KEY1) >> 7));
+				d.drawLabelAndValue(U"Double Speed", U"{:d}"_fmt(io(Address::KEY1) >> 7));
 				d.drawEmptyLine();
 
 				// Interrupt
 
 				d.drawSection(U"Interrupt");
-				d.drawLabelAndValue(U"IME    ", U"{:d}"_fmt(interrupt_->ime()));
-				d.drawLabelAndValue(U"FF0F IF", Uint8ToHexAndBin(mem_->read(Address::IF)));
-				d.drawLabelAndValue(U"FFFF IE", Uint8ToHexAndBin(mem_->read(Address::IE)));
+				d.drawLabelAndValue(U"IME    ", U"{:d}"_fmt(s.ime));
+				d.drawLabelAndValue(U"FF0F IF", Uint8ToHexAndBin(io(Address::IF)));
+				d.drawLabelAndValue(U"FFFF IE", Uint8ToHexAndBin(io(Address::IE)));
 				d.drawEmptyLine();
 
 				// Sound
 
-				const auto buffer = apu_->getBufferState();
+				const auto& buffer = s.buffer;
 
 				d.drawSection(U"Sound");
-				d.drawLabelAndValue(U"FF26 NR52", Uint8ToHexAndBin(mem_->read(Address::NR52)));
+				d.drawLabelAndValue(U"FF26 NR52", Uint8ToHexAndBin(io(Address::NR52)));
 				d.drawText(U"Stream buffer: {:5d} / {:5d}"_fmt(buffer.remain, buffer.max));
-				d.drawChannelsAmplitude(apu_);
+				d.drawText(U"Under/Overrun: {:5d} / {:5d}"_fmt(buffer.underrun, buffer.overrun));
+				d.drawText(U"Rate ratio: {:.5f}"_fmt(buffer.rateRatio));
+				d.drawChannelsAmplitude(s.amplitude, s.mute);
 				d.drawEmptyLine();
 
 				// Joypad
@@ -280,7 +325,7 @@ namespace dmge
 				const auto gamepad = Gamepad(0);
 
 				d.drawSection(U"Joypad");
-				d.drawLabelAndValue(U"FF00 JOYP", Uint8ToHexAndBin(mem_->read(Address::JOYP)));
+				d.drawLabelAndValue(U"FF00 JOYP", Uint8ToHexAndBin(io(Address::JOYP)));
 				d.drawText(U"Gamepad: {}"_fmt(gamepad.isConnected() ? U"connected" : U"not found"));
 				d.drawEmptyLine();
 			}
@@ -292,7 +337,7 @@ namespace dmge
 				d.drawTileDataTexture(tileDataTexture_);
 				d.drawEmptyLine();
 
-				if (mem_->isCGBMode())
+				if (s.cgbMode)
 				{
 					d.drawTileDataTexture(tileDataTextureCGB_);
 					d.drawEmptyLine();
@@ -1,15 +1,43 @@
 ﻿#pragma once
 
 #include "TileData.h"
+#include "CPU.h"
+#include "Audio/APU.h"
 #include "GUI/TextboxOverlay.h"
+#include <mutex>
 
 namespace dmge
 {
 	class Memory;
-	class CPU;
-	class APU;
 	class Interrupt;
 
+	// デバッグモニタに表示する Core の状態
+	struct DebugMonitorState
+	{
+		bool cgbMode = false;
+		bool sgbMode = false;
+		String mapper;
+		int romBank = 0;
+		int ramBank = 0;
+
+		// IO レジスタ (0xff00 - 0xffff)（表示するレジスタのみ）
+		std::array<uint8, 0x100> io{};
+
+		// メモリダンプ
+		uint16 dumpAddress = 0;
+		std::array<uint8, 64> memoryDump{};
+
+		CPUState cpu{};
+		bool ime = false;
+
+		APUStreamBufferState buffer{};
+		std::array<int, 4> amplitude{};
+		std::array<bool, 4> mute{};
+	};
+
+	// - capture() で Core の状態を取得し、update() と draw() で表示する
+	// - エミュレーションをコアのスレッドで実行している場合は、capture() をコアのスレッドでフレームの間に呼ぶ
+	//   （表示のためにコアのスレッドを止めない）
 	class DebugMonitor
 	{
 	public:
@@ -23,6 +51,11 @@ namespace dmge
 
 		~DebugMonitor();
 
+		// 表示する Core の状態を取得する
+		// Core にアクセスできるスレッド（コアのスレッドで実行している場合はコアのスレッド）から呼ぶ
+		void capture();
+
+		// 入力を処理し、capture() で取得した状態を表示に反映する
 		void update();
 
 		void draw(const Point& pos) const;
@@ -35,13 +68,23 @@ namespace dmge
 		APU* apu_;
 		Interrupt* interrupt_;
 
+		// capture() で取得した状態（mutex_ で保護する）
+		std::mutex mutex_;
+		DebugMonitorState captured_;
+
+		// 表示している状態
+		DebugMonitorState state_;
+
+		// capture() の呼び出し回数（タイルデータの更新間隔用）
+		int captureCount_ = 0;
+
 		// メモリダンプ用
 
 		GUI::TextboxOverlay textbox_{ U"0000", U"Address:" };
-		uint16 dumpAddress_ = 0x0000;
+		std::atomic<uint16> dumpAddress_ = 0x0000;
 		Stopwatch timerTextboxHidden_{};
 
-		// タイルデータ表示用
+		// タイルデータ表示用（画像は mutex_ で保護する）
 
 		TileDataTexture tileDataTexture_;
 		TileDataTexture tileDataTextureCGB_;
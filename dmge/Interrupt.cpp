@@ -1,6 +1,7 @@
 ﻿#include "stdafx.h"
 #include "Interrupt.h"
 #include "Address.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -73,4 +74,20 @@ namespace dmge
 
 		return 0;
 	}
+
+	void Interrupt::saveState(StateWriter& writer) const
+	{
+		writer.write(ime_);
+		writer.write(imeScheduled_);
+		writer.write(if_);
+		writer.write(ie_);
+	}
+
+	void Interrupt::loadState(StateReader& reader)
+	{
+		reader.read(ime_);
+		reader.read(imeScheduled_);
+		reader.read(if_);
+		reader.read(ie_);
+	}
 }
@@ -2,6 +2,9 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	// IME, IF (0xff0f), IE (0xffff)
 
 	class Interrupt
@@ -40,6 +43,11 @@ namespace dmge
 		// IOレジスタからの読み込み
 		uint8 readRegister(uint16 addr) const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		// IME: Interrupt master enable flag
 
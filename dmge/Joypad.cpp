@@ -4,6 +4,7 @@
 #include "Address.h"
 #include "AppConfig.h"
 #include "InputMapping.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -62,6 +63,15 @@ namespace dmge
 	}
 
 	void Joypad::update()
+	{
+		const uint8 buttons = inputState_.load(std::memory_order_relaxed);
+
+		// P1 はボタンが押されている場合に 0
+		dirState_ = ~buttons & 0x0f;
+		actState_ = (~buttons >> 4) & 0x0f;
+	}
+
+	uint8 Joypad::pollInput() const
 	{
 		bool inputRight = inputRight_.pressed();
 		bool inputLeft = inputLeft_.pressed();
@@ -77,17 +87,22 @@ namespace dmge
 			inputDown |= lstick.y > 0.5;
 		}
 
-		dirState_ = 0;
-		dirState_ |= (inputRight ? 0 : 1) << 0;
-		dirState_ |= (inputLeft ? 0 : 1) << 1;
-		dirState_ |= (inputUp ? 0 : 1) << 2;
-		dirState_ |= (inputDown ? 0 : 1) << 3;
-
-		actState_ = 0;
-		actState_ |= (inputA_.pressed() ? 0 : 1) << 0;
-		actState_ |= (inputB_.pressed() ? 0 : 1) << 1;
-		actState_ |= (inputSelect_.pressed() ? 0 : 1) << 2;
-		actState_ |= (inputStart_.pressed() ? 0 : 1) << 3;
+		uint8 buttons = 0;
+		buttons |= (inputRight ? 1 : 0) << FromEnum(JoypadButtons::Right);
+		buttons |= (inputLeft ? 1 : 0) << FromEnum(JoypadButtons::Left);
+		buttons |= (inputUp ? 1 : 0) << FromEnum(JoypadButtons::Up);
+		buttons |= (inputDown ? 1 : 0) << FromEnum(JoypadButtons::Down);
+		buttons |= (inputA_.pressed() ? 1 : 0) << FromEnum(JoypadButtons::A);
+		buttons |= (inputB_.pressed() ? 1 : 0) << FromEnum(JoypadButtons::B);
+		buttons |= (inputSelect_.pressed() ? 1 : 0) << FromEnum(JoypadButtons::Select);
+		buttons |= (inputStart_.pressed() ? 1 : 0) << FromEnum(JoypadButtons::Start);
+
+		return buttons;
+	}
+
+	void Joypad::setInputState(uint8 buttons)
+	{
+		inputState_.store(buttons, std::memory_order_relaxed);
 	}
 
 	void Joypad::setEnable(bool enable)
@@ -135,4 +150,24 @@ namespace dmge
 	{
 		playerCount_ = count;
 	}
+
+	void Joypad::saveState(StateWriter& writer) const
+	{
+		writer.write(selected_);
+		writer.write(dirState_);
+		writer.write(actState_);
+		writer.write(playerCount_);
+		writer.write(joypadId_);
+		writer.write(readyForSwitchJoypad_);
+	}
+
+	void Joypad::loadState(StateReader& reader)
+	{
+		reader.read(selected_);
+		reader.read(dirState_);
+		reader.read(actState_);
+		reader.read(playerCount_);
+		reader.read(joypadId_);
+		reader.read(readyForSwitchJoypad_);
+	}
 }
@@ -4,6 +4,8 @@ namespace dmge
 {
 	class Memory;
 	class InputMapping;
+	class StateWriter;
+	class StateReader;
 
 	class Joypad
 	{
@@ -17,23 +19,43 @@ namespace dmge
 		// IOレジスタからの読み込み
 		uint8 readRegister();
 
-		// 現在の選択状態（方向orアクション）に応じてIOレジスタを更新する
+		// 現在の選択状態（方向orアクション）と setInputState() で設定したボタンの状態に応じてIOレジスタを更新する
+		// デバイスは参照しない
 		void update();
 
 		// ジョイパッド有効／無効を切り替える
-		// 無効の場合、update()が呼ばれてもデバイスからボタンの状態を取得しない
+		// 無効の場合、IOレジスタへの書き込み時にボタンの状態を反映しない
 		void setEnable(bool enable);
 
 		// ボタン割り当てを設定
 		void setMapping(const InputMapping& keyMap, const InputMapping& gamepadMap);
 
+		// デバイスから現在のボタンの状態を取得する
+		// 押されているボタンのビットが 1（ビット位置は JoypadButtons の値）
+		// Siv3D の入力を参照するので、メインスレッドから呼ぶ
+		uint8 pollInput() const;
+
+		// ボタンの状態を設定する（pollInput() と同じ形式）
+		// ホストのフレームごとに1回、pollInput() で取得したものを設定する
+		// どのスレッドから呼んでもよい
+		void setInputState(uint8 buttons);
+
 		// (SGB)
 		void setPlayerCount(int count);
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory* mem_;
 		bool enabled_ = true;
 
+		// setInputState() で設定したボタンの状態
+		// IOレジスタへの書き込みのたびにデバイスを参照しないよう、ホストのフレームごとに1回だけ更新する
+		std::atomic<uint8> inputState_ = 0;
+
 		// P1 & 0x30
 		uint8 selected_ = 0;
 
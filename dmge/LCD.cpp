@@ -3,17 +3,24 @@
 #include "Memory.h"
 #include "BitMask/LCDC.h"
 #include "BitMask/STAT.h"
+#include "SaveState.h"
 
 namespace dmge
 {
 	namespace
 	{
-		ColorF ConvertColorFrom555(uint16 color)
+		// 5bit の色成分を 8bit に変換する（四捨五入）
+		constexpr uint8 Expand5To8(uint16 value)
 		{
-			return ColorF{
-				((color >> 0) & 0x1f) * 1.0 / 0x1f,
-				((color >> 5) & 0x1f) * 1.0 / 0x1f,
-				((color >> 10) & 0x1f) * 1.0 / 0x1f
+			return static_cast<uint8>((value * 255 + 0x1f / 2) / 0x1f);
+		}
+
+		Color ConvertColorFrom555(uint16 color)
+		{
+			return Color{
+				Expand5To8((color >> 0) & 0x1f),
+				Expand5To8((color >> 5) & 0x1f),
+				Expand5To8((color >> 10) & 0x1f)
 			};
 		}
 	}
@@ -23,11 +30,14 @@ namespace dmge
 	{
 		for (int i = 0; i < sgbPaletteColors_.size(); ++i)
 		{
-			sgbPaletteColors_[i][0] = ColorF{ U"#e8e8e8" };
-			sgbPaletteColors_[i][1] = ColorF{ U"#a0a0a0" };
-			sgbPaletteColors_[i][2] = ColorF{ U"#585858" };
-			sgbPaletteColors_[i][3] = ColorF{ U"#101010" };
+			sgbPaletteColors_[i][0] = Color{ U"#e8e8e8" };
+			sgbPaletteColors_[i][1] = Color{ U"#a0a0a0" };
+			sgbPaletteColors_[i][2] = Color{ U"#585858" };
+			sgbPaletteColors_[i][3] = Color{ U"#101010" };
 		}
+
+		dmgPaletteColors_ = sgbPaletteColors_[0];
+		updateDMGPaletteColors_();
 	}
 
 	uint8 LCD::lcdc() const
@@ -192,16 +202,37 @@ namespace dmge
 		return opri_;
 	}
 
-	const ColorF& LCD::bgPaletteColor(uint8 palette, uint8 color) const
+	Color LCD::bgPaletteColor(uint8 palette, uint8 color) const
 	{
 		return bgPaletteColors_[palette][color];
 	}
 
-	const ColorF& LCD::objPaletteColor(uint8 palette, uint8 color) const
+	Color LCD::objPaletteColor(uint8 palette, uint8 color) const
 	{
 		return objPaletteColors_[palette][color];
 	}
 
+	void LCD::setDMGPaletteColors(const std::array<ColorF, 4>& paletteColors)
+	{
+		std::copy(paletteColors.cbegin(), paletteColors.cend(), dmgPaletteColors_.begin());
+		updateDMGPaletteColors_();
+	}
+
+	Color LCD::dmgPaletteColor(Colors::Gray gray) const
+	{
+		return dmgPaletteColors_[FromEnum(gray)];
+	}
+
+	Color LCD::bgpColor(uint8 color) const
+	{
+		return bgpColors_[color];
+	}
+
+	Color LCD::obpColor(uint8 palette, uint8 color) const
+	{
+		return obpColors_[palette][color];
+	}
+
 	void LCD::writeRegister(uint16 addr, uint8 value)
 	{
 		if (addr == Address::LCDC)
@@ -237,14 +268,17 @@ namespace dmge
 		else if (addr == Address::BGP)
 		{
 			bgp_ = value;
+			updateDMGPaletteColors_();
 		}
 		else if (addr == Address::OBP0)
 		{
 			obp0_ = value;
+			updateDMGPaletteColors_();
 		}
 		else if (addr == Address::OBP1)
 		{
 			obp1_ = value;
+			updateDMGPaletteColors_();
 		}
 		else if (addr == Address::WY)
 		{
@@ -395,7 +429,7 @@ namespace dmge
 		sgbPaletteColors_[palette][colorId] = ConvertColorFrom555(color);
 	}
 
-	const ColorF& LCD::sgbPaletteColor(uint8 palette, uint8 color) const
+	Color LCD::sgbPaletteColor(uint8 palette, uint8 color) const
 	{
 		return sgbPaletteColors_[palette][color];
 	}
@@ -409,4 +443,78 @@ namespace dmge
 	//{
 	//	return ConvertColorFrom555(sgbSystemColorPaletteMemory_[palette * 4 + color]);
 	//}
+
+	void LCD::saveState(StateWriter& writer) const
+	{
+		writer.write(lcdc_);
+		writer.write(stat_);
+		writer.write(scy_);
+		writer.write(scx_);
+		writer.write(ly_);
+		writer.write(lyc_);
+		writer.write(bgp_);
+		writer.write(obp0_);
+		writer.write(obp1_);
+		writer.write(wy_);
+		writer.write(wx_);
+		writer.write(opri_);
+		writer.write(spriteSize_);
+		writer.write(windowTileMapAddress_);
+		writer.write(bgTileMapAddress_);
+		writer.write(tileDataAddress_);
+		writer.write(tileDataAddressTop_);
+		writer.write(bgPaletteIndex_);
+		writer.write(bgPaletteIndexAutoIncr_);
+		writer.write(objPaletteIndex_);
+		writer.write(objPaletteIndexAutoIncr_);
+		writer.write(bgPalette_);
+		writer.write(objPalette_);
+		writer.write(bgPaletteColors_);
+		writer.write(objPaletteColors_);
+		writer.write(sgbSystemColorPaletteMemory_);
+		writer.write(sgbPaletteColors_);
+	}
+
+	void LCD::loadState(StateReader& reader)
+	{
+		reader.read(lcdc_);
+		reader.read(stat_);
+		reader.read(scy_);
+		reader.read(scx_);
+		reader.read(ly_);
+		reader.read(lyc_);
+		reader.read(bgp_);
+		reader.read(obp0_);
+		reader.read(obp1_);
+		reader.read(wy_);
+		reader.read(wx_);
+		reader.read(opri_);
+		reader.read(spriteSize_);
+		reader.read(windowTileMapAddress_);
+		reader.read(bgTileMapAddress_);
+		reader.read(tileDataAddress_);
+		reader.read(tileDataAddressTop_);
+		reader.read(bgPaletteIndex_);
+		reader.read(bgPaletteIndexAutoIncr_);
+		reader.read(objPaletteIndex_);
+		reader.read(objPaletteIndexAutoIncr_);
+		reader.read(bgPalette_);
+		reader.read(objPalette_);
+		reader.read(bgPaletteColors_);
+		reader.read(objPaletteColors_);
+		reader.read(sgbSystemColorPaletteMemory_);
+		reader.read(sgbPaletteColors_);
+
+		updateDMGPaletteColors_();
+	}
+
+	void LCD::updateDMGPaletteColors_()
+	{
+		for (uint8 color = 0; color < 4; ++color)
+		{
+			bgpColors_[color] = dmgPaletteColor(bgp(color));
+			obpColors_[0][color] = dmgPaletteColor(obp(0, color));
+			obpColors_[1][color] = dmgPaletteColor(obp(1, color));
+		}
+	}
 }
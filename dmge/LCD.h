@@ -7,6 +7,8 @@
 namespace dmge
 {
 	class Memory;
+	class StateWriter;
+	class StateReader;
 
 	// LCDレジスタ（0xff40-0xff4b, 0xff68-0xff6c）の表示・制御
 
@@ -112,10 +114,23 @@ namespace dmge
 		uint8 opri() const;
 
 		// (CGB) 実際の描画色
-		const ColorF& bgPaletteColor(uint8 palette, uint8 color) const;
+		Color bgPaletteColor(uint8 palette, uint8 color) const;
 
 		// (CGB) 実際の描画色
-		const ColorF& objPaletteColor(uint8 palette, uint8 color) const;
+		Color objPaletteColor(uint8 palette, uint8 color) const;
+
+		// (DMG) 色番号（色の濃さ）から実際の描画色への変換に使う色を設定する
+		void setDMGPaletteColors(const std::array<ColorF, 4>& paletteColors);
+
+		// (DMG) 色の濃さに対する実際の描画色
+		Color dmgPaletteColor(Colors::Gray gray) const;
+
+		// (DMG) BGP で変換した実際の描画色
+		Color bgpColor(uint8 color) const;
+
+		// (DMG) OBP で変換した実際の描画色
+		// palette: 0=OBP0, 1=OBP1
+		Color obpColor(uint8 palette, uint8 color) const;
 
 		// IOレジスタへの書き込み
 		void writeRegister(uint16 addr, uint8 value);
@@ -133,7 +148,7 @@ namespace dmge
 		void setSGBPalette(int palette, int colorId, uint16 color);
 
 		// (SGB) 実際の描画色
-		const ColorF& sgbPaletteColor(uint8 palette, uint8 color) const;
+		Color sgbPaletteColor(uint8 palette, uint8 color) const;
 
 		// (SGB) 実際の描画色
 		void setSGBPaletteColors(uint8 paletteIndex, const std::array<ColorF, 4>& paletteColors);
@@ -141,6 +156,11 @@ namespace dmge
 		// (SGB) 
 		//ColorF sgbSystemColorPaletteMemoryData(int palette, int color) const;
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory& mem_;
 
@@ -179,14 +199,27 @@ namespace dmge
 		std::array<uint8, 64> objPalette_{};
 
 		// (CGB) 色番号から実際の色への変換テーブル
+		// BCPD/OCPD への書き込み時に更新する
+
+		std::array<std::array<Color, 4>, 8> bgPaletteColors_{};
+		std::array<std::array<Color, 4>, 8> objPaletteColors_{};
+
+		// (DMG) 色の濃さから実際の色への変換テーブル
+		std::array<Color, 4> dmgPaletteColors_{};
 
-		std::array<std::array<ColorF, 4>, 8> bgPaletteColors_{};
-		std::array<std::array<ColorF, 4>, 8> objPaletteColors_{};
+		// (DMG) 色番号から実際の色への変換テーブル
+		// BGP/OBP0/OBP1 への書き込み時と、dmgPaletteColors_ の変更時に更新する
+
+		std::array<Color, 4> bgpColors_{};
+		std::array<std::array<Color, 4>, 2> obpColors_{};
 
 		// (SGB) System Color Palette Memory
 		std::array<uint16, 512 * 4> sgbSystemColorPaletteMemory_{};
 
 		// (SGB) 色番号から実際の色への変換テーブル
-		std::array<std::array<ColorF, 4>, 4> sgbPaletteColors_{};
+		std::array<std::array<Color, 4>, 4> sgbPaletteColors_{};
+
+		// (DMG) bgpColors_, obpColors_ を更新する
+		void updateDMGPaletteColors_();
 	};
 }
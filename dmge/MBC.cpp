@@ -1,6 +1,7 @@
 ﻿#include "stdafx.h"
 #include "MBC.h"
 #include "Address.h"
+#include "SaveState.h"
 #include "DebugPrint.h"
 
 namespace dmge
@@ -214,6 +215,96 @@ namespace dmge
 		return cartridgeHeader_;
 	}
 
+	void MBC::saveState(StateWriter& writer) const
+	{
+		writer.write(romBank_);
+		writer.write(ramBank_);
+		writer.write(ramEnabled_);
+		writer.write(boot_);
+
+		// SRAM はカートリッジの容量分だけ含める
+		writer.writeBytes(sram_.data(), ramSizeBytes());
+
+		saveState_(writer);
+	}
+
+	void MBC::loadState(StateReader& reader)
+	{
+		reader.read(romBank_);
+		reader.read(ramBank_);
+		reader.read(ramEnabled_);
+		reader.read(boot_);
+		reader.readBytes(sram_.data(), ramSizeBytes());
+
+		loadState_(reader);
+
+		// ページテーブルを作り直す前に、バンク番号を ROM / SRAM の範囲に収める
+		// BootROM のサイズが足りない場合は修復できないので、読み込みを失敗させる
+		if (romBank_ < 0 || ramBank_ < 0 || (boot_ && boot_.size() < 0x100))
+		{
+			reader.fail();
+			return;
+		}
+
+		romBank_ %= romBankCount_;
+		ramBank_ = Min(ramBank_, static_cast<int>(sram_.size() / 0x2000) - 1);
+	}
+
+	MBCPageUpdate MBC::pageUpdateOnWrite(uint16 addr) const
+	{
+		if (addr <= Address::MBC_RAMEnable_End)
+		{
+			return MBCPageUpdate{ .sram = true };
+		}
+		else if (addr <= Address::MBC_ROMBank_End)
+		{
+			return MBCPageUpdate{ .romx = true };
+		}
+		else if (addr <= Address::MBC_RAMBank_End)
+		{
+			return MBCPageUpdate{ .sram = true };
+		}
+
+		return MBCPageUpdate{};
+	}
+
+	const uint8* MBC::romPage_(uint16 addr, int bank0, int bank) const
+	{
+		if (addr < 0x100 && boot_)
+		{
+			// BootROM
+			return boot_.size() >= 0x100 ? boot_.data() : nullptr;
+		}
+
+		const int offset = (addr & 0x3f00);
+		const size_t romAddr = static_cast<size_t>(addr <= Address::ROMBank0_End ? bank0 : bank) * 0x4000 + offset;
+
+		// ROM のサイズを超える場合は直接読まない
+		if (romAddr + 0x100 > rom_.size())
+		{
+			return nullptr;
+		}
+
+		return rom_.data() + romAddr;
+	}
+
+	uint8* MBC::sramPage_(int bank, uint16 offset)
+	{
+		return const_cast<uint8*>(std::as_const(*this).sramPage_(bank, offset));
+	}
+
+	const uint8* MBC::sramPage_(int bank, uint16 offset) const
+	{
+		const size_t sramAddr = static_cast<size_t>(bank) * 0x2000 + (offset & 0x1f00);
+
+		if (sramAddr + 0x100 > sram_.size())
+		{
+			return nullptr;
+		}
+
+		return sram_.data() + sramAddr;
+	}
+
 	// ------------------------------------------------
 	// No MBC
 	// ------------------------------------------------
@@ -232,6 +323,16 @@ namespace dmge
 		return rom_[addr];
 	}
 
+	const uint8* NoMBC::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, 0, 1);
+		}
+
+		return nullptr;
+	}
+
 	// ------------------------------------------------
 	// MBC1
 	// ------------------------------------------------
@@ -345,6 +446,41 @@ namespace dmge
 		return 0;
 	}
 
+	const uint8* MBC1::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, requiredRomBanking_() ? rom0BankInBankingMode_() : 0, romBank_);
+		}
+		else if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_)
+		{
+			return sramPage_(ramBankInBankingMode_(), addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	uint8* MBC1::writablePage(uint16 addr)
+	{
+		if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_)
+		{
+			return sramPage_(ramBankInBankingMode_(), addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	MBCPageUpdate MBC1::pageUpdateOnWrite(uint16 addr) const
+	{
+		if (addr <= Address::MBC_ROMBank_End)
+		{
+			return MBC::pageUpdateOnWrite(addr);
+		}
+
+		// セカンダリバンク・バンキングモードは ROM・SRAM の両方のバンクに影響する
+		return MBCPageUpdate{ .rom0 = true, .romx = true, .sram = true };
+	}
+
 	int MBC1::ramBankInBankingMode_() const
 	{
 		return bankingMode_ == 0 ? 0 : ramBank_;
@@ -365,6 +501,21 @@ namespace dmge
 		return cartridgeHeader_.ramSizeKB == 32;
 	}
 
+	void MBC1::saveState_(StateWriter& writer) const
+	{
+		writer.write(secondaryBank_);
+		writer.write(bankingMode_);
+	}
+
+	void MBC1::loadState_(StateReader& reader)
+	{
+		reader.read(secondaryBank_);
+		reader.read(bankingMode_);
+
+		secondaryBank_ &= 0b11;
+		bankingMode_ &= 1;
+	}
+
 	// ------------------------------------------------
 	// MBC2
 	// ------------------------------------------------
@@ -438,6 +589,28 @@ namespace dmge
 		return 0;
 	}
 
+	const uint8* MBC2::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, 0, romBank_);
+		}
+
+		// 内蔵 RAM は下位4ビットのみ有効なので、直接読み書きしない
+		return nullptr;
+	}
+
+	MBCPageUpdate MBC2::pageUpdateOnWrite(uint16 addr) const
+	{
+		// アドレスの bit 8 が立っていれば ROM バンク、そうでなければ RAM の有効化（内蔵 RAM はページに含めない）
+		if (addr <= Address::MBC_ROMBank_End && (addr & 0x0100))
+		{
+			return MBCPageUpdate{ .romx = true };
+		}
+
+		return MBCPageUpdate{};
+	}
+
 	// ------------------------------------------------
 	// MBC3
 	// ------------------------------------------------
@@ -548,6 +721,30 @@ namespace dmge
 		return 0;
 	}
 
+	const uint8* MBC3::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, 0, romBank_);
+		}
+		else if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_ && not rtc_.selected())
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	uint8* MBC3::writablePage(uint16 addr)
+	{
+		if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_ && not rtc_.selected())
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
 	void MBC3::update(int cycles)
 	{
 		rtc_.update(cycles);
@@ -588,6 +785,16 @@ namespace dmge
 		}
 	}
 
+	void MBC3::saveState_(StateWriter& writer) const
+	{
+		rtc_.saveState(writer);
+	}
+
+	void MBC3::loadState_(StateReader& reader)
+	{
+		rtc_.loadState(reader);
+	}
+
 	// ------------------------------------------------
 	// MBC5
 	// ------------------------------------------------
@@ -676,6 +883,30 @@ namespace dmge
 		return 0;
 	}
 
+	const uint8* MBC5::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, 0, romBank_);
+		}
+		else if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_)
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	uint8* MBC5::writablePage(uint16 addr)
+	{
+		if (addr >= Address::SRAM && addr <= Address::SRAM_End && ramEnabled_)
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
 	// ------------------------------------------------
 	// HuC1
 	// ------------------------------------------------
@@ -760,4 +991,38 @@ namespace dmge
 
 		return 0;
 	}
+
+	const uint8* HuC1::readablePage(uint16 addr) const
+	{
+		if (addr <= Address::SwitchableROMBank_End)
+		{
+			return romPage_(addr, 0, romBank_);
+		}
+		else if (addr >= Address::SRAM && addr <= Address::SRAM_End && not ir_)
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	uint8* HuC1::writablePage(uint16 addr)
+	{
+		if (addr >= Address::SRAM && addr <= Address::SRAM_End && not ir_)
+		{
+			return sramPage_(ramBank_, addr - Address::SRAM);
+		}
+
+		return nullptr;
+	}
+
+	void HuC1::saveState_(StateWriter& writer) const
+	{
+		writer.write(ir_);
+	}
+
+	void HuC1::loadState_(StateReader& reader)
+	{
+		reader.read(ir_);
+	}
 }
@@ -5,6 +5,22 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
+	// MBC のレジスタへの書き込みで、ページ（readablePage / writablePage の結果）が変化しうる領域
+	struct MBCPageUpdate
+	{
+		// 0x0000 - 0x3fff
+		bool rom0 = false;
+
+		// 0x4000 - 0x7fff
+		bool romx = false;
+
+		// 0xa000 - 0xbfff
+		bool sram = false;
+	};
+
 	class MBC
 	{
 	public:
@@ -18,6 +34,16 @@ namespace dmge
 
 		virtual void update(int cycles) {}
 
+		// addr を含む 256 バイトのページの先頭へのポインタを返す（Memory のページテーブル用）
+		// 現在のバンク・RAM の有効状態で MBC を介さずに直接読み書きできない場合は nullptr を返す
+		virtual const uint8* readablePage(uint16 addr) const { return nullptr; }
+
+		virtual uint8* writablePage(uint16 addr) { return nullptr; }
+
+		// addr (0x0000 - 0x7fff) への書き込みでページが変化しうる領域を返す
+		// 既定では 0x0000 - 0x1fff を RAM の有効化、0x2000 - 0x3fff を ROM バンク、0x4000 - 0x5fff を RAM バンクとする
+		virtual MBCPageUpdate pageUpdateOnWrite(uint16 addr) const;
+
 		static std::unique_ptr<MBC> LoadCartridge(FilePath cartridgePath);
 
 		void loadSRAM();
@@ -43,10 +69,20 @@ namespace dmge
 
 		const CartridgeHeader& cartridgeHeader() const;
 
+		// セーブステート
+		// バンク・SRAM・BootROM の状態を含める（ROM の内容は含めない）
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		virtual void loadSRAM_(FilePathView saveFilePath);
 		virtual void saveSRAM_(FilePathView saveFilePath);
 
+		// 派生クラス固有の状態
+		virtual void saveState_(StateWriter& writer) const {}
+		virtual void loadState_(StateReader& reader) {}
+
 	protected:
 		String cartridgePath_;
 
@@ -70,6 +106,14 @@ namespace dmge
 		int romBankCount_;
 
 		void loadCartridge_(FilePath cartridgePath);
+
+		// ROM 領域 (0x0000 - 0x7fff) のページ
+		// BootROM が有効な場合は 0x0000 - 0x00ff を BootROM とする
+		const uint8* romPage_(uint16 addr, int bank0, int bank) const;
+
+		// SRAM の bank 番目のバンクの、offset を含むページ
+		uint8* sramPage_(int bank, uint16 offset);
+		const uint8* sramPage_(int bank, uint16 offset) const;
 	};
 
 	class NoMBC : public MBC
@@ -80,6 +124,8 @@ namespace dmge
 		virtual void write(uint16 addr, uint8 value) override;
 
 		virtual uint8 read(uint16 addr) const override;
+
+		const uint8* readablePage(uint16 addr) const override;
 	};
 
 	class MBC1 : public MBC
@@ -90,11 +136,19 @@ namespace dmge
 		void write(uint16 addr, uint8 value) override;
 
 		uint8 read(uint16 addr) const override;
+		const uint8* readablePage(uint16 addr) const override;
+
+		uint8* writablePage(uint16 addr) override;
+
+		MBCPageUpdate pageUpdateOnWrite(uint16 addr) const override;
 
 	private:
 		int secondaryBank_ = 0;
 		int bankingMode_ = 0;
 
+		void saveState_(StateWriter& writer) const override;
+		void loadState_(StateReader& reader) override;
+
 		int ramBankInBankingMode_() const;
 		int rom0BankInBankingMode_() const;
 		bool requiredRomBanking_() const;
@@ -109,6 +163,9 @@ namespace dmge
 		void write(uint16 addr, uint8 value) override;
 
 		uint8 read(uint16 addr) const override;
+		const uint8* readablePage(uint16 addr) const override;
+
+		MBCPageUpdate pageUpdateOnWrite(uint16 addr) const override;
 	};
 
 	class MBC3 : public MBC
@@ -119,12 +176,18 @@ namespace dmge
 		void write(uint16 addr, uint8 value) override;
 
 		uint8 read(uint16 addr) const override;
+		const uint8* readablePage(uint16 addr) const override;
+
+		uint8* writablePage(uint16 addr) override;
 
 		void update(int cycles) override;
 
 	private:
 		RTC rtc_;
 
+		void saveState_(StateWriter& writer) const override;
+		void loadState_(StateReader& reader) override;
+
 		virtual void loadSRAM_(FilePathView saveFilePath) override;
 		virtual void saveSRAM_(FilePathView saveFilePath) override;
 	};
@@ -137,6 +200,9 @@ namespace dmge
 		void write(uint16 addr, uint8 value) override;
 
 		uint8 read(uint16 addr) const override;
+		const uint8* readablePage(uint16 addr) const override;
+
+		uint8* writablePage(uint16 addr) override;
 
 	};
 
@@ -148,8 +214,14 @@ namespace dmge
 		void write(uint16 addr, uint8 value) override;
 
 		uint8 read(uint16 addr) const override;
+		const uint8* readablePage(uint16 addr) const override;
+
+		uint8* writablePage(uint16 addr) override;
 
 	private:
 		bool ir_ = false;
+
+		void saveState_(StateWriter& writer) const override;
+		void loadState_(StateReader& reader) override;
 	};
 }
@@ -1,10 +1,19 @@
 ﻿#include "stdafx.h"
 #include "App.h"
 #include "AppConfig.h"
+#include "Core.h"
+#include "PPU.h"
+#include "PPUConstants.h"
+#include "Timing.h"
 #include "DebugPrint.h"
 #include "DebugMonitor.h"
 #include "Version.h"
 
+#if defined(DMGE_HEADLESS)
+// ウィンドウ・GPU を使用しない（ベンチマーク専用のビルド）
+SIV3D_SET(EngineOption::Renderer::Headless)
+#endif
+
 namespace
 {
 	void LoadAssets()
@@ -43,77 +52,244 @@ namespace
 		Profiler::EnableAssetCreationWarning(false);
 	}
 
-#if SIV3D_PLATFORM(WINDOWS)
-	void SaveScreenshot(FilePathView path)
+	// コマンドライン引数からベンチマークの設定を取得する
+	// dmge --benchmark <cartridge> [frames]
+	bool ParseBenchmarkArgs(FilePath& cartridgePath, int& frames)
 	{
-		ScreenCapture::SaveCurrentFrame(path + U"");
-		System::Update();
+		const auto args = System::GetCommandLineArgs();
+
+		for (size_t i = 0; i < args.size(); ++i)
+		{
+			if (args[i] != U"--benchmark") continue;
+
+			if (i + 1 >= args.size()) return false;
+
+			cartridgePath = args[i + 1];
+
+			if (i + 2 < args.size())
+			{
+				frames = Max(ParseOr<int>(args[i + 2], frames), 1);
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	// テスト ROM のディレクトリ（既定）
+	const FilePath DefaultTestRomDirectory = U"cartridges/test/mooneye";
+
+	// テスト ROM の実行を打ち切るフレーム数
+	constexpr int TestTimeoutFrames = 60 * 60;
+
+	// テスト ROM を1つ実行し、結果を返す
+	// 時間内に終了しなかった場合は MooneyeTestResult::Running
+	// framebufferPath が空でなければ、終了時の画面を保存する
+	dmge::MooneyeTestResult RunTestRom(FilePathView testRomPath, FilePathView framebufferPath)
+	{
+		dmge::Core core{ true };
+
+		if (not core.loadCartridge(testRomPath))
+		{
+			return dmge::MooneyeTestResult::Failed;
+		}
+
+		core.boot(dmge::CoreBootOptions{});
+
+		for (int frame = 0; frame < TestTimeoutFrames && core.mooneyeTestResult() == dmge::MooneyeTestResult::Running; ++frame)
+		{
+			core.runFrame();
+		}
+
+		if (not framebufferPath.isEmpty())
+		{
+			core.ppu().canvas().clipped(0, 0, dmge::LCDSize.x, dmge::LCDSize.y).save(framebufferPath);
+		}
+
+		return core.mooneyeTestResult();
+	}
+
+	// コマンドライン引数からテスト ROM 実行モードの設定を取得する
+	// dmge --test [directory] [--dump]
+	bool ParseTestArgs(FilePath& testRomDirectory, bool& dumpFramebuffer)
+	{
+		const auto args = System::GetCommandLineArgs();
+
+		if (not args.includes(U"--test")) return false;
+
+		dumpFramebuffer = args.includes(U"--dump");
+
+		for (size_t i = 0; i + 1 < args.size(); ++i)
+		{
+			if (args[i] == U"--test" && not args[i + 1].starts_with(U"--"))
+			{
+				testRomDirectory = args[i + 1];
+			}
+		}
+
+		return true;
 	}
-#endif
 }
 
-#if SIV3D_PLATFORM(WINDOWS)
-void runTest(dmge::AppConfig& config)
+// テスト ROM 実行モード
+// ディレクトリ内の各テスト ROM を、スレッドプール上でそれぞれ別のエミュレータ（ヘッドレス）で実行する
+// 結果を mooneye_test_result.csv に出力し、dumpFramebuffer == true の場合は終了時の画面を PNG で保存する
+void runTest(FilePathView testRomDirectory, bool dumpFramebuffer)
 {
-	config.cartridgePath.clear();
-	config.detectCGB = true;
-	config.detectSGB = true;
-	config.bootROMPath.clear();
-	config.scale = 2;
-	config.showFPS = false;
-	config.palettePreset = 1;
-	config.cgbColorGamma = 1.0;
-	config.showDebugMonitor = false;
-	config.showConsole = true;
-	config.breakpoints.clear();
-	config.memoryWriteBreakpoints.clear();
-	config.breakOnLDBB = false;
-	config.enableBreakpoint = false;
-	config.dumpAddress.clear();
-	config.traceDumpStartAddress.clear();
-	config.logFilePath.clear();
-
 	dmge::DebugPrint::EnableConsole();
 
-	LoadAssets();
+	const Array<FilePath> testRomPaths = FileSystem::DirectoryContents(testRomDirectory, Recursive::Yes)
+		.filter([](const FilePath& path) { return FileSystem::Extension(path) == U"gb"; });
 
-	InitScene();
+	const FilePath ssDirName = U"mooneye_test_result_{}"_fmt(DateTime::Now().format(U"yyyyMMdd_HHmmss"));
+
+	Array<dmge::MooneyeTestResult> results(testRomPaths.size(), dmge::MooneyeTestResult::Running);
+
+	// 各スレッドは、まだ実行していないテスト ROM を1つずつ取り出して実行する
+	std::atomic<size_t> nextIndex = 0;
+
+	const auto worker = [&]() {
+		for (size_t i = nextIndex++; i < testRomPaths.size(); i = nextIndex++)
+		{
+			const FilePath framebufferPath = dumpFramebuffer ? U"{}/{}.png"_fmt(ssDirName, FileSystem::BaseName(testRomPaths[i])) : U"";
+
+			results[i] = RunTestRom(testRomPaths[i], framebufferPath);
+		}
+	};
+
+	const size_t threadCount = Max<size_t>(Min<size_t>(Threading::GetConcurrency(), testRomPaths.size()), 1);
+
+	const Stopwatch totalTime{ StartImmediately::Yes };
+
+	Array<std::thread> threads;
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
 
 	TextWriter writer{ U"mooneye_test_result.csv" };
 
-	const FilePath ssDirName = U"mooneye_test_result_{}"_fmt(DateTime::Now().format(U"yyyyMMdd_HHmmss"));
+	size_t passedCount = 0;
+
+	for (const auto& [i, testRomPath] : Indexed(testRomPaths))
+	{
+		const bool passed = results[i] == dmge::MooneyeTestResult::Passed;
+		passedCount += passed;
 
-	const auto mooneyeTestRoms = FileSystem::DirectoryContents(U"cartridges/test/mooneye", Recursive::Yes);
+		writer.writeln(U"{},{}"_fmt(testRomPath, passed ? 1 : 0));
+	}
+
+	dmge::DebugPrint::Writeln(U"* Test: Passed={}/{} Threads={} Time={:.3f}s"_fmt(passedCount, testRomPaths.size(), threadCount, totalTime.sF()));
+}
+
+// ベンチマークモード
+// 描画・オーディオ出力・入力を行わずに指定したフレーム数をできるだけ速く実行し、実行速度を表示する
+void runBenchmark(FilePathView cartridgePath, int frames)
+{
+	dmge::DebugPrint::EnableConsole();
 
-	for (const auto& testRomPath : mooneyeTestRoms)
+	dmge::Core core{ true };
+
+	if (not core.loadCartridge(cartridgePath))
 	{
-		if (FileSystem::Extension(testRomPath) != U"gb") continue;
+		dmge::DebugPrint::Writeln(U"* Cannot open cartridge: {}"_fmt(cartridgePath));
+		return;
+	}
 
-		auto app = std::make_unique<dmge::DmgeApp>(config);
+	core.boot(dmge::CoreBootOptions{});
 
-		app->setCartridgePath(testRomPath);
+	// 各フレームの実行時間 (ms)
+	Array<double> frameTimes;
+	frameTimes.reserve(frames);
 
-		app->run();
+	const Stopwatch totalTime{ StartImmediately::Yes };
+
+	for (int i = 0; i < frames; ++i)
+	{
+		const Stopwatch frameTime{ StartImmediately::Yes };
+
+		core.runFrame();
 
-		SaveScreenshot(U"{}/{}.png"_fmt(ssDirName, FileSystem::BaseName(testRomPath)));
+		frameTimes.push_back(frameTime.msF());
 
-		writer.writeln(U"{},{}"_fmt(testRomPath, app->mooneyeTestResult() == dmge::MooneyeTestResult::Passed ? 1 : 0));
+		// テスト ROM が終了した
+		if (core.mooneyeTestResult() != dmge::MooneyeTestResult::Running) break;
 	}
+
+	const double totalSec = totalTime.sF();
+
+	frameTimes.sort();
+
+	const auto percentile = [&](double p) {
+		return frameTimes[Min(static_cast<size_t>(frameTimes.size() * p / 100), frameTimes.size() - 1)];
+	};
+
+	const double emulatedFPS = frameTimes.size() / totalSec;
+
+	dmge::DebugPrint::Writeln(U"* Benchmark:");
+	dmge::DebugPrint::Writeln(U"FileName={}"_fmt(FileSystem::FileName(cartridgePath)));
+	dmge::DebugPrint::Writeln(U"Frames={} Time={:.3f}s"_fmt(frameTimes.size(), totalSec));
+	dmge::DebugPrint::Writeln(U"FPS={:.1f} ({:.2f}x)"_fmt(emulatedFPS, emulatedFPS / (1.0 * dmge::ClockFrequency / dmge::FrameDots)));
+	dmge::DebugPrint::Writeln(U"Instructions/s={:.0f}"_fmt(core.instructionCount() / totalSec));
+	dmge::DebugPrint::Writeln(U"FrameTime(ms) min={:.3f} avg={:.3f} p50={:.3f} p90={:.3f} p99={:.3f} max={:.3f}"_fmt(
+		frameTimes.front(),
+		frameTimes.sum() / frameTimes.size(),
+		percentile(50),
+		percentile(90),
+		percentile(99),
+		frameTimes.back()));
 }
-#endif
 
 void Main()
 {
+	// ベンチマークモード
+	{
+		FilePath benchmarkCartridgePath;
+		int benchmarkFrames = 3600;
+
+		if (ParseBenchmarkArgs(benchmarkCartridgePath, benchmarkFrames))
+		{
+			runBenchmark(benchmarkCartridgePath, benchmarkFrames);
+			return;
+		}
+	}
+
+	// テスト ROM 実行モード
+	{
+		FilePath testRomDirectory = DefaultTestRomDirectory;
+		bool dumpFramebuffer = false;
+
+		if (ParseTestArgs(testRomDirectory, dumpFramebuffer))
+		{
+			runTest(testRomDirectory, dumpFramebuffer);
+			return;
+		}
+	}
+
+#if defined(DMGE_HEADLESS)
+	dmge::DebugPrint::EnableConsole();
+	dmge::DebugPrint::Writeln(U"Usage: dmge --benchmark <cartridge> [frames]");
+	dmge::DebugPrint::Writeln(U"       dmge --test [directory] [--dump]");
+	return;
+#endif
+
 #if SIV3D_PLATFORM(WINDOWS)
 	dmge::AppConfig config = dmge::AppConfig::LoadConfig();
-#elif SIV3D_PLATFORM(WEB)
+#else
 	dmge::AppConfig config;
 #endif
 
 #if SIV3D_PLATFORM(WINDOWS)
 	if (config.testMode)
 	{
-		runTest(config);
+		runTest(DefaultTestRomDirectory, true);
 		return;
 	}
 
@@ -9,6 +9,7 @@
 #include "Serial.h"
 #include "Interrupt.h"
 #include "DebugPrint.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -89,6 +90,8 @@ namespace dmge
 
 		mem_.resize(0x10000);
 
+		updatePages_();
+
 		return true;
 	}
 
@@ -114,20 +117,50 @@ namespace dmge
 			}
 		}
 
+		// ページテーブルにより直接書き込めるメモリ（WRAM・SRAM）
+
+		if (uint8* page = writePages_[addr >> 8])
+		{
+			page[addr & 0xff] = value;
+			return;
+		}
+
 		if (addr <= Address::SwitchableROMBank_End)
 		{
 			// MBC
 			// 0x0000 - 0x7fff
 
 			mbc_->write(addr, value);
+
+			// バンクや RAM の有効状態が変化しうるので、書き込んだレジスタが影響する領域のページを更新する
+			const auto update = mbc_->pageUpdateOnWrite(addr);
+
+			if (update.rom0)
+			{
+				updateROMPages_(0x00, 0x3f);
+			}
+
+			if (update.romx)
+			{
+				updateROMPages_(0x40, 0x7f);
+			}
+
+			if (update.sram)
+			{
+				updateSRAMPages_();
+			}
 		}
 		else if (addr <= Address::VRAM_End)
 		{
 			// VRAM
 			// 0x8000 - 0x9fff
 
+			ppu_->syncForWrite();
+
 			vram_[vramBank_][addr - Address::VRAM] = value;
 
+			tileCache_.update(vram_[vramBank_], vramBank_, addr);
+
 			vramTileDataModified_ = true;
 		}
 		else if (addr <= Address::SRAM_End)
@@ -164,6 +197,8 @@ namespace dmge
 			// 0xfe00 - 0xfe9f
 			// ...
 
+			ppu_->sync();
+
 			goto Fallback_WriteToMemory;
 		}
 		else if (addr <= 0xfeff)
@@ -182,6 +217,9 @@ namespace dmge
 
 			if (isSGBMode())
 			{
+				// SGBコマンドにより PPU の状態が変化しうる
+				ppu_->syncForWrite();
+
 				sgbCommand_->send((value >> 4) & 0b11);
 			}
 		}
@@ -190,6 +228,7 @@ namespace dmge
 			// Serial
 			// 0xff01 - 0xff02
 
+			serial_->sync();
 			serial_->writeRegister(addr, value);
 		}
 		else if (addr <= 0xff03)
@@ -204,6 +243,13 @@ namespace dmge
 			// Timer
 			// 0xff04 - 0xff07
 
+			// APU の Frame Sequencer は DIV を参照するので、DIV のリセット前に APU を進めておく
+			if (addr == Address::DIV)
+			{
+				apu_->sync();
+			}
+
+			timer_->sync();
 			timer_->writeRegister(addr, value);
 		}
 		else if (addr <= 0xff0e)
@@ -225,6 +271,8 @@ namespace dmge
 			// APU
 			// 0xff10 - 0xff25
 
+			apu_->sync();
+
 			// Ignore if APU is off
 			if ((apu_->readRegister(Address::NR52) & 0x80) == 0)
 			{
@@ -253,6 +301,7 @@ namespace dmge
 			// APU master switch ~ wave RAM
 			// 0xff26 - 0xff3f
 
+			apu_->sync();
 			apu_->writeRegister(addr, value);
 		}
 		else if (addr <= Address::LYC)
@@ -260,13 +309,17 @@ namespace dmge
 			// LCDC, STAT, Scroll, LY, LYC
 			// 0xff40 - 0xff45
 
+			ppu_->syncForWrite();
 			lcd_->writeRegister(addr, value);
+			ppu_->scheduleNextDot();
 		}
 		else if (addr <= Address::DMA)
 		{
 			// DMA
 			// 0xff46
 
+			ppu_->sync();
+
 			dma_.start(value);
 			goto Fallback_WriteToMemory;
 		}
@@ -275,7 +328,9 @@ namespace dmge
 			// Palette (BGP, OBP0/1), Window (WY, WX)
 			// 0xff47 - 0xff4b
 
+			ppu_->syncForWrite();
 			lcd_->writeRegister(addr, value);
+			ppu_->scheduleNextDot();
 		}
 		else if (addr <= 0xff4c)
 		{
@@ -310,6 +365,8 @@ namespace dmge
 
 			vramBank_ = value & 1;
 			value |= 0xfe;
+
+			updateVRAMPages_();
 			goto Fallback_WriteToMemory;
 		}
 		else if (addr <= Address::BANK)
@@ -388,6 +445,7 @@ namespace dmge
 			// (CGB) Palette, OBJ priority mode
 			// 0xff68 - 0xff6c
 
+			ppu_->syncForWrite();
 			lcd_->writeRegister(addr, value);
 		}
 		else if (addr <= 0xff6f)
@@ -406,6 +464,8 @@ namespace dmge
 			wramBank_ = value & 0b111;
 			value |= 0xf8;
 
+			updateWRAMPages_();
+
 			goto Fallback_WriteToMemory;
 		}
 		else if (addr <= 0xff75)
@@ -459,6 +519,13 @@ namespace dmge
 
 	uint8 Memory::read(uint16 addr) const
 	{
+		// ページテーブルにより直接読めるメモリ（ROM・VRAM・SRAM・WRAM）
+
+		if (const uint8* page = readPages_[addr >> 8])
+		{
+			return page[addr & 0xff];
+		}
+
 		if (addr <= Address::SwitchableROMBank_End)
 		{
 			// MBC
@@ -529,6 +596,7 @@ namespace dmge
 			// Serial
 			// 0xff01 - 0xff02
 
+			serial_->sync();
 			return serial_->readRegister(addr);
 		}
 		else if (addr <= 0xff03)
@@ -541,6 +609,7 @@ namespace dmge
 			// Timer
 			// 0xff04 - 0xff07
 
+			timer_->sync();
 			return timer_->readRegister(addr);
 		}
 		else if (addr <= 0xff0e)
@@ -560,6 +629,7 @@ namespace dmge
 			// APU
 			// 0xff10 - 0xff3f
 
+			apu_->sync();
 			return apu_->readRegister(addr);
 		}
 		else if (addr <= Address::LYC)
@@ -567,6 +637,7 @@ namespace dmge
 			// LCDC, STAT, Scroll, LY, LYC
 			// 0xff40 - 0xff45
 
+			ppu_->sync();
 			return lcd_->readRegister(addr);
 		}
 		else if (addr <= Address::DMA)
@@ -685,20 +756,43 @@ namespace dmge
 		return read(addr) | (read(addr + 1) << 8);
 	}
 
+	const uint8* Memory::romPage(uint16 addr) const
+	{
+		if (addr > Address::SwitchableROMBank_End) return nullptr;
+
+		return readPages_[addr >> 8];
+	}
+
 	uint16 Memory::read16VRAMBank(uint16 addr, int bank) const
 	{
 		return vram_[bank][addr - Address::VRAM] | (vram_[bank][addr + 1 - Address::VRAM] << 8);
 	}
 
+	const TileCache& Memory::tileCache() const
+	{
+		return tileCache_;
+	}
+
 	void Memory::update(int cycles)
 	{
 		mbc_->update(cycles);
 
+		// OAM DMA 転送中は、転送による OAM の書き換えより前に PPU を進めておく
+		if (dma_.running())
+		{
+			ppu_->sync();
+		}
+
 		dma_.update(cycles);
 
 		cyclesTotal_ += cycles;
 	}
 
+	bool Memory::isOAMDMARunning() const
+	{
+		return dma_.running();
+	}
+
 	bool Memory::isSupportedCGBMode() const
 	{
 		return (FromEnum(mbc_->cgbFlag()) & 0x80) == 0x80;
@@ -769,11 +863,15 @@ namespace dmge
 	void Memory::enableBootROM(FilePathView bootROMPath)
 	{
 		mbc_->enableBootROM(bootROMPath);
+
+		updateCartridgePages_();
 	}
 
 	void Memory::disableBootROM()
 	{
 		mbc_->disableBootROM();
+
+		updateCartridgePages_();
 	}
 
 	bool Memory::isVRAMTileDataModified()
@@ -790,12 +888,21 @@ namespace dmge
 	{
 		if (doubleSpeedPrepared_)
 		{
+			// 切り替え前の速度で現在時刻まで進めておく
+			ppu_->sync();
+			apu_->sync();
+			timer_->sync();
+
 			doubleSpeed_ = not doubleSpeed_;
 			doubleSpeedPrepared_ = false;
 
 			timer_->resetDIV();
 
 			apu_->setDoubleSpeed(doubleSpeed_);
+
+			// 新しい速度でイベントを登録し直す
+			ppu_->sync();
+			apu_->sync();
 		}
 	}
 
@@ -803,4 +910,118 @@ namespace dmge
 	{
 		return doubleSpeed_;
 	}
+
+	void Memory::updatePages_()
+	{
+		updateCartridgePages_();
+		updateVRAMPages_();
+		updateWRAMPages_();
+	}
+
+	void Memory::updateCartridgePages_()
+	{
+		updateROMPages_(0x00, 0x7f);
+		updateSRAMPages_();
+	}
+
+	void Memory::updateROMPages_(uint16 pageBegin, uint16 pageEnd)
+	{
+		// ROM
+		// 0x0000 - 0x7fff
+		for (uint16 page = pageBegin; page <= pageEnd; ++page)
+		{
+			readPages_[page] = mbc_->readablePage(page << 8);
+		}
+	}
+
+	void Memory::updateSRAMPages_()
+	{
+		// SRAM
+		// 0xa000 - 0xbfff
+		for (uint16 page = 0xa0; page <= 0xbf; ++page)
+		{
+			readPages_[page] = mbc_->readablePage(page << 8);
+			writePages_[page] = mbc_->writablePage(page << 8);
+		}
+	}
+
+	void Memory::updateVRAMPages_()
+	{
+		// VRAM
+		// 0x8000 - 0x9fff
+		// 書き込みは PPU との同期が必要なので、読み込みのみ
+		for (uint16 page = 0x80; page <= 0x9f; ++page)
+		{
+			readPages_[page] = vram_[vramBank_].data() + ((page << 8) - Address::VRAM);
+		}
+	}
+
+	void Memory::updateWRAMPages_()
+	{
+		// WRAM
+		// 0xc000 - 0xdfff
+		// Echo of WRAM
+		// 0xe000 - 0xfdff
+		// Echo への書き込みは、書き込み時フックに WRAM のアドレスを渡すため従来の処理で行う
+		for (uint16 page = 0xc0; page <= 0xfd; ++page)
+		{
+			const uint16 addr = (page <= 0xdf ? page : page - 0x20) << 8;
+			uint8* p = (addr <= Address::WRAM0_End)
+				? wram_[0].data() + (addr - Address::WRAM0)
+				: wram_[wramBank_].data() + (addr - Address::WRAM1);
+
+			readPages_[page] = p;
+			writePages_[page] = (page <= 0xdf) ? p : nullptr;
+		}
+	}
+
+	void Memory::saveState(StateWriter& writer) const
+	{
+		writer.writeBytes(mem_.data(), mem_.size());
+		writer.write(vram_);
+		writer.write(vramBank_);
+		writer.write(wram_);
+		writer.write(wramBank_);
+		writer.write(hblankDMATransferring_);
+		writer.write(cgbMode_);
+		writer.write(doubleSpeed_);
+		writer.write(doubleSpeedPrepared_);
+		writer.write(sgbMode_);
+
+		dma_.saveState(writer);
+		sgbCommand_->saveState(writer);
+		mbc_->saveState(writer);
+	}
+
+	void Memory::loadState(StateReader& reader)
+	{
+		reader.readBytes(mem_.data(), mem_.size());
+		reader.read(vram_);
+		reader.read(vramBank_);
+		reader.read(wram_);
+		reader.read(wramBank_);
+		reader.read(hblankDMATransferring_);
+		reader.read(cgbMode_);
+		reader.read(doubleSpeed_);
+		reader.read(doubleSpeedPrepared_);
+		reader.read(sgbMode_);
+
+		dma_.loadState(reader);
+		sgbCommand_->loadState(reader);
+		mbc_->loadState(reader);
+
+		// 読み込みに失敗した場合は、呼び出し元が元の状態に戻すのでページテーブルは作り直さない
+		if (reader.failed()) return;
+
+		// ページテーブルを作り直す前に、バンク番号をレジスタへの書き込みと同じ範囲に収める
+		// （不正なデータや別のカートリッジのデータでも、VRAM / WRAM の外を指さないようにする）
+		vramBank_ &= 1;
+		wramBank_ = Max(1, wramBank_ & 0b111);
+
+		// VRAM の内容が変わったので、タイルデータを参照している表示も更新させる
+		tileCache_.rebuild(vram_);
+		vramTileDataModified_ = true;
+
+		updatePages_();
+	}
 }
@@ -4,6 +4,7 @@
 #include "Address.h"
 #include "DMA.h"
 #include "SGB/Command.h"
+#include "TileData.h"
 
 namespace dmge
 {
@@ -16,6 +17,8 @@ namespace dmge
 	class LCD;
 	class Interrupt;
 	class PacketTransfer;
+	class StateWriter;
+	class StateReader;
 
 	class Memory
 	{
@@ -46,6 +49,14 @@ namespace dmge
 
 		uint16 read16VRAMBank(uint16 addr, int bank) const;
 
+		// デコード済みのタイルデータ
+		const TileCache& tileCache() const;
+
+		// ROM 領域 (0x0000-0x7fff) のアドレスについて、直接読めるページのポインタを返す
+		// 直接読めない場合や ROM 領域外の場合は nullptr
+		// ページの内容は書き換わらないので、同じポインタであれば同じ内容とみなせる
+		const uint8* romPage(uint16 addr) const;
+
 		void update(int cycles);
 
 		bool isSupportedCGBMode() const;
@@ -88,6 +99,14 @@ namespace dmge
 		void switchDoubleSpeed();
 		bool isDoubleSpeed() const;
 
+		// OAM DMA 転送中か
+		bool isOAMDMARunning() const;
+
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		PPU* ppu_ = nullptr;
 		APU* apu_ = nullptr;
@@ -108,10 +127,19 @@ namespace dmge
 		int vramBank_ = 0;
 		bool vramTileDataModified_ = false;
 
+		// vram_ のタイルデータをデコードしたもの
+		TileCache tileCache_;
+
 		// WRAM
 		std::array<std::array<uint8, 0x1000>, 8> wram_{};
 		int wramBank_ = 1;
 
+		// ページテーブル
+		// アドレスの上位8ビットごとに、直接読み書きできるメモリ（256バイト）へのポインタを保持する
+		// nullptr のページは、アドレスの範囲による分岐で I/O などの処理を行う
+		std::array<const uint8*, 256> readPages_{};
+		std::array<uint8*, 256> writePages_{};
+
 		// OAM DMA
 		DMA dma_{ this };
 
@@ -136,5 +164,14 @@ namespace dmge
 
 		// [DEBUG]
 		uint64 cyclesTotal_ = 0;
+
+		// ページテーブルを更新する
+		// バンクの切り替えなど、マッピングが変化したときに呼ぶ
+		void updatePages_();
+		void updateCartridgePages_();
+		void updateROMPages_(uint16 pageBegin, uint16 pageEnd);
+		void updateSRAMPages_();
+		void updateVRAMPages_();
+		void updateWRAMPages_();
 	};
 }
@@ -4,10 +4,12 @@
 #include "LCD.h"
 #include "Memory.h"
 #include "Interrupt.h"
+#include "Scheduler.h"
 #include "TileData.h"
 #include "BitMask/InterruptFlag.h"
 #include "OAM.h"
 #include "TileMapAttribute.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -20,18 +22,26 @@ namespace dmge
 		}
 	}
 
-	PPU::PPU(Memory* mem, LCD* lcd, Interrupt* interrupt)
+	PPU::PPU(Memory* mem, LCD* lcd, Interrupt* interrupt, Scheduler* scheduler, bool headless)
 		:
 		mem_{ mem },
 		lcd_{ lcd },
 		interrupt_{ interrupt },
-		canvas_{ LCDSize.x + 8, LCDSize.y },
-		texture_{ canvas_.size() }
+		scheduler_{ scheduler },
+		headless_{ headless },
+		canvas_{ LCDSize.x + 8, LCDSize.y }
 	{
 		dot_ = FrameDots - 52 + 4;
 		canvas_.fill(Palette::White);
 		oamBuffer_.reserve(10);
 
+		if (headless_) return;
+
+		texture_ = DynamicTexture{ canvas_.size() };
+
+		// 最初の記録ではすべての行を転送するよう、レンダリング結果にない色（透明）で埋めておく
+		uploaded_ = Image{ canvas_.size(), Color{ 0, 0 } };
+
 #if SIV3D_PLATFORM(WINDOWS)
 		pixelShader_ = HLSL{ PPURenderingShader() };
 #endif
@@ -83,7 +93,10 @@ namespace dmge
 
 		// 行の描画
 
-		if (mode_ == PPUMode::Drawing)
+		// 高速描画モードでは HBlank への移行時に1行分まとめて描画する
+		// ただし行の途中で描画に影響する書き込みがあった場合は、その行の残りをドット単位で描画する
+
+		if (mode_ == PPUMode::Drawing && (not fastRendering_ || lineFallback_) && not skipRendering_)
 		{
 			if (canvasX_ < LCDSize.x)
 			{
@@ -95,14 +108,23 @@ namespace dmge
 
 		if (modeChangedToHBlank())
 		{
-			// 右端の残りのドットを描画
-			while (canvasX_ < LCDSize.x)
+			if (not skipRendering_)
 			{
-				renderDot_();
+				if (fastRendering_ && not lineFallback_ && canvasX_ == 0)
+				{
+					renderLine_();
+				}
+
+				// 右端の残りのドットを描画
+				while (canvasX_ < LCDSize.x)
+				{
+					renderDot_();
+				}
 			}
 
 			fetcherX_ = 0;
 			canvasX_ = 0;
+			lineFallback_ = false;
 
 			if (drawingWindow_)
 			{
@@ -118,7 +140,12 @@ namespace dmge
 
 		if (modeChangedToVBlank())
 		{
-			flushRenderingResult();
+			if (autoFlush_ && not skipRendering_)
+			{
+				flushRenderingResult();
+			}
+
+			++frameCount_;
 
 			toDrawWindow_ = false;
 			drawingWindow_ = false;
@@ -135,17 +162,154 @@ namespace dmge
 		}
 	}
 
+	void PPU::sync()
+	{
+		const int factor = doubleSpeedFactor_();
+		uint64 dots = (scheduler_->now() - lastSync_) / factor;
+		lastSync_ += dots * factor;
+
+		// LCD がオフの間は、最初の1ドットを進めた後は状態が変化しないので読み飛ばす
+		if (dots > 0 && not lcd_->isEnabled())
+		{
+			run();
+			dots = 0;
+		}
+
+		for (; dots > 0; --dots)
+		{
+			run();
+		}
+
+		scheduleNextEvent_();
+	}
+
+	void PPU::syncForWrite()
+	{
+		sync();
+
+		// 書き込み後に描画するドットでは、スプライトのドットを書き込み後のタイルデータから求め直す
+		lineOAMStale_ = true;
+
+		if (not fastRendering_ || lineFallback_ || mode_ != PPUMode::Drawing || skipRendering_)
+		{
+			return;
+		}
+
+		// ドット単位で描画した場合にここまでに描画されているはずのドットを、書き込み前の状態で描画しておく
+		const int renderedDots = Min(dot_ % LineDots - Mode2Dots + 1, LCDSize.x);
+
+		while (canvasX_ < renderedDots)
+		{
+			renderDot_();
+		}
+
+		lineFallback_ = true;
+	}
+
+	void PPU::scheduleNextDot()
+	{
+		scheduler_->schedule(SchedulerEvent::PPU, lastSync_ + doubleSpeedFactor_());
+	}
+
+	void PPU::setFastRendering(bool enable)
+	{
+		fastRendering_ = enable;
+	}
+
+	bool PPU::fastRendering() const
+	{
+		return fastRendering_;
+	}
+
+	void PPU::setSkipRendering(bool skip)
+	{
+		skipRendering_ = skip;
+	}
+
+	void PPU::setAutoFlush(bool enable)
+	{
+		autoFlush_ = enable;
+	}
+
+	uint64 PPU::frameCount() const
+	{
+		return frameCount_;
+	}
+
 	void PPU::flushRenderingResult()
 	{
+		if (headless_) return;
+
 		if (mask_ != SGB::MaskMode::Freeze)
 		{
-			texture_.fill(canvas_);
+			uploadRenderingResult_(canvas_);
+		}
+	}
+
+	bool PPU::copyRenderingResult(Image& image) const
+	{
+		if (mask_ == SGB::MaskMode::Freeze) return false;
+
+		image = canvas_;
+		return true;
+	}
+
+	void PPU::flushRenderingResult(const Image& image)
+	{
+		if (headless_) return;
+
+		uploadRenderingResult_(image);
+	}
+
+	int PPU::changedPixelCount() const
+	{
+		return changedPixelCount_;
+	}
+
+	void PPU::uploadRenderingResult_(const Image& image)
+	{
+		// 前回記録したものと行ごとに比較し、変化した行が連続する範囲ごとにテクスチャに転送する
+		// メニューや会話中など画面がほとんど変化しない場面では、転送をまるごと省略できる
+
+		constexpr size_t RowBytes = sizeof(Color) * LCDSize.x;
+
+		changedPixelCount_ = 0;
+
+		int dirtyBegin = -1;
+
+		for (int y = 0; y <= LCDSize.y; ++y)
+		{
+			const bool dirty = (y < LCDSize.y) && std::memcmp(image[y], uploaded_[y], RowBytes) != 0;
+
+			if (dirty)
+			{
+				for (int x : step(LCDSize.x))
+				{
+					if (image[y][x] != uploaded_[y][x]) ++changedPixelCount_;
+				}
+
+				std::memcpy(uploaded_[y], image[y], RowBytes);
+
+				if (dirtyBegin < 0) dirtyBegin = y;
+			}
+			else if (dirtyBegin >= 0)
+			{
+				texture_.fillRegion(uploaded_, Rect{ 0, dirtyBegin, LCDSize.x, y - dirtyBegin });
+				dirtyBegin = -1;
+			}
 		}
 	}
 
 	void PPU::draw(const Vec2& pos, int scale)
 	{
-		if (not lcd_->isEnabled()) return;
+		if (headless_ || not lcd_->isEnabled()) return;
+
+		drawRenderingResult(pos, scale);
+	}
+
+	void PPU::drawRenderingResult(const Vec2& pos, int scale)
+	{
+		if (headless_) return;
 
 		const ScopedRenderStates2D renderState{ SamplerState::ClampNearest };
 
@@ -160,6 +324,11 @@ namespace dmge
 		texture_(0, 0, 160, 144).draw();
 	}
 
+	const Image& PPU::canvas() const
+	{
+		return canvas_;
+	}
+
 	PPUMode PPU::mode() const
 	{
 		return mode_;
@@ -212,7 +381,7 @@ namespace dmge
 
 	void PPU::setPaletteColors(const std::array<ColorF, 4>& palette)
 	{
-		std::copy(palette.cbegin(), palette.cend(), paletteColors_.begin());
+		lcd_->setDMGPaletteColors(palette);
 	}
 
 	void PPU::transferAttributeFiles()
@@ -240,6 +409,44 @@ namespace dmge
 		Console.writeln();
 	}
 
+	int PPU::doubleSpeedFactor_() const
+	{
+		return mem_->isDoubleSpeed() ? 2 : 1;
+	}
+
+	void PPU::scheduleNextEvent_()
+	{
+		if (not lcd_->isEnabled())
+		{
+			scheduler_->cancel(SchedulerEvent::PPU);
+			return;
+		}
+
+		scheduler_->schedule(SchedulerEvent::PPU, lastSync_ + static_cast<uint64>(dotsToNextEvent_()) * doubleSpeedFactor_());
+	}
+
+	int PPU::dotsToNextEvent_() const
+	{
+		// 割り込み要求や LY・STAT の変化が起こりうるのは、行内の以下の位置のみ
+		// - 0   : OAMScan・VBlank への移行、LY の変化（1行目）
+		// - 4   : LY の変化 ("scanline 153 quirk")
+		// - 80  : Drawing への移行（割り込み要求はないが、STAT のモードが変化する）
+		// - 80 + mode3Length : HBlank への移行
+		// - 452 : LY の変化
+		// （LY・STAT の値はイベントの時刻にのみ変化するものとして、CPU のアイドルループの省略に使われる）
+		const int x = dot_ % LineDots;
+
+		for (const int eventX : { 4, Mode2Dots, Mode2Dots + mode3Length(), 452 })
+		{
+			if (x < eventX)
+			{
+				return eventX - x;
+			}
+		}
+
+		return LineDots - x;
+	}
+
 	void PPU::updateLY_()
 	{
 		if (not lcd_->isEnabled())
@@ -369,11 +576,23 @@ namespace dmge
 			oamBuffer_.push_back(oam);
 		}
 
+		// 優先度の高い順に並べる
 		// DMGの場合、X座標が小さいOBJが優先される。X座標が等しい場合は、先に定義されているものが優先される
+		// CGBの場合、OPRI=0 なら先に定義されているものが優先される（走査した順のまま）
 
-		if (not cgbMode_)
+		if (not cgbMode_ || (lcd_->opri() & 1))
+		{
+			oamBuffer_.sort_by([](const auto& a, const auto& b) { return (a.x == b.x) ? a.address < b.address : a.x < b.x; });
+		}
+
+		// この行のスプライトのドットを求めておく
+		if (skipRendering_)
+		{
+			lineOAMStale_ = true;
+		}
+		else
 		{
-			oamBuffer_.sort_by([](const auto& a, const auto& b) { return (a.x == b.x) ? a.address > b.address : a.x > b.x; });
+			rasterizeLineOAM_();
 		}
 	}
 
@@ -431,130 +650,229 @@ namespace dmge
 		const uint8 tileId = mem_->readVRAMBank(tileAddr, 0);
 		const uint16 tileDataAddr = TileData::GetAddress(lcd_->tileDataAddress(), tileId, drawingWindow_ ? (windowLine_ % 8) : ((ly + scy) % 8), tileMapAttr.attr.yFlip);
 
-		// タイルデータを参照
-		const uint16 tileData = mem_->read16VRAMBank(tileDataAddr, tileMapAttr.attr.bank);
-		const uint8 color = TileData::GetColor(tileData, fetcherX % 8, tileMapAttr.attr.xFlip);
+		// タイルデータを参照（デコード済みのものを使う）
+		const uint8 color = mem_->tileCache().row(tileDataAddr, tileMapAttr.attr.bank, tileMapAttr.attr.xFlip)[fetcherX % 8];
 
 		// 実際の描画色
 		Color& dotColor = canvas_[ly][canvasX_];
+		dotColor = bgDotColor_(color, tileMapAttr, canvasX_, ly);
 
-		if (not cgbMode_)
+		// スプライトとマージ
+		if (lcd_->isEnabledSprite())
 		{
-			// LCDC.0 == 0 の場合はBGを描画しない
-			const uint8 bgPaletteColor = lcd_->isEnabledBgAndWindow() ? FromEnum(lcd_->bgp(color)) : 0u;
+			if (lineOAMStale_)
+			{
+				rasterizeLineOAM_();
+			}
 
-			if (not sgbMode_)
+			dotColor = mergeOAMDot_(dotColor, color, tileMapAttr, canvasX_);
+		}
+
+		fetcherX_++;
+		canvasX_++;
+	}
+
+	void PPU::renderLine_()
+	{
+		const uint8 ly = lcd_->ly();
+		const uint8 scy = lcd_->scy();
+		const uint8 scx = lcd_->scx();
+
+		if (ly == lcd_->wy())
+		{
+			toDrawWindow_ = true;
+		}
+
+		// ウィンドウのフェッチを開始するX座標
+		// renderDot_() と同様に、ピクセルフェッチャーのX座標が WX - 7 に達したところから開始する
+		int windowX = LCDSize.x;
+
+		if (toDrawWindow_ && lcd_->isEnabledWindow())
+		{
+			windowX = Clamp(lcd_->wx() - 7, 0, LCDSize.x);
+		}
+
+		// 各ドットの BG の色番号と背景マップ属性
+		std::array<uint8, LCDSize.x> bgColors;
+		std::array<uint8, LCDSize.x> bgAttrs;
+
+		// タイルを1回フェッチするごとに、同じタイルに含まれるドット（最大8ドット）をまとめてデコードする
+		for (int x = 0; x < LCDSize.x;)
+		{
+			const bool window = (x >= windowX);
+
+			uint8 fetcherX;
+			uint16 tileAddr;
+			uint8 row;
+
+			if (window)
 			{
-				dotColor = paletteColors_[bgPaletteColor];
+				fetcherX = static_cast<uint8>(x - windowX);
+
+				const uint16 tileMapAddrBase = lcd_->windowTileMapAddress();
+				const uint16 addrOffsetX = fetcherX / 8;
+				const uint16 addrOffsetY = 32 * (windowLine_ / 8);
+				tileAddr = tileMapAddrBase + ((addrOffsetX + addrOffsetY) & 0x3ff);
+				row = windowLine_ % 8;
 			}
 			else
 			{
-				// (SGB) カラー0は透明なので、最新の背景色を表示する?
-				const uint8 palette = bgPaletteColor == 0 ? 0 : getAttribute(canvasX_ / 8, ly / 8);
-				dotColor = lcd_->sgbPaletteColor(palette, bgPaletteColor);
+				fetcherX = static_cast<uint8>(x + scx % 8);
 
-				if (mask_ == SGB::MaskMode::Black)
-				{
-					dotColor = Palette::Black;
-				}
-				else if (mask_ == SGB::MaskMode::Color0)
-				{
-					dotColor = lcd_->sgbPaletteColor(0, 0);
-				}
+				const uint16 tileMapAddrBase = lcd_->bgTileMapAddress();
+				const uint16 addrOffsetX = ((fetcherX / 8) + (scx / 8)) & 0x1f;
+				const uint16 addrOffsetY = 32 * (((ly + scy) & 0xff) / 8);
+				tileAddr = tileMapAddrBase + ((addrOffsetX + addrOffsetY) & 0x3ff);
+				row = (ly + scy) % 8;
+			}
+
+			const TileMapAttribute tileMapAttr{ cgbMode_ ? mem_->readVRAMBank(tileAddr, 1) : uint8(0) };
+			const uint8 tileId = mem_->readVRAMBank(tileAddr, 0);
+			const uint16 tileDataAddr = TileData::GetAddress(lcd_->tileDataAddress(), tileId, row, tileMapAttr.attr.yFlip);
+			const auto& tileRow = mem_->tileCache().row(tileDataAddr, tileMapAttr.attr.bank, tileMapAttr.attr.xFlip);
+
+			// タイルの右端、またはウィンドウの開始位置まで
+			const int end = Min(x + 8 - fetcherX % 8, window ? LCDSize.x : windowX);
+
+			for (int dotNth = fetcherX % 8; x < end; ++x, ++dotNth)
+			{
+				bgColors[x] = tileRow[dotNth];
+				bgAttrs[x] = tileMapAttr.value;
 			}
 		}
-		else
+
+		if (windowX < LCDSize.x)
 		{
-			dotColor = lcd_->bgPaletteColor(tileMapAttr.attr.palette, color);
+			drawingWindow_ = true;
 		}
 
-		// スプライトをフェッチ
-		if (lcd_->isEnabledSprite())
+		// スプライトのドットは OAMScan の終わりに求めてある
+		const bool enabledSprite = lcd_->isEnabledSprite() && not oamBuffer_.empty();
+
+		if (enabledSprite && lineOAMStale_)
 		{
-			dotColor = fetchOAMDot_(dotColor, color, tileMapAttr);
+			rasterizeLineOAM_();
 		}
 
-		fetcherX_++;
-		canvasX_++;
+		for (int x : step(LCDSize.x))
+		{
+			Color& dotColor = canvas_[ly][x];
+			dotColor = bgDotColor_(bgColors[x], TileMapAttribute{ bgAttrs[x] }, x, ly);
+
+			if (enabledSprite)
+			{
+				dotColor = mergeOAMDot_(dotColor, bgColors[x], TileMapAttribute{ bgAttrs[x] }, x);
+			}
+		}
+
+		canvasX_ = LCDSize.x;
 	}
 
-	ColorF PPU::fetchOAMDot_(const ColorF& initialDotColor, uint8 bgColor, const TileMapAttribute& bgTileMapAttr) const
+	void PPU::rasterizeLineOAM_()
 	{
-		const bool opri = lcd_->opri() & 1;
-		int oamPriorityVal = 999;
-		int oamIndex = 0;
+		const uint8 ly = lcd_->ly();
 
-		// 描画結果
-		ColorF fetched = initialDotColor;
+		lineOAMDots_.fill(LineOAMDot{});
+		lineOAMStale_ = false;
 
+		// oamBuffer_ は優先度の高い順に並んでいるので、各ドットには最初に見つかった不透明なドットを採用する
+		// BGとの優先度はマージ時に解決する
 		for (const auto& oam : oamBuffer_)
 		{
-			// 描画中のドットがスプライトに重なっているか？
-			if (not (oam.x <= canvasX_ + 8 && oam.x + 8 > canvasX_ + 8)) continue;
+			// タイルデータは1スプライトにつき1回だけ参照する
+			const uint16 tileDataAddr = TileData::GetAddress(0x8000, oam.tile, (ly + 16 - oam.y) % 8, oam.yFlip);
+			const auto& tileRow = mem_->tileCache().row(tileDataAddr, oam.bank, oam.xFlip);
+
+			for (int oamX : step(8))
+			{
+				const int x = oam.x - 8 + oamX;
+
+				if (x < 0 || x >= LCDSize.x) continue;
 
-			// 0xff6c(OPRI)を反映
-			if (cgbMode_ && oamPriorityVal != 999 && ((opri && oamPriorityVal < oam.x) || (not opri && oamPriorityVal < oamIndex))) continue;
+				auto& dot = lineOAMDots_[x];
 
-			// タイルデータのアドレスを得る
-			const uint16 tileDataAddr = TileData::GetAddress(0x8000, oam.tile, (lcd_->ly() + 16 - oam.y) % 8, oam.yFlip);
+				// 優先度の高いスプライトのドットが既にあるか、透明（色番号0）
+				if (dot.color != 0 || tileRow[oamX] == 0) continue;
 
-			// タイルデータを参照
-			const uint16 tileData = mem_->read16VRAMBank(tileDataAddr, oam.bank);
+				dot.color = tileRow[oamX];
+				dot.palette = cgbMode_ ? oam.obp : oam.palette;
+				dot.priority = oam.priority;
+			}
+		}
+	}
 
-			// スプライトの、左から oamX 個目のドットを描画する
-			const int oamX = canvasX_ + 8 - oam.x;
-			const uint8 oamColor = TileData::GetColor(tileData, oamX % 8, oam.xFlip);
+	Color PPU::bgDotColor_(uint8 color, const TileMapAttribute& tileMapAttr, int x, uint8 ly) const
+	{
+		if (cgbMode_)
+		{
+			return lcd_->bgPaletteColor(tileMapAttr.attr.palette, color);
+		}
+
+		if (not sgbMode_)
+		{
+			// LCDC.0 == 0 の場合はBGを描画しない
+			return lcd_->isEnabledBgAndWindow() ? lcd_->bgpColor(color) : lcd_->dmgPaletteColor(Colors::Gray::White);
+		}
+
+		// LCDC.0 == 0 の場合はBGを描画しない
+		const uint8 bgPaletteColor = lcd_->isEnabledBgAndWindow() ? FromEnum(lcd_->bgp(color)) : 0u;
+
+		if (mask_ == SGB::MaskMode::Black)
+		{
+			return Palette::Black;
+		}
+		else if (mask_ == SGB::MaskMode::Color0)
+		{
+			return lcd_->sgbPaletteColor(0, 0);
+		}
 
-			// BGとのマージ
-			if (not cgbMode_)
+		// (SGB) カラー0は透明なので、最新の背景色を表示する?
+		const uint8 palette = bgPaletteColor == 0 ? 0 : getAttribute(x / 8, ly / 8);
+		return lcd_->sgbPaletteColor(palette, bgPaletteColor);
+	}
+
+	Color PPU::mergeOAMDot_(Color initialDotColor, uint8 bgColor, const TileMapAttribute& bgTileMapAttr, int x) const
+	{
+		const auto& dot = lineOAMDots_[x];
+
+		// 描画中のドットがスプライトに重なっているか？
+		if (dot.color == 0) return initialDotColor;
+
+		// BGとのマージ
+		if (not cgbMode_)
+		{
+			if (dot.priority == 1 && bgColor != 0) return initialDotColor;
+
+			if (mask_ == SGB::MaskMode::Black)
 			{
-				if (oamColor != 0 && not (oam.priority == 1 && bgColor != 0))
-				{
-					const uint8 oamPaletteColor = FromEnum(lcd_->obp(oam.palette, oamColor));
-
-					if (not sgbMode_)
-					{
-						fetched = paletteColors_[oamPaletteColor];
-					}
-					else
-					{
-						// (SGB) カラー0は透明なので、最新の背景色を表示する?
-						const uint8 palette = oamPaletteColor == 0 ? 0 : getAttribute(canvasX_ / 8, lcd_->ly() / 8);
-						fetched = lcd_->sgbPaletteColor(palette, oamPaletteColor);
-					}
-
-					if (mask_ == SGB::MaskMode::Black)
-					{
-						fetched = Palette::Black;
-					}
-					else if (mask_ == SGB::MaskMode::Color0)
-					{
-						fetched = lcd_->sgbPaletteColor(0, 0);
-					}
-				}
+				return Palette::Black;
 			}
-			else
+			else if (mask_ == SGB::MaskMode::Color0)
 			{
-				// - https://gbdev.io/pandocs/LCDC.html#lcdc0--bg-and-window-enablepriority
-				// - https://gbdev.io/pandocs/Tile_Maps.html#bg-to-obj-priority-in-cgb-mode
-
-				const bool drawObj =
-					((oamColor != 0) &&
-						((not lcd_->isEnabledBgAndWindow()) ||
-							(oam.priority == 0 && bgTileMapAttr.attr.priority == 0) ||
-							(bgColor == 0)));
+				return lcd_->sgbPaletteColor(0, 0);
+			}
 
-				if (drawObj)
-				{
-					fetched = lcd_->objPaletteColor(oam.obp, oamColor);
-					oamPriorityVal = opri ? oam.x : oamIndex;
-				}
+			if (not sgbMode_)
+			{
+				return lcd_->obpColor(dot.palette, dot.color);
 			}
 
-			oamIndex++;
+			const uint8 oamPaletteColor = FromEnum(lcd_->obp(dot.palette, dot.color));
+
+			// (SGB) カラー0は透明なので、最新の背景色を表示する?
+			const uint8 palette = oamPaletteColor == 0 ? 0 : getAttribute(x / 8, lcd_->ly() / 8);
+			return lcd_->sgbPaletteColor(palette, oamPaletteColor);
 		}
 
-		return fetched;
+		// - https://gbdev.io/pandocs/LCDC.html#lcdc0--bg-and-window-enablepriority
+		// - https://gbdev.io/pandocs/Tile_Maps.html#bg-to-obj-priority-in-cgb-mode
+
+		const bool drawObj =
+			(not lcd_->isEnabledBgAndWindow()) ||
+			(dot.priority == 0 && bgTileMapAttr.attr.priority == 0) ||
+			(bgColor == 0);
+
+		return drawObj ? lcd_->objPaletteColor(dot.palette, dot.color) : initialDotColor;
 	}
 
 	void PPU::setAttribute(int x, int y, uint8 palette)
@@ -578,4 +896,71 @@ namespace dmge
 	{
 		mask_ = mask;
 	}
+
+	void PPU::saveState(StateWriter& writer) const
+	{
+		writer.write(lastSync_);
+		writer.write(dot_);
+		writer.write(prevLY_);
+		writer.write(prevLYC_);
+		writer.write(mode_);
+		writer.write(prevRequireSTATInt_);
+		writer.write(fetcherX_);
+		writer.write(canvasX_);
+		writer.write(toDrawWindow_);
+		writer.write(drawingWindow_);
+		writer.write(windowLine_);
+
+		// OAMバッファは最大数分の領域を書き込み、状態のサイズを一定にする（巻き戻しの差分用）
+		std::array<OAM, 10> oamBuffer{};
+		std::copy(oamBuffer_.begin(), oamBuffer_.end(), oamBuffer.begin());
+		writer.write(static_cast<uint8>(oamBuffer_.size()));
+		writer.write(oamBuffer);
+
+		writer.write(lineFallback_);
+		writer.write(sgbMode_);
+		writer.write(sgbAttrFile_);
+		writer.write(sgbCurrentAttr_);
+		writer.write(mask_);
+		writer.write(cgbMode_);
+
+		// 描画途中の行があるため、レンダリング結果も含める
+		writer.writeBytes(canvas_.data(), canvas_.size_bytes());
+	}
+
+	void PPU::loadState(StateReader& reader)
+	{
+		reader.read(lastSync_);
+		reader.read(dot_);
+		reader.read(prevLY_);
+		reader.read(prevLYC_);
+		reader.read(mode_);
+		reader.read(prevRequireSTATInt_);
+		reader.read(fetcherX_);
+		reader.read(canvasX_);
+		reader.read(toDrawWindow_);
+		reader.read(drawingWindow_);
+		reader.read(windowLine_);
+
+		uint8 oamCount = 0;
+		std::array<OAM, 10> oamBuffer{};
+		reader.read(oamCount);
+		reader.read(oamBuffer);
+		oamBuffer_.assign(oamBuffer.begin(), oamBuffer.begin() + Min<uint8>(oamCount, 10));
+
+		reader.read(lineFallback_);
+
+		// スプライトのドットは状態に含めず、次の描画時に求め直す
+		lineOAMStale_ = true;
+		reader.read(sgbMode_);
+		reader.read(sgbAttrFile_);
+		reader.read(sgbCurrentAttr_);
+		reader.read(mask_);
+
+		bool cgbMode = false;
+		reader.read(cgbMode);
+		setCGBMode(cgbMode);
+
+		reader.readBytes(canvas_.data(), canvas_.size_bytes());
+	}
 }
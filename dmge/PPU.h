@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "PPUMode.h"
+#include "PPUConstants.h"
 #include "Colors.h"
 #include "SGB/Mask.h"
 
@@ -9,8 +10,11 @@ namespace dmge
 	class Memory;
 	class Interrupt;
 	class LCD;
+	class Scheduler;
 	struct OAM;
 	union TileMapAttribute;
+	class StateWriter;
+	class StateReader;
 
 	// ピクセルシェーダに渡すパラメータ
 	struct RenderingSetting
@@ -21,7 +25,8 @@ namespace dmge
 	class PPU
 	{
 	public:
-		PPU(Memory* mem, LCD* lcd, Interrupt* interrupt);
+		// headless == true の場合、テクスチャ・シェーダを作成せず、レンダリング結果を画面に出力しない
+		PPU(Memory* mem, LCD* lcd, Interrupt* interrupt, Scheduler* scheduler, bool headless = false);
 
 		~PPU();
 
@@ -36,12 +41,59 @@ namespace dmge
 		// 状態更新の結果により割り込み要求を行う
 		void run();
 
+		// 前回の同期時刻から現在時刻までのドットを進め、次のイベントをスケジューラに登録する
+		// LCDレジスタ・VRAM・OAM へのアクセス前に呼ぶ
+		void sync();
+
+		// sync() を行い、高速描画モードで描画中の行があれば、ここまでのドットを現在の状態で描画しておく
+		// 描画に影響する LCDレジスタ・VRAM への書き込み前に呼ぶ
+		void syncForWrite();
+
+		// LCDレジスタへの書き込みにより STAT 割り込みの条件が変化しうるので、次のドットで同期するようにする
+		void scheduleNextDot();
+
+		// 高速描画モード
+		// 有効な場合、行の途中で描画に影響する書き込みがない限り HBlank への移行時に1行分まとめて描画する
+		void setFastRendering(bool enable);
+
+		bool fastRendering() const;
+
+		// 描画を省略する
+		// ラン・アヘッドで画面に出力しないフレームを進める場合などに使う
+		// 省略している間もLY・PPUモード・STATと割り込み要求は通常どおり更新する
+		void setSkipRendering(bool skip);
+
+		// VBlank への移行時にレンダリング結果を RenderTexture に記録する（デフォルトで有効）
+		// 無効の場合は flushRenderingResult() を明示的に呼ぶ
+		void setAutoFlush(bool enable);
+
+		// VBlank に移行した回数
+		uint64 frameCount() const;
+
 		// レンダリング結果をRenderTextureに記録
 		void flushRenderingResult();
 
+		// レンダリング結果を image にコピーする（SGB のマスクで画面を固定している場合はコピーせず false を返す）
+		// エミュレーションを別スレッドで実行する場合は、これでコピーしたものを flushRenderingResult(image) で記録する
+		bool copyRenderingResult(Image& image) const;
+
+		// 他のスレッドでコピーしたレンダリング結果をRenderTextureに記録
+		void flushRenderingResult(const Image& image);
+
+		// 前回 flushRenderingResult() で記録したときに変化していたドット数（プロファイル用）
+		// 変化した行だけをテクスチャに転送している
+		int changedPixelCount() const;
+
 		// PPUによるレンダリング結果をシーンに描画する
 		void draw(const Vec2& pos, int scale);
 
+		// draw() と同じだが、LCD の状態を参照しない
+		void drawRenderingResult(const Vec2& pos, int scale);
+
+		// レンダリング結果
+		// 幅は LCDSize.x より大きいので、画面部分は (0, 0, LCDSize) の範囲
+		const Image& canvas() const;
+
 		// PPUのモード
 		// LYと、このフレームの描画ドット数により変化する
 		PPUMode mode() const;
@@ -64,7 +116,7 @@ namespace dmge
 		int mode3Length() const;
 
 		// (DMG) パレットの4色を設定する
-		// （「色番号から実際の色への変換テーブル」を置き換える）
+		// （LCD の「色の濃さから実際の色への変換テーブル」を置き換える）
 		void setPaletteColors(const std::array<ColorF, 4>& palette);
 
 		// (SGB) ATTR_TRN
@@ -87,10 +139,22 @@ namespace dmge
 		// [DEBUG]
 		void dumpAttributeFile(int index);
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory* mem_;
 		LCD* lcd_;
 		Interrupt* interrupt_;
+		Scheduler* scheduler_;
+
+		// テクスチャ・シェーダを使用しない
+		bool headless_;
+
+		// 前回 sync() した時刻
+		uint64 lastSync_ = 0;
 
 		// このフレームの描画ドット数
 		int dot_ = 0;
@@ -111,6 +175,12 @@ namespace dmge
 		Image canvas_;
 		DynamicTexture texture_;
 
+		// テクスチャに記録済みのレンダリング結果（変化した行の検出用）
+		Image uploaded_;
+
+		// 前回テクスチャに記録したときに変化していたドット数
+		int changedPixelCount_ = 0;
+
 		PixelShader pixelShader_;
 		ConstantBuffer<RenderingSetting> cbRenderingSetting_{};
 
@@ -137,15 +207,46 @@ namespace dmge
 		// スキャンラインのはじめのあたり（OAMScanモード時）に構築される
 		Array<OAM> oamBuffer_;
 
+		// 高速描画モード
+		bool fastRendering_ = false;
+
+		// 描画を省略する
+		bool skipRendering_ = false;
+
+		// VBlank への移行時にレンダリング結果を RenderTexture に記録する
+		bool autoFlush_ = true;
+
+		// VBlank に移行した回数
+		uint64 frameCount_ = 0;
+
+		// (高速描画モード) 描画中の行で書き込みがあったため、行の残りをドット単位で描画する
+		bool lineFallback_ = false;
+
+		// 行内の各ドットに表示されるスプライトのドット
+		// スプライト同士の優先度は解決済みなので、BGとのマージ時は1回参照するだけでよい
+		struct LineOAMDot
+		{
+			// 色番号（0 の場合はスプライトのドットがない）
+			uint8 color = 0;
+
+			// (DMG) OBP0/OBP1, (CGB) パレット番号
+			uint8 palette = 0;
+
+			// BG and Window over OBJ
+			uint8 priority = 0;
+		};
+
+		std::array<LineOAMDot, LCDSize.x> lineOAMDots_{};
+
+		// 書き込みによりタイルデータが変化しうるため、次の描画時に lineOAMDots_ を求め直す
+		bool lineOAMStale_ = true;
+
 		// CGB Mode
 		bool cgbMode_ = false;
 
 		// SGB Mode
 		bool sgbMode_ = false;
 
-		// (DMG) 色番号から実際の色への変換テーブル
-		std::array<ColorF, 4> paletteColors_{};
-
 		// (SGB) Attribute Files
 		std::array<uint8, 4050> sgbAttrFile_{};
 
@@ -155,13 +256,19 @@ namespace dmge
 		// (SGB) マスク(MASK_EN)の状態
 		SGB::MaskMode mask_ = SGB::MaskMode::None;
 
-
+		int doubleSpeedFactor_() const;
+		void scheduleNextEvent_();
+		int dotsToNextEvent_() const;
 		void updateLY_();
 		void updateMode_();
 		void updateSTAT_();
 		void scanOAM_();
 		void renderDot_();
-		ColorF fetchOAMDot_(const ColorF& initialDotColor, uint8 bgColor, const TileMapAttribute& bgTileMapAttr) const;
+		void renderLine_();
+		void rasterizeLineOAM_();
+		void uploadRenderingResult_(const Image& image);
+		Color bgDotColor_(uint8 color, const TileMapAttribute& tileMapAttr, int x, uint8 ly) const;
+		Color mergeOAMDot_(Color initialDotColor, uint8 bgColor, const TileMapAttribute& bgTileMapAttr, int x) const;
 
 	};
 }
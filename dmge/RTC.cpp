@@ -1,6 +1,7 @@
 ﻿#include "stdafx.h"
 #include "RTC.h"
 #include "Timing.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -190,4 +191,30 @@ namespace dmge
 		regInternal_.d = 0;
 		carry_ = true;
 	}
+
+	void RTC::saveState(StateWriter& writer) const
+	{
+		writer.write(enabled_);
+		writer.write(selected_);
+		writer.write(preparedLatch_);
+		writer.write(regInternal_);
+		writer.write(regLatched_);
+		writer.write(halt_);
+		writer.write(carry_);
+		writer.write(timeRTCEnabled_);
+		writer.write(cycles_);
+	}
+
+	void RTC::loadState(StateReader& reader)
+	{
+		reader.read(enabled_);
+		reader.read(selected_);
+		reader.read(preparedLatch_);
+		reader.read(regInternal_);
+		reader.read(regLatched_);
+		reader.read(halt_);
+		reader.read(carry_);
+		reader.read(timeRTCEnabled_);
+		reader.read(cycles_);
+	}
 }
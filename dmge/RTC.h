@@ -2,6 +2,9 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	enum class RTCRegisters : uint8
 	{
 		S = 0x8,
@@ -68,6 +71,11 @@ namespace dmge
 		// [DEBUG]
 		void dump();
 
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		bool enabled_ = false;
 
@@ -0,0 +1,271 @@
+﻿#include "stdafx.h"
+#include "RewindBuffer.h"
+#include "Core.h"
+
+namespace dmge
+{
+	namespace
+	{
+		// 差分の形式:
+		// （キーフレームと一致するバイト数 uint32, 一致しないバイト数 uint32, 一致しないバイトのキーフレームとの XOR）の繰り返し
+
+		// 一致しない範囲を打ち切る、一致するバイトの連続の長さ
+		constexpr size_t MinMatchLength = 8;
+
+		bool Equal8(const uint8* a, const uint8* b)
+		{
+			uint64 x, y;
+			std::memcpy(&x, a, 8);
+			std::memcpy(&y, b, 8);
+			return x == y;
+		}
+
+		// pos から、key と state が一致する範囲の終端
+		size_t SkipMatch(const uint8* key, const uint8* state, size_t pos, size_t size)
+		{
+			while (pos + 8 <= size && Equal8(key + pos, state + pos))
+			{
+				pos += 8;
+			}
+
+			while (pos < size && key[pos] == state[pos])
+			{
+				++pos;
+			}
+
+			return pos;
+		}
+
+		// pos から、key と state が MinMatchLength バイト以上続けて一致する位置まで
+		size_t SkipMismatch(const uint8* key, const uint8* state, size_t pos, size_t size)
+		{
+			while (pos < size)
+			{
+				if (key[pos] == state[pos] && (pos + MinMatchLength > size || Equal8(key + pos, state + pos)))
+				{
+					break;
+				}
+
+				++pos;
+			}
+
+			return pos;
+		}
+
+		template <class T>
+		void AppendValue(Array<uint8>& out, T value)
+		{
+			const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+			out.insert(out.end(), bytes, bytes + sizeof(T));
+		}
+
+		// key に対する state の差分を out に追加する
+		// key と state は同じサイズであること
+		void AppendDelta(const Array<uint8>& key, const Array<uint8>& state, Array<uint8>& out)
+		{
+			const size_t size = state.size();
+			size_t pos = 0;
+
+			while (pos < size)
+			{
+				const size_t matchBegin = pos;
+				pos = SkipMatch(key.data(), state.data(), pos, size);
+
+				const size_t mismatchBegin = pos;
+				pos = SkipMismatch(key.data(), state.data(), pos, size);
+
+				AppendValue(out, static_cast<uint32>(mismatchBegin - matchBegin));
+				AppendValue(out, static_cast<uint32>(pos - mismatchBegin));
+
+				const size_t outPos = out.size();
+				out.resize(outPos + (pos - mismatchBegin));
+
+				for (size_t i = mismatchBegin; i < pos; ++i)
+				{
+					out[outPos + i - mismatchBegin] = key[i] ^ state[i];
+				}
+			}
+		}
+
+		// キーフレームの内容 (state) に差分を適用する
+		void ApplyDelta(const uint8* delta, size_t deltaSize, Array<uint8>& state)
+		{
+			size_t deltaPos = 0;
+			size_t pos = 0;
+
+			while (deltaPos < deltaSize)
+			{
+				uint32 matchLength, mismatchLength;
+				std::memcpy(&matchLength, delta + deltaPos, 4);
+				std::memcpy(&mismatchLength, delta + deltaPos + 4, 4);
+				deltaPos += 8;
+
+				pos += matchLength;
+
+				for (uint32 i = 0; i < mismatchLength; ++i)
+				{
+					state[pos + i] ^= delta[deltaPos + i];
+				}
+
+				pos += mismatchLength;
+				deltaPos += mismatchLength;
+			}
+		}
+	}
+
+	size_t RewindBuffer::Segment::bytes() const
+	{
+		// 追加で伸ばした配列は確保済みの領域が使用中のサイズより大きいので、確保済みの領域で数える
+		return keyframe.capacity() + deltas.capacity() + deltaOffsets.capacity() * sizeof(size_t);
+	}
+
+	void RewindBuffer::Segment::shrink()
+	{
+		deltas.shrink_to_fit();
+		deltaOffsets.shrink_to_fit();
+	}
+
+	RewindBuffer::RewindBuffer(size_t capacityBytes)
+		: capacityBytes_{ capacityBytes }
+	{
+	}
+
+	void RewindBuffer::setCapacity(size_t capacityBytes)
+	{
+		capacityBytes_ = capacityBytes;
+
+		if (capacityBytes_ == 0)
+		{
+			clear();
+		}
+		else
+		{
+			evict_();
+		}
+	}
+
+	void RewindBuffer::push(const Core& core)
+	{
+		if (capacityBytes_ == 0) return;
+
+		writer_.clear();
+		core.saveState(writer_);
+
+		const auto& state = writer_.data();
+
+		// 次の場合はキーフレームとして記録する
+		// - 前のキーフレームから KeyframeInterval フレーム経った
+		// - 差分が大きく、前のキーフレームからの記録が上限の 1/4 を超えた（破棄できる単位を小さくしておく）
+		// - 状態のサイズが変わって差分をとれない
+		if (segments_.empty() ||
+			segments_.back().deltaOffsets.size() + 1 >= KeyframeInterval ||
+			segments_.back().bytes() > capacityBytes_ / 4 ||
+			segments_.back().keyframe.size() != state.size())
+		{
+			// 記録を終えたセグメントの余分な領域を解放する
+			if (not segments_.empty())
+			{
+				auto& last = segments_.back();
+				const size_t prevBytes = last.bytes();
+
+				last.shrink();
+
+				usedBytes_ -= prevBytes - last.bytes();
+			}
+
+			Segment segment;
+			segment.keyframe = state;
+
+			usedBytes_ += segment.bytes();
+			segments_.push_back(std::move(segment));
+		}
+		else
+		{
+			auto& segment = segments_.back();
+			const size_t prevBytes = segment.bytes();
+
+			segment.deltaOffsets.push_back(segment.deltas.size());
+			AppendDelta(segment.keyframe, state, segment.deltas);
+
+			usedBytes_ += segment.bytes() - prevBytes;
+		}
+
+		evict_();
+	}
+
+	bool RewindBuffer::pop(Core& core)
+	{
+		if (segments_.empty()) return false;
+
+		auto& segment = segments_.back();
+		const size_t prevBytes = segment.bytes();
+
+		if (segment.deltaOffsets.empty())
+		{
+			StateReader reader{ segment.keyframe.data(), segment.keyframe.size() };
+			const bool loaded = core.loadState(reader);
+
+			usedBytes_ -= prevBytes;
+			segments_.pop_back();
+
+			return loaded;
+		}
+
+		const size_t offset = segment.deltaOffsets.back();
+
+		restored_.assign(segment.keyframe.begin(), segment.keyframe.end());
+		ApplyDelta(segment.deltas.data() + offset, segment.deltas.size() - offset, restored_);
+
+		segment.deltas.resize(offset);
+		segment.deltaOffsets.pop_back();
+
+		// 取り除いた差分の領域が使用中のサイズを超えたら解放する（毎回は再確保しない）
+		if (segment.deltas.capacity() > segment.deltas.size() * 2)
+		{
+			segment.shrink();
+		}
+
+		usedBytes_ -= prevBytes - segment.bytes();
+
+		StateReader reader{ restored_.data(), restored_.size() };
+		return core.loadState(reader);
+	}
+
+	void RewindBuffer::clear()
+	{
+		segments_.clear();
+		usedBytes_ = 0;
+	}
+
+	bool RewindBuffer::empty() const
+	{
+		return segments_.empty();
+	}
+
+	int RewindBuffer::frameCount() const
+	{
+		int count = 0;
+
+		for (const auto& segment : segments_)
+		{
+			count += 1 + static_cast<int>(segment.deltaOffsets.size());
+		}
+
+		return count;
+	}
+
+	size_t RewindBuffer::usedBytes() const
+	{
+		return usedBytes_;
+	}
+
+	void RewindBuffer::evict_()
+	{
+		// 最新のキーフレームは残す
+		while (usedBytes_ > capacityBytes_ && segments_.size() > 1)
+		{
+			usedBytes_ -= segments_.front().bytes();
+			segments_.erase(segments_.begin());
+		}
+	}
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "SaveState.h"
+
+namespace dmge
+{
+	class Core;
+
+	// 巻き戻し用に、直近のフレームの状態をメモリ上に記録する
+	// - KeyframeInterval フレームごとにセーブステート全体（キーフレーム）を記録し、
+	//   それ以外のフレームはキーフレームとの XOR をランレングス圧縮した差分として記録する
+	// - 記録したデータの合計が上限を超えた場合は、最も古いキーフレームをその差分とまとめて破棄する
+	class RewindBuffer
+	{
+	public:
+		// capacityBytes: 記録に使うメモリの上限（0 の場合は記録しない）
+		explicit RewindBuffer(size_t capacityBytes);
+
+		void setCapacity(size_t capacityBytes);
+
+		// 現在の状態を記録する
+		// 1フレームに1回呼ぶ
+		void push(const Core& core);
+
+		// 最後に記録した状態に戻し、記録から取り除く
+		// 記録がない場合は false
+		bool pop(Core& core);
+
+		void clear();
+
+		bool empty() const;
+
+		// 記録しているフレーム数
+		int frameCount() const;
+
+		// 記録に使っているメモリ（確保している領域のサイズ）
+		size_t usedBytes() const;
+
+	private:
+		// キーフレームと、それに続くフレームの差分
+		struct Segment
+		{
+			Array<uint8> keyframe;
+
+			// 差分を連結したもの
+			Array<uint8> deltas;
+
+			// deltas 内の各差分の開始位置
+			Array<size_t> deltaOffsets;
+
+			// 確保している領域のサイズ
+			size_t bytes() const;
+
+			// 差分の余分な領域を解放する
+			void shrink();
+		};
+
+		// キーフレームを記録する間隔（フレーム数）
+		static constexpr int KeyframeInterval = 60;
+
+		size_t capacityBytes_;
+
+		Array<Segment> segments_;
+
+		size_t usedBytes_ = 0;
+
+		// セーブステートの書き込み用（バッファを使い回す）
+		StateWriter writer_;
+
+		// 差分から復元したセーブステート
+		Array<uint8> restored_;
+
+		// 上限を超えている間、古い記録を破棄する
+		void evict_();
+	};
+}
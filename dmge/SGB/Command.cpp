@@ -5,6 +5,7 @@
 #include "../LCD.h"
 #include "../PPU.h"
 #include "../DebugPrint.h"
+#include "../SaveState.h"
 #include <magic_enum/magic_enum.hpp>
 
 namespace dmge
@@ -489,5 +490,27 @@ namespace dmge
 
 			}
 		}
+
+		void Command::saveState(StateWriter& writer) const
+		{
+			writer.write(prevBits_);
+			writer.write(received_);
+			writer.write(receivedSizePartial_);
+			writer.write(currentByte_);
+			writer.write(currentByteReceivedBits_);
+			writer.write(packetLength_);
+			writer.write(state_);
+		}
+
+		void Command::loadState(StateReader& reader)
+		{
+			reader.read(prevBits_);
+			reader.read(received_);
+			reader.read(receivedSizePartial_);
+			reader.read(currentByte_);
+			reader.read(currentByteReceivedBits_);
+			reader.read(packetLength_);
+			reader.read(state_);
+		}
 	}
 }
@@ -7,6 +7,8 @@ namespace dmge
 	class Joypad;
 	class LCD;
 	class PPU;
+	class StateWriter;
+	class StateReader;
 
 	namespace SGB
 	{
@@ -32,6 +34,11 @@ namespace dmge
 			// [DEBUG]
 			void dump() const;
 
+			// セーブステート
+			void saveState(StateWriter& writer) const;
+
+			void loadState(StateReader& reader);
+
 		private:
 			Joypad& joypad_;
 			LCD& lcd_;
@@ -0,0 +1,53 @@
+﻿#include "stdafx.h"
+#include "SaveState.h"
+
+namespace dmge
+{
+	void StateWriter::writeBytes(const void* data, size_t size)
+	{
+		const uint8* bytes = static_cast<const uint8*>(data);
+		data_.insert(data_.end(), bytes, bytes + size);
+	}
+
+	void StateWriter::clear()
+	{
+		data_.clear();
+	}
+
+	const Array<uint8>& StateWriter::data() const
+	{
+		return data_;
+	}
+
+	StateReader::StateReader(const uint8* data, size_t size)
+		: data_{ data }, size_{ size }
+	{
+	}
+
+	void StateReader::readBytes(void* data, size_t size)
+	{
+		if (failed_ || size > size_ - pos_)
+		{
+			failed_ = true;
+			return;
+		}
+
+		std::memcpy(data, data_ + pos_, size);
+		pos_ += size;
+	}
+
+	void StateReader::fail()
+	{
+		failed_ = true;
+	}
+
+	bool StateReader::failed() const
+	{
+		return failed_;
+	}
+
+	bool StateReader::finished() const
+	{
+		return not failed_ && pos_ == size_;
+	}
+}
@@ -0,0 +1,108 @@
+﻿#pragma once
+
+namespace dmge
+{
+	// セーブステートのバイナリ形式
+	// - 先頭にヘッダ（マジック、バージョン、カートリッジの識別情報）を置き、続けて各ユニットの状態を決まった順に並べる
+	// - 値はメモリ上の表現をそのままコピーする（文字列への変換はしない）
+	// - ユニットの状態の構成を変えた場合は SaveStateVersion を上げる
+	inline constexpr uint32 SaveStateMagic = 0x53474d44;  // "DMGS"
+	inline constexpr uint32 SaveStateVersion = 5;
+
+	// セーブステートを書き込む
+	class StateWriter
+	{
+	public:
+		template <class T>
+		void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			writeBytes(&value, sizeof(T));
+		}
+
+		template <class T>
+		void write(const Array<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			write(static_cast<uint32>(values.size()));
+			writeBytes(values.data(), values.size() * sizeof(T));
+		}
+
+		template <class T>
+		void write(const Optional<T>& value)
+		{
+			write(value.has_value());
+			write(value.value_or(T{}));
+		}
+
+		void writeBytes(const void* data, size_t size);
+
+		// 書き込んだデータを破棄する（確保したメモリは再利用する）
+		void clear();
+
+		const Array<uint8>& data() const;
+
+	private:
+		Array<uint8> data_;
+	};
+
+	// セーブステートを読み込む
+	// データが足りない場合は failed() が true になり、以降は何も読み込まない
+	class StateReader
+	{
+	public:
+		StateReader(const uint8* data, size_t size);
+
+		template <class T>
+		void read(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			readBytes(&value, sizeof(T));
+		}
+
+		template <class T>
+		void read(Array<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			uint32 size = 0;
+			read(size);
+
+			if (failed_ || size * sizeof(T) > size_ - pos_)
+			{
+				failed_ = true;
+				return;
+			}
+
+			values.resize(size);
+			readBytes(values.data(), size * sizeof(T));
+		}
+
+		template <class T>
+		void read(Optional<T>& value)
+		{
+			bool hasValue = false;
+			T v{};
+			read(hasValue);
+			read(v);
+
+			value = hasValue ? Optional<T>{ v } : none;
+		}
+
+		void readBytes(void* data, size_t size);
+
+		// 読み込んだ値が不正で修復できない場合に呼ぶ（以降は何も読み込まない）
+		void fail();
+
+		bool failed() const;
+
+		// 最後まで読み込んだ
+		bool finished() const;
+
+	private:
+		const uint8* data_;
+		size_t size_;
+		size_t pos_ = 0;
+		bool failed_ = false;
+	};
+}
@@ -0,0 +1,78 @@
+﻿#include "stdafx.h"
+#include "Scheduler.h"
+#include "SaveState.h"
+
+namespace dmge
+{
+	Scheduler::Scheduler()
+	{
+		timestamps_.fill(Never);
+	}
+
+	uint64 Scheduler::now() const
+	{
+		return now_;
+	}
+
+	void Scheduler::advance(int cycles)
+	{
+		now_ += cycles;
+	}
+
+	void Scheduler::schedule(SchedulerEvent event, uint64 timestamp)
+	{
+		timestamps_[FromEnum(event)] = timestamp;
+
+		updateNextTimestamp_();
+	}
+
+	void Scheduler::cancel(SchedulerEvent event)
+	{
+		schedule(event, Never);
+	}
+
+	uint64 Scheduler::nextEventTimestamp() const
+	{
+		return nextTimestamp_;
+	}
+
+	Optional<SchedulerEvent> Scheduler::popDueEvent()
+	{
+		if (nextTimestamp_ > now_)
+		{
+			return none;
+		}
+
+		// イベントの数は少ないので線形探索でよい
+		for (int i : step(SchedulerEventCount))
+		{
+			if (timestamps_[i] <= now_)
+			{
+				timestamps_[i] = Never;
+				updateNextTimestamp_();
+				return ToEnum<SchedulerEvent>(static_cast<uint8>(i));
+			}
+		}
+
+		return none;
+	}
+
+	void Scheduler::updateNextTimestamp_()
+	{
+		nextTimestamp_ = *std::min_element(timestamps_.begin(), timestamps_.end());
+	}
+
+	void Scheduler::saveState(StateWriter& writer) const
+	{
+		writer.write(now_);
+		writer.write(timestamps_);
+		writer.write(nextTimestamp_);
+	}
+
+	void Scheduler::loadState(StateReader& reader)
+	{
+		reader.read(now_);
+		reader.read(timestamps_);
+		reader.read(nextTimestamp_);
+	}
+}
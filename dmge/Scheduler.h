@@ -0,0 +1,65 @@
+﻿#pragma once
+
+namespace dmge
+{
+	class StateWriter;
+	class StateReader;
+
+	// スケジューラに登録するイベント（ユニット）の種類
+	enum class SchedulerEvent : uint8
+	{
+		Timer,
+		Serial,
+		PPU,
+		APU,
+	};
+
+	inline constexpr int SchedulerEventCount = 4;
+
+	// 各ユニットが「次に状態を確定させる必要があるサイクル」を管理する
+	// - 時刻は CPU の T-cycles 単位（倍速モードでも CPU のクロックを基準とする）
+	// - 各ユニットは期限が来たとき、またはレジスタへのアクセス時にだけ現在時刻まで進められる
+	class Scheduler
+	{
+	public:
+		// イベントが登録されていないことを表す時刻
+		inline static constexpr uint64 Never = std::numeric_limits<uint64>::max();
+
+		Scheduler();
+
+		// 現在時刻
+		uint64 now() const;
+
+		// 現在時刻を進める
+		void advance(int cycles);
+
+		// イベントを登録する
+		// 同じ種類のイベントが登録済みの場合は時刻を置き換える
+		void schedule(SchedulerEvent event, uint64 timestamp);
+
+		// イベントを取り消す
+		void cancel(SchedulerEvent event);
+
+		// 登録されているイベントのうち、最も早い時刻
+		uint64 nextEventTimestamp() const;
+
+		// 現在時刻までに期限が来たイベントを1つ取り出す
+		// 取り出したイベントは登録解除される
+		Optional<SchedulerEvent> popDueEvent();
+
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
+	private:
+		uint64 now_ = 0;
+
+		std::array<uint64, SchedulerEventCount> timestamps_;
+
+		// timestamps_ の最小値
+		uint64 nextTimestamp_ = Never;
+
+		void updateNextTimestamp_();
+	};
+}
@@ -2,7 +2,9 @@
 #include "Serial.h"
 #include "Address.h"
 #include "Interrupt.h"
+#include "Scheduler.h"
 #include "BitMask/InterruptFlag.h"
+#include "SaveState.h"
 
 namespace dmge
 {
@@ -14,8 +16,8 @@ namespace dmge
 		}
 	}
 
-	Serial::Serial(Interrupt& interrupt)
-		: interrupt_{ interrupt }
+	Serial::Serial(Interrupt& interrupt, Scheduler& scheduler)
+		: interrupt_{ interrupt }, scheduler_{ scheduler }
 	{
 	}
 
@@ -44,6 +46,8 @@ namespace dmge
 			break;
 		}
 		}
+
+		scheduleNextEvent_();
 	}
 
 	uint8 Serial::readRegister(uint16 addr) const
@@ -65,28 +69,70 @@ namespace dmge
 		return remainBits_.has_value();
 	}
 
-	void Serial::update()
+	void Serial::sync()
 	{
-		if (not transfering()) return;
+		const uint64 now = scheduler_.now();
+		uint64 elapsed = now - lastSync_;
+		lastSync_ = now;
 
-		if (clock_ > 0)
+		// 経過サイクル内に完了するビットをまとめてシフトする
+		while (transfering() && clock_ > 0 && elapsed >= clock_)
 		{
-			if (--clock_ == 0)
+			elapsed -= clock_;
+
+			transferData_ = (transferData_ << 1) | 1;
+			*remainBits_ -= 1;
+
+			if (*remainBits_ == 0)
 			{
-				transferData_ = (transferData_ << 1) | 1;
-				*remainBits_ -= 1;
-
-				if (*remainBits_ == 0)
-				{
-					// 転送が終わった
-					remainBits_.reset();
-					interrupt_.request(BitMask::InterruptFlagBit::Serial);
-				}
-				else
-				{
-					clock_ = SerialClockCycles(clockSpeed_);
-				}
+				// 転送が終わった
+				remainBits_.reset();
+				interrupt_.request(BitMask::InterruptFlagBit::Serial);
+			}
+			else
+			{
+				clock_ = SerialClockCycles(clockSpeed_);
 			}
 		}
+
+		if (transfering() && clock_ > 0)
+		{
+			clock_ -= static_cast<uint8>(elapsed);
+		}
+
+		scheduleNextEvent_();
+	}
+
+	void Serial::scheduleNextEvent_()
+	{
+		if (not transfering() || clock_ == 0)
+		{
+			scheduler_.cancel(SchedulerEvent::Serial);
+			return;
+		}
+
+		// 転送完了（割り込み要求）の時刻
+		const uint8 bitCycles = static_cast<uint8>(SerialClockCycles(clockSpeed_));
+		scheduler_.schedule(SchedulerEvent::Serial, lastSync_ + clock_ + static_cast<uint64>(*remainBits_ - 1) * bitCycles);
+	}
+
+	void Serial::saveState(StateWriter& writer) const
+	{
+		writer.write(lastSync_);
+		writer.write(transferData_);
+		writer.write(remainBits_);
+		writer.write(clockSpeed_);
+		writer.write(clockSource_);
+		writer.write(clock_);
+	}
+
+	void Serial::loadState(StateReader& reader)
+	{
+		reader.read(lastSync_);
+		reader.read(transferData_);
+		reader.read(remainBits_);
+		reader.read(clockSpeed_);
+		reader.read(clockSource_);
+		reader.read(clock_);
 	}
 }
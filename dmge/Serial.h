@@ -2,6 +2,9 @@
 
 namespace dmge
 {
+	class StateWriter;
+	class StateReader;
+
 	enum class SerialClockSource : uint8
 	{
 		External = 0,
@@ -15,11 +18,12 @@ namespace dmge
 	};
 
 	class Interrupt;
+	class Scheduler;
 
 	class Serial
 	{
 	public:
-		Serial(Interrupt& interrupt);
+		Serial(Interrupt& interrupt, Scheduler& scheduler);
 
 		void writeRegister(uint16 addr, uint8 value);
 
@@ -27,11 +31,22 @@ namespace dmge
 
 		bool transfering() const;
 
-		void update();
+		// 前回の同期時刻から現在時刻まで進め、転送完了時刻をスケジューラに登録する
+		void sync();
+
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
 
 	private:
 		Interrupt& interrupt_;
 
+		Scheduler& scheduler_;
+
+		// 前回 sync() した時刻
+		uint64 lastSync_ = 0;
+
 		// SB (0xFF01)
 		uint8 transferData_ = 0;
 
@@ -42,5 +57,7 @@ namespace dmge
 		SerialClockSource clockSource_{};
 		
 		uint8 clock_ = 0;
+
+		void scheduleNextEvent_();
 	};
 }
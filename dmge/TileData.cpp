@@ -22,6 +22,40 @@ namespace dmge
 		}
 	}
 
+	void TileCache::update(const std::array<uint8, 0x2000>& vram, int bank, uint16 addr)
+	{
+		const int offset = (addr - Address::TileData0) & ~1;
+
+		if (offset < 0 || offset >= RowsPerBank * 2) return;
+
+		const int index = bank * RowsPerBank + offset / 2;
+		const uint16 tileData = vram[offset] | (vram[offset + 1] << 8);
+
+		for (int dotNth = 0; dotNth < 8; ++dotNth)
+		{
+			const uint8 color = TileData::GetColor(tileData, dotNth);
+			rows_[index][dotNth] = color;
+			flippedRows_[index][7 - dotNth] = color;
+		}
+	}
+
+	void TileCache::rebuild(const std::array<std::array<uint8, 0x2000>, 2>& vram)
+	{
+		for (int bank = 0; bank < 2; ++bank)
+		{
+			for (uint16 addr = Address::TileData0; addr < Address::TileData2_End; addr += 2)
+			{
+				update(vram[bank], bank, addr);
+			}
+		}
+	}
+
+	const TileCache::Row& TileCache::row(uint16 tileDataAddr, int bank, bool xFlip) const
+	{
+		const int index = bank * RowsPerBank + (tileDataAddr - Address::TileData0) / 2;
+		return xFlip ? flippedRows_[index] : rows_[index];
+	}
+
 	constexpr Size TileImageSize{ 8 * 16, 8 * 24 };
 
 	TileDataTexture::TileDataTexture(Memory& mem, int vramBank)
@@ -33,7 +67,7 @@ namespace dmge
 	{
 	}
 
-	void TileDataTexture::update()
+	void TileDataTexture::updateImage()
 	{
 		for (uint16 addr = Address::TileData0; addr < Address::TileData2_End; addr += 0x10)
 		{
@@ -44,17 +78,24 @@ namespace dmge
 
 			for (int y = 0; y < 8; ++y)
 			{
-				const uint16 tileData = mem_.read16VRAMBank(addr + y * 2, vramBank_);
+				const auto& row = mem_.tileCache().row(addr + y * 2, vramBank_);
 
-				for (int x = 0, bit = 7; x < 8; ++x, --bit)
+				for (int x = 0; x < 8; ++x)
 				{
-					const uint8 colorID = (((tileData & 0xff) >> bit) & 1) | (((((tileData >> 8) & 0xff) >> bit) & 1) << 1);
-					tileImage_[tileTopLeftPos.y + y][tileTopLeftPos.x + x] = Color(colorID * (255u / 3), 255u);
+					tileImage_[tileTopLeftPos.y + y][tileTopLeftPos.x + x] = Color(row[x] * (255u / 3), 255u);
 				}
 			}
 		}
 
+		imageUpdated_ = true;
+	}
+
+	void TileDataTexture::uploadTexture()
+	{
+		if (not imageUpdated_) return;
+
 		texture_.fill(tileImage_);
+		imageUpdated_ = false;
 	}
 
 	RectF TileDataTexture::draw(const Vec2& pos) const
@@ -12,6 +12,36 @@ namespace dmge
 	}
 
 
+	// VRAM のタイルデータ（2バンク × 384タイル × 8行）を、ドットごとの色番号にデコードして保持する
+	// 左右反転した行もあわせて保持する（上下反転は参照する行を変えればよい）
+	// VRAM への書き込み時に、書き込まれた行だけをデコードし直す
+	class TileCache
+	{
+	public:
+		// 1行分（8ドット）の色番号
+		using Row = std::array<uint8, 8>;
+
+		// VRAM のタイルデータ領域の1行をデコードし直す
+		// addr は VRAM のアドレス。タイルデータ領域外の場合は何もしない
+		void update(const std::array<uint8, 0x2000>& vram, int bank, uint16 addr);
+
+		// すべての行をデコードし直す
+		void rebuild(const std::array<std::array<uint8, 0x2000>, 2>& vram);
+
+		// タイルデータの1行
+		// tileDataAddr は TileData::GetAddress() で得たアドレス
+		const Row& row(uint16 tileDataAddr, int bank, bool xFlip = false) const;
+
+	private:
+		// 1バンクあたりの行数 (0x8000-0x97ff)
+		static constexpr int RowsPerBank = 384 * 8;
+
+		std::array<Row, RowsPerBank * 2> rows_{};
+
+		std::array<Row, RowsPerBank * 2> flippedRows_{};
+	};
+
+
 	class Memory;
 
 	class TileDataTexture
@@ -19,7 +49,12 @@ namespace dmge
 	public:
 		TileDataTexture(Memory& mem, int vramBank = 0);
 
-		void update();
+		// VRAM のタイルデータを画像に書き込む（テクスチャは更新しない）
+		// コアのスレッドから呼ぶ場合は、uploadTexture() と同時に呼ばないこと
+		void updateImage();
+
+		// updateImage() で更新した画像をテクスチャに転送する
+		void uploadTexture();
 
 		RectF draw(const Vec2& pos) const;
 
@@ -31,5 +66,8 @@ namespace dmge
 
 		Image tileImage_;
 		DynamicTexture texture_;
+
+		// テクスチャに転送していない画像の更新がある
+		bool imageUpdated_ = false;
 	};
 }
@@ -2,14 +2,32 @@
 #include "Timer.h"
 #include "Memory.h"
 #include "Interrupt.h"
+#include "Scheduler.h"
 #include "Address.h"
 #include "BitMask/TAC.h"
 #include "BitMask/InterruptFlag.h"
+#include "SaveState.h"
 
 namespace dmge
 {
-	Timer::Timer(Memory* mem, Interrupt* interrupt)
-		: mem_{ mem }, interrupt_{ interrupt }
+	namespace
+	{
+		// TAC のクロック選択に対応する、内部カウンタのビット
+		constexpr int TimerClockBit(uint8 tac)
+		{
+			constexpr std::array<int, 4> Bits = { 9, 3, 5, 7 };
+			return Bits[tac & BitMask::TAC::Clock];
+		}
+
+		// TIMA がインクリメントされる周期 [T-cycles]
+		constexpr int TimerClockPeriod(uint8 tac)
+		{
+			return 2 << TimerClockBit(tac);
+		}
+	}
+
+	Timer::Timer(Memory* mem, Interrupt* interrupt, Scheduler* scheduler)
+		: mem_{ mem }, interrupt_{ interrupt }, scheduler_{ scheduler }
 	{
 	}
 
@@ -34,6 +52,8 @@ namespace dmge
 		{
 			tac_ = value & 0b111;
 		}
+
+		scheduleNextEvent_();
 	}
 
 	uint8 Timer::readRegister(uint16 addr) const
@@ -58,26 +78,72 @@ namespace dmge
 		return 0;
 	}
 
-	void Timer::update()
+	void Timer::sync()
 	{
-		// DIV
-
-		divInternal_ += 1;
+		const uint64 now = scheduler_->now();
 
-		// TAC
+		advance_(now - lastSync_);
+		lastSync_ = now;
 
-		uint8 timerEnable = (tac_ & BitMask::TAC::TimerEnable) ? 1 : 0;
-		uint8 divBit = 0;
+		scheduleNextEvent_();
+	}
 
-		switch (tac_ & BitMask::TAC::Clock)
+	void Timer::advance_(uint64 cycles)
+	{
+		while (cycles > 0)
 		{
-		case 0: divBit = (divInternal_ >> 9) & 1; break;
-		case 1: divBit = (divInternal_ >> 3) & 1; break;
-		case 2: divBit = (divInternal_ >> 5) & 1; break;
-		case 3: divBit = (divInternal_ >> 7) & 1; break;
+			// 以下の場合は update_() で 1 T-cycle ずつ進める
+			// - オーバーフローから TMA のリロードまでの間 (tmaCount_, reloadingCount_)
+			// - TAC・DIV への書き込みにより、前回のビットと現在のビットが一致していない（立下りが発生しうる）
+			if (tmaCount_ > 0 || reloadingCount_ > 0 || divBitPrev_ != selectedDivBit_(divInternal_))
+			{
+				update_();
+				--cycles;
+				continue;
+			}
+
+			// タイマー停止中は DIV が進むだけ
+			if ((tac_ & BitMask::TAC::TimerEnable) == 0)
+			{
+				divInternal_ = static_cast<uint16>(divInternal_ + cycles);
+				return;
+			}
+
+			// 選択されたビットの立下りは、内部カウンタが周期の倍数になったときに発生する
+			// → 経過サイクル内の立下りの回数だけ TIMA をインクリメントする
+			const uint64 period = TimerClockPeriod(tac_);
+			const uint64 phase = divInternal_ % period;
+			const uint64 cyclesToOverflow = (period - phase) + (0xffull - tima_) * period;
+
+			if (cycles < cyclesToOverflow)
+			{
+				tima_ = static_cast<uint8>(tima_ + (phase + cycles) / period);
+				divInternal_ = static_cast<uint16>(divInternal_ + cycles);
+				divBitPrev_ = selectedDivBit_(divInternal_);
+				return;
+			}
+
+			// オーバーフローする立下りの直前まで進め、オーバーフロー以降は update_() で処理する
+			const uint64 skip = cyclesToOverflow - 1;
+			tima_ = 0xff;
+			divInternal_ = static_cast<uint16>(divInternal_ + skip);
+			divBitPrev_ = selectedDivBit_(divInternal_);
+			cycles -= skip;
+
+			update_();
+			--cycles;
 		}
+	}
+
+	void Timer::update_()
+	{
+		// DIV
+
+		divInternal_ += 1;
+
+		// TAC
 
-		divBit = timerEnable & divBit;
+		const uint8 divBit = selectedDivBit_(divInternal_);
 
 
 		// DIV の選択された bit の立下り時に TIMA をインクリメントする
@@ -145,6 +211,8 @@ namespace dmge
 	{
 		divInternal_ = 0;
 		divBitPrev_ = 0;
+
+		scheduleNextEvent_();
 	}
 
 	uint8 Timer::div() const
@@ -152,6 +220,47 @@ namespace dmge
 		return divInternal_ >> 8;
 	}
 
+	uint16 Timer::divCounterAt(uint64 timestamp) const
+	{
+		return static_cast<uint16>(divInternal_ + (timestamp - lastSync_));
+	}
+
+	void Timer::scheduleNextEvent_()
+	{
+		// オーバーフロー済みで、割り込み要求を待っている
+		if (tmaCount_ > 0)
+		{
+			scheduler_->schedule(SchedulerEvent::Timer, lastSync_ + tmaCount_);
+			return;
+		}
+
+		// TAC の変更などにより、次の T-cycle で立下りが発生しうる
+		if (divBitPrev_ != selectedDivBit_(divInternal_))
+		{
+			scheduler_->schedule(SchedulerEvent::Timer, lastSync_ + 1);
+			return;
+		}
+
+		if ((tac_ & BitMask::TAC::TimerEnable) == 0)
+		{
+			scheduler_->cancel(SchedulerEvent::Timer);
+			return;
+		}
+
+		// TIMA がオーバーフローする立下りの時刻を求め、その 4 T-cycles 後（割り込み要求時）をイベントとする
+		const uint64 period = TimerClockPeriod(tac_);
+		const uint64 cyclesToOverflow = (period - (divInternal_ % period)) + (0xffull - tima_) * period;
+
+		scheduler_->schedule(SchedulerEvent::Timer, lastSync_ + cyclesToOverflow + 4);
+	}
+
+	uint8 Timer::selectedDivBit_(uint16 divCounter) const
+	{
+		const uint8 timerEnable = (tac_ & BitMask::TAC::TimerEnable) ? 1 : 0;
+
+		return timerEnable & ((divCounter >> TimerClockBit(tac_)) & 1);
+	}
+
 	void Timer::abortInterrupt_()
 	{
 		tmaCount_ = 0;
@@ -161,4 +270,28 @@ namespace dmge
 	{
 		return reloadingCount_ > 0;
 	}
+
+	void Timer::saveState(StateWriter& writer) const
+	{
+		writer.write(lastSync_);
+		writer.write(tima_);
+		writer.write(tma_);
+		writer.write(tac_);
+		writer.write(divInternal_);
+		writer.write(divBitPrev_);
+		writer.write(tmaCount_);
+		writer.write(reloadingCount_);
+	}
+
+	void Timer::loadState(StateReader& reader)
+	{
+		reader.read(lastSync_);
+		reader.read(tima_);
+		reader.read(tma_);
+		reader.read(tac_);
+		reader.read(divInternal_);
+		reader.read(divBitPrev_);
+		reader.read(tmaCount_);
+		reader.read(reloadingCount_);
+	}
 }
@@ -4,11 +4,14 @@ namespace dmge
 {
 	class Memory;
 	class Interrupt;
+	class Scheduler;
+	class StateWriter;
+	class StateReader;
 
 	class Timer
 	{
 	public:
-		Timer(Memory* mem, Interrupt* interrupt);
+		Timer(Memory* mem, Interrupt* interrupt, Scheduler* scheduler);
 
 		// IOレジスタへの書き込み
 		void writeRegister(uint16 addr, uint8 value);
@@ -16,15 +19,29 @@ namespace dmge
 		// IOレジスタからの読み込み
 		uint8 readRegister(uint16 addr) const;
 
-		void update();
+		// 前回の同期時刻から現在時刻まで進め、次のイベント（割り込み要求）をスケジューラに登録する
+		void sync();
 
 		void resetDIV();
 
 		uint8 div() const;
 
+		// 指定した時刻における内部カウンタ (DIV は上位 8bit)
+		// 前回の同期時刻からの差分で求めるため、その間に DIV がリセットされていないこと
+		uint16 divCounterAt(uint64 timestamp) const;
+
+		// セーブステート
+		void saveState(StateWriter& writer) const;
+
+		void loadState(StateReader& reader);
+
 	private:
 		Memory* mem_;
 		Interrupt* interrupt_;
+		Scheduler* scheduler_;
+
+		// 前回 sync() した時刻
+		uint64 lastSync_ = 0;
 
 		uint8 tima_ = 0;
 		uint8 tma_ = 0;
@@ -35,6 +52,14 @@ namespace dmge
 		int tmaCount_ = 0;
 		int reloadingCount_ = 0;
 
+		// cycles T-cycles 分進める
+		// 立下りとオーバーフローの発生を計算で求め、リロード中などを除いて update_() を呼ばずに済ませる
+		void advance_(uint64 cycles);
+
+		// 1 T-cycle 進める
+		void update_();
+		void scheduleNextEvent_();
+		uint8 selectedDivBit_(uint16 divCounter) const;
 		void abortInterrupt_();
 		bool isReloading_() const;
 	};